@@ -0,0 +1,511 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * Lookup engine micro benchmarks.
+ *
+ * usage: qassert-meta-bench-<variant> [--quick] [--output <file.json>]
+ *                                     [--compare <baseline.json>] [--threshold <percent>]
+ *
+ * Results are written as JSON, one result object per line. With --compare,
+ * results whose median ns/op exceed the baseline's by more than the threshold
+ * (default 15 percent) are reported and the exit code is 1. Independent of
+ * the baseline, --compare also fails if random hits on the largest synthetic
+ * table cost more than 4 times those on the 1000 entry table, as a linear
+ * scan would cost 100 times more. Where the startup probes are built (the
+ * qpc variant), it also fails if a process registering a large indexed
+ * table starts more than 1.5 times (plus 2 ms) slower than without the
+ * library, no assert firing.
+ *
+ * "warm" cases repeat the same lookup in timed batches, the median and
+ * minimum batch ns/op are reported. "cold" cases evict the CPU caches
+ * before each individually timed lookup.
+ *
+ * Synthetic tables are registered indexed, "scan" cases register the
+ * same table without an index. "random_hit" cycles through 1024 randomly
+ * chosen entries of the table. "enumerate_module" walks the entries of a
+ * module within a range of 100 ids. "startup" cases time a run of
+ * tests/qassert-meta-startup-probe.c, with and without the library.
+ */
+
+#include "qassert-meta.h"
+#include "qassert-meta-search.h"
+#include "qassert-meta-fuzzy.h"
+#include "qassert-meta-stats.h"
+#include "qassert-meta-latency.h"
+#include "qassert-meta-enumerate.h"
+#include "qassert-meta-synthetic.h"
+extern "C" {
+#include "qassert-meta-private.h"
+}
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    const char * output = nullptr;
+    const char * compare = nullptr;
+    double threshold = 15.0;
+    bool quick = false;
+};
+
+struct Result {
+    std::string name;
+    size_t tableSize;
+    uint64_t iterations;
+    double nsPerOp;
+    double minNsPerOp;
+};
+
+volatile uintptr_t g_sink;
+
+//random hits on the largest synthetic table versus the 1000 entry table
+constexpr double MAX_LOOKUP_COST_GROWTH = 4.0;
+const char * const SCALING_SMALL = "synthetic_1000.random_hit.warm";
+const char * const SCALING_LARGE = "synthetic_100000.random_hit.warm";
+
+//startup of the probe versus its baseline build without the library
+constexpr double MAX_STARTUP_RATIO = 1.5;
+constexpr double STARTUP_SLACK_NS = 2e6;
+constexpr size_t STARTUP_PROBE_ITEMS = 32768; //PROBE_ITEMS of the probe
+const char * const STARTUP_BASELINE = "startup.baseline";
+const char * const STARTUP_LIBRARY = "startup.library";
+
+//larger than the last level cache of typical hosts
+constexpr size_t EVICTION_BUFFER_SIZE = 64u * 1024u * 1024u;
+std::vector<uint8_t> g_evictionBuffer;
+
+void EvictCaches()
+{
+    if (g_evictionBuffer.empty())
+    {
+        g_evictionBuffer.resize(EVICTION_BUFFER_SIZE);
+    }
+    for (size_t i = 0; i < g_evictionBuffer.size(); i += 64)
+    {
+        g_evictionBuffer[i]++;
+    }
+}
+
+double Median(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+Result MeasureWarm(const Options & options, const std::string & name, size_t tableSize,
+                   const std::function<uintptr_t()> & operation)
+{
+    const auto batchTarget = std::chrono::microseconds(options.quick ? 2000 : 10000);
+    const int batches = options.quick ? 5 : 15;
+
+    //calibrate the batch size
+    uint64_t batchSize = 1;
+    for (;;)
+    {
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < batchSize; ++i)
+        {
+            g_sink = g_sink + operation();
+        }
+        if (((Clock::now() - start) >= batchTarget) || (batchSize >= (1ull << 32)))
+        {
+            break;
+        }
+        batchSize *= 2;
+    }
+
+    std::vector<double> nsPerOp;
+    for (int b = 0; b < batches; ++b)
+    {
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < batchSize; ++i)
+        {
+            g_sink = g_sink + operation();
+        }
+        std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        nsPerOp.push_back(elapsed.count() / static_cast<double>(batchSize));
+    }
+
+    return {name + ".warm", tableSize, batchSize * static_cast<uint64_t>(batches),
+            Median(nsPerOp), *std::min_element(nsPerOp.begin(), nsPerOp.end())};
+}
+
+Result MeasureCold(const Options & options, const std::string & name, size_t tableSize,
+                   const std::function<uintptr_t()> & operation)
+{
+    const int samples = options.quick ? 10 : 50;
+    std::vector<double> nsPerOp;
+    for (int s = 0; s < samples; ++s)
+    {
+        EvictCaches();
+        auto start = Clock::now();
+        g_sink = g_sink + operation();
+        std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        nsPerOp.push_back(elapsed.count());
+    }
+
+    return {name + ".cold", tableSize, static_cast<uint64_t>(samples),
+            Median(nsPerOp), *std::min_element(nsPerOp.begin(), nsPerOp.end())};
+}
+
+#if defined(QASSERT_META_STARTUP_PROBE)
+/**
+ * Times whole runs of a startup probe, which prints its memory use.
+ * @return: false if the probe could not be run.
+ */
+bool MeasureStartup(const Options & options, const std::string & name, const char * path, Result & result)
+{
+    const int runs = options.quick ? 5 : 15;
+    std::vector<double> nsPerRun;
+    for (int run = 0; run < runs; ++run)
+    {
+        auto start = Clock::now();
+        FILE * probe = popen(path, "r");
+        if (nullptr == probe)
+        {
+            return false;
+        }
+        long rssKb = -1;
+        bool printed = (1 == fscanf(probe, "%ld", &rssKb));
+        if ((0 != pclose(probe)) || !printed)
+        {
+            return false;
+        }
+        std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        nsPerRun.push_back(elapsed.count());
+    }
+
+    result = {name, STARTUP_PROBE_ITEMS, static_cast<uint64_t>(runs),
+              Median(nsPerRun), *std::min_element(nsPerRun.begin(), nsPerRun.end())};
+    return true;
+}
+#endif
+
+uintptr_t Lookup(const char * module, int id)
+{
+    QAssertMetaDescription description = {nullptr, nullptr, nullptr};
+    bool found = QAssertMetaGetDescription(module, id, &description);
+    return reinterpret_cast<uintptr_t>(description.brief) + (found ? 1u : 0u);
+}
+
+bool MissCallback(const char * module, int id, QAssertMetaDescription * output)
+{
+    (void)module;
+    (void)id;
+    (void)output;
+    return false;
+}
+
+size_t BuiltinCount()
+{
+    size_t count = 0;
+    while (m_qassert_meta_items[count].module != nullptr)
+    {
+        ++count;
+    }
+    return count;
+}
+
+std::vector<Result> RunAll(const Options & options)
+{
+    std::vector<Result> results;
+    const size_t builtinCount = BuiltinCount();
+    const QAssertMetaItem & first = m_qassert_meta_items[0];
+    const QAssertMetaItem & last = m_qassert_meta_items[builtinCount - 1];
+
+    QAssertMetaInit();
+    auto firstHit = [&first]() { return Lookup(first.module, first.id); };
+    auto lastHit = [&last]() { return Lookup(last.module, last.id); };
+    auto miss = []() { return Lookup("gobble", 123456); };
+    results.push_back(MeasureWarm(options, "builtin.first_hit", builtinCount, firstHit));
+    results.push_back(MeasureCold(options, "builtin.first_hit", builtinCount, firstHit));
+    results.push_back(MeasureWarm(options, "builtin.last_hit", builtinCount, lastHit));
+    results.push_back(MeasureCold(options, "builtin.last_hit", builtinCount, lastHit));
+    results.push_back(MeasureWarm(options, "builtin.miss_no_callback", builtinCount, miss));
+    results.push_back(MeasureCold(options, "builtin.miss_no_callback", builtinCount, miss));
+
+    //the module as found in a log record, looked up in place
+    std::string record = std::string("ASSERT ") + last.module + ":" + std::to_string(last.id);
+    const size_t moduleLength = strlen(last.module);
+    results.push_back(MeasureWarm(options, "builtin.last_hit_slice", builtinCount, [&record, &last, moduleLength]() {
+        QAssertMetaDescription description = {nullptr, nullptr, nullptr};
+        bool found = QAssertMetaGetDescriptionN(record.c_str() + 7, moduleLength, last.id, &description);
+        return reinterpret_cast<uintptr_t>(description.brief) + (found ? 1u : 0u);
+    }));
+
+    QAssertMetaRegisterUnknownCallback(MissCallback);
+    results.push_back(MeasureWarm(options, "builtin.miss_with_callback", builtinCount, miss));
+    results.push_back(MeasureCold(options, "builtin.miss_with_callback", builtinCount, miss));
+    QAssertMetaInit();
+
+    results.push_back(MeasureWarm(options, "builtin.search", builtinCount, []() {
+        QAssertMetaSearchResult found[4];
+        return static_cast<uintptr_t>(QAssertMetaSearch("queue full", found, 4));
+    }));
+    results.push_back(MeasureWarm(options, "builtin.fuzzy_truncated_module", builtinCount, [&last]() {
+        QAssertMetaFuzzyMatch found[4];
+        std::string truncated(last.module, strlen(last.module) - 2);
+        return static_cast<uintptr_t>(QAssertMetaFuzzyLookup(truncated.c_str(), last.id, found, 4));
+    }));
+
+    for (size_t size : {10u, 100u, 1000u, 10000u, 100000u})
+    {
+        qassert_meta::SyntheticTableConfig config;
+        config.itemCount = size;
+        config.moduleCount = (size + 9) / 10;
+        config.sharedPrefixModules = config.moduleCount / 2;
+        qassert_meta::SyntheticTable table(config);
+        std::vector<uint32_t> index((QAssertMetaIndexStorageSize(table.Items()) / sizeof(uint32_t)) + 1);
+
+        const std::string prefix = "synthetic_" + std::to_string(size);
+        const QAssertMetaItem & tableFirst = table[0];
+        const QAssertMetaItem & tableLast = table[table.Size() - 1];
+        auto tableFirstHit = [&tableFirst]() { return Lookup(tableFirst.module, tableFirst.id); };
+        auto tableLastHit = [&tableLast]() { return Lookup(tableLast.module, tableLast.id); };
+
+        QAssertMetaInit();
+        QAssertMetaRegisterIndexedTable(table.Items(), index.data(), index.size() * sizeof(uint32_t));
+        results.push_back(MeasureWarm(options, prefix + ".first_hit", size, tableFirstHit));
+        results.push_back(MeasureWarm(options, prefix + ".last_hit", size, tableLastHit));
+        results.push_back(MeasureCold(options, prefix + ".last_hit", size, tableLastHit));
+        results.push_back(MeasureWarm(options, prefix + ".miss_no_callback", size, miss));
+        std::mt19937 random(7);
+        std::vector<const QAssertMetaItem *> keys(1024);
+        for (const QAssertMetaItem *& key : keys)
+        {
+            key = &table[random() % table.Size()];
+        }
+        size_t next = 0;
+        results.push_back(MeasureWarm(options, prefix + ".random_hit", size, [&keys, &next]() {
+            const QAssertMetaItem * key = keys[next++ % keys.size()];
+            return Lookup(key->module, key->id);
+        }));
+        results.push_back(MeasureWarm(options, prefix + ".enumerate_module", size, [&tableLast]() {
+            QAssertMetaIterator iterator;
+            QAssertMetaEntry entry;
+            uintptr_t count = 0;
+            QAssertMetaIteratorInit(&iterator, tableLast.module, tableLast.id - 99, tableLast.id);
+            while (QAssertMetaIteratorNext(&iterator, &entry))
+            {
+                ++count;
+            }
+            return count;
+        }));
+
+        QAssertMetaInit();
+        QAssertMetaRegisterTable(table.Items());
+        results.push_back(MeasureWarm(options, prefix + ".scan_last_hit", size, tableLastHit));
+    }
+    QAssertMetaInit();
+
+#if defined(QASSERT_META_STARTUP_PROBE)
+    for (const auto & startup : {std::make_pair(STARTUP_BASELINE, QASSERT_META_STARTUP_BASELINE),
+                                 std::make_pair(STARTUP_LIBRARY, QASSERT_META_STARTUP_PROBE)})
+    {
+        Result result;
+        if (MeasureStartup(options, startup.first, startup.second, result))
+        {
+            results.push_back(result);
+        }
+        else
+        {
+            fprintf(stderr, "unable to run %s\n", startup.second);
+        }
+    }
+#endif
+    return results;
+}
+
+void WriteJson(FILE * file, const std::vector<Result> & results)
+{
+    QAssertMetaStatsCounters counters;
+    QAssertMetaLatencyHistogram histogram;
+    fprintf(file, "{\n");
+    fprintf(file, "  \"benchmark\": \"qassert-meta\",\n");
+    fprintf(file, "  \"variant\": \"%s\",\n", BENCH_VARIANT);
+    fprintf(file, "  \"stats\": %s,\n", QAssertMetaStatsGetCounters(&counters) ? "true" : "false");
+    fprintf(file, "  \"latency_histogram\": %s,\n", QAssertMetaLatencyGetHistogram(&histogram) ? "true" : "false");
+    fprintf(file, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const Result & result = results[i];
+        fprintf(file, "    {\"name\": \"%s\", \"table_size\": %zu, \"iterations\": %llu, "
+                      "\"ns_per_op\": %.3f, \"min_ns_per_op\": %.3f}%s\n",
+                result.name.c_str(), result.tableSize, static_cast<unsigned long long>(result.iterations),
+                result.nsPerOp, result.minNsPerOp, (i + 1 < results.size()) ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+}
+
+/**
+ * Reads the results of a previous run, relying on this program's
+ * own output format of one result object per line.
+ */
+std::map<std::string, double> ReadBaseline(const char * path)
+{
+    std::map<std::string, double> baseline;
+    std::ifstream input(path);
+    std::string line;
+    while (std::getline(input, line))
+    {
+        const std::string nameKey = "\"name\": \"";
+        const std::string nsKey = "\"ns_per_op\": ";
+        size_t name = line.find(nameKey);
+        size_t ns = line.find(nsKey);
+        if ((name == std::string::npos) || (ns == std::string::npos))
+        {
+            continue;
+        }
+        name += nameKey.size();
+        size_t nameEnd = line.find('"', name);
+        baseline[line.substr(name, nameEnd - name)] = strtod(line.c_str() + ns + nsKey.size(), nullptr);
+    }
+    return baseline;
+}
+
+int Compare(const Options & options, const std::vector<Result> & results)
+{
+    std::map<std::string, double> baseline = ReadBaseline(options.compare);
+    if (baseline.empty())
+    {
+        fprintf(stderr, "no baseline results read from %s\n", options.compare);
+        return 2;
+    }
+
+    int regressions = 0;
+    for (const Result & result : results)
+    {
+        auto entry = baseline.find(result.name);
+        if ((entry == baseline.end()) || (entry->second <= 0.0))
+        {
+            continue;
+        }
+
+        double change = ((result.nsPerOp / entry->second) - 1.0) * 100.0;
+        bool regressed = change > options.threshold;
+        regressions += regressed ? 1 : 0;
+        fprintf(stderr, "%-10s %-45s %10.2f -> %10.2f ns/op (%+.1f%%)\n", regressed ? "REGRESSION" : "ok",
+                result.name.c_str(), entry->second, result.nsPerOp, change);
+    }
+
+    //lookup cost must not grow with the table, whatever the baseline
+    double smallNs = 0.0;
+    double largeNs = 0.0;
+    for (const Result & result : results)
+    {
+        smallNs = (result.name == SCALING_SMALL) ? result.nsPerOp : smallNs;
+        largeNs = (result.name == SCALING_LARGE) ? result.nsPerOp : largeNs;
+    }
+    bool flat = largeNs < (smallNs * MAX_LOOKUP_COST_GROWTH);
+    regressions += flat ? 0 : 1;
+    fprintf(stderr, "%-10s %-45s %10.2f -> %10.2f ns/op (%.1fx)\n", flat ? "ok" : "SCALING", "synthetic random_hit",
+            smallNs, largeNs, (smallNs > 0.0) ? (largeNs / smallNs) : 0.0);
+
+    //nor process startup when no assert fires, if measured
+    double baselineNs = 0.0;
+    double libraryNs = 0.0;
+    for (const Result & result : results)
+    {
+        baselineNs = (result.name == STARTUP_BASELINE) ? result.nsPerOp : baselineNs;
+        libraryNs = (result.name == STARTUP_LIBRARY) ? result.nsPerOp : libraryNs;
+    }
+    if ((baselineNs > 0.0) && (libraryNs > 0.0))
+    {
+        bool unchanged = libraryNs <= ((baselineNs * MAX_STARTUP_RATIO) + STARTUP_SLACK_NS);
+        regressions += unchanged ? 0 : 1;
+        fprintf(stderr, "%-10s %-45s %10.0f -> %10.0f ns (%.1fx)\n", unchanged ? "ok" : "STARTUP",
+                "startup without and with the library", baselineNs, libraryNs, libraryNs / baselineNs);
+    }
+    return (regressions != 0) ? 1 : 0;
+}
+
+bool ParseOptions(int argc, char ** argv, Options & options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = (i + 1) < argc;
+        if (0 == strcmp(argv[i], "--quick"))
+        {
+            options.quick = true;
+        }
+        else if ((0 == strcmp(argv[i], "--output")) && hasValue)
+        {
+            options.output = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "--compare")) && hasValue)
+        {
+            options.compare = argv[++i];
+        }
+        else if ((0 == strcmp(argv[i], "--threshold")) && hasValue)
+        {
+            options.threshold = strtod(argv[++i], nullptr);
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        fprintf(stderr, "usage: %s [--quick] [--output <file.json>] [--compare <baseline.json>] "
+                        "[--threshold <percent>]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<Result> results = RunAll(options);
+
+    FILE * output = (nullptr == options.output) ? stdout : fopen(options.output, "w");
+    if (nullptr == output)
+    {
+        fprintf(stderr, "unable to write %s\n", options.output);
+        return 2;
+    }
+    WriteJson(output, results);
+    if (output != stdout)
+    {
+        fclose(output);
+    }
+
+    return (nullptr == options.compare) ? 0 : Compare(options, results);
+}
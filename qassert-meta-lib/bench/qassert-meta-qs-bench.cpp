@@ -0,0 +1,232 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * QS trace decoding throughput.
+ *
+ * usage: qassert-meta-qs-bench [--quick] [--input <trace file>] [--output <file.json>]
+ *
+ * Decodes a recorded trace (--input), or a synthetic one: a typical mix of
+ * dictionary, user and state machine records with an assert every 64 records,
+ * fed in 64KB chunks as read from a file. Reports MB/s and records/s as JSON.
+ *
+ * Also reports the rate of asserts through storm detection, for a stream
+ * of one storming assert among 128 others.
+ */
+
+#include "qassert-meta-qs.h"
+#include "qassert-meta-storm.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace qassert_meta;
+
+namespace {
+
+constexpr size_t CHUNK_SIZE = 64u * 1024u;
+
+struct CountingListener : public QsListener {
+    uint64_t described = 0;
+
+    void OnAssert(const QsAssertRecord & record) override
+    {
+        described += record.described ? 1u : 0u;
+    }
+};
+
+std::vector<uint8_t> SyntheticTrace(size_t records)
+{
+    static const char * const MODULES[] = {"qf_actq", "qf_dyn", "qf_mem", "qf_time", "qep_hsm", "app_sensor"};
+    QsFormat format;
+    std::vector<uint8_t> trace;
+    std::vector<uint8_t> payload;
+    uint8_t sequence = 0;
+    for (size_t i = 0; i < records; ++i)
+    {
+        payload.clear();
+        uint8_t record;
+        if ((i % 64u) == 63u)
+        {
+            record = static_cast<uint8_t>(QsRecordType::AssertFail);
+            QsEncodeAssertPayload(payload, format, i, ((i / 64u) % 4u) ? 190u : 999u, MODULES[(i / 64u) % 6u]);
+        }
+        else if (i < 256u)
+        {
+            record = static_cast<uint8_t>(QsRecordType::ObjDict);
+            uint32_t object = 0x20000000u + static_cast<uint32_t>(i) * 0x7Eu; //with bytes to escape
+            payload.assign(reinterpret_cast<const uint8_t *>(&object), reinterpret_cast<const uint8_t *>(&object) + 4);
+            std::string name = "AO_Object" + std::to_string(i);
+            payload.insert(payload.end(), name.c_str(), name.c_str() + name.size() + 1);
+        }
+        else
+        {
+            record = static_cast<uint8_t>(i % 60u); //state machine and user records
+            for (size_t j = 0; j < 12u; ++j)
+            {
+                payload.push_back(static_cast<uint8_t>(i * 31u + j));
+            }
+        }
+        QsEncodeFrame(trace, sequence++, record, payload.data(), payload.size());
+    }
+    return trace;
+}
+
+double StormAssertsPerSecond(size_t asserts)
+{
+    std::vector<std::string> modules;
+    for (int i = 0; i < 64; ++i)
+    {
+        modules.push_back("app_module_" + std::to_string(i));
+    }
+
+    StormListener listener;
+    StormDetector storms(listener);
+    uint64_t shown = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < asserts; ++i)
+    {
+        //every other assert is the storm, at 1 us intervals
+        const std::string & module = (i % 2u) ? modules[(i / 2u) % 64u] : modules[0];
+        int id = (i % 2u) ? static_cast<int>((i / 128u) % 2u) : 190;
+        shown += storms.Observe(module.data(), module.size(), id, i * 1000u) ? 1u : 0u;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (shown == asserts) //all shown would mean the storm was missed
+    {
+        fprintf(stderr, "storm not detected\n");
+    }
+    return static_cast<double>(asserts) / elapsed.count();
+}
+
+bool ReadFile(const char * path, std::vector<uint8_t> & data)
+{
+    FILE * file = fopen(path, "rb");
+    if (nullptr == file)
+    {
+        return false;
+    }
+    uint8_t buffer[CHUNK_SIZE];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        data.insert(data.end(), buffer, buffer + read);
+    }
+    fclose(file);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    bool quick = false;
+    const char * input = nullptr;
+    const char * outputPath = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        const char * value = ((i + 1) < argc) ? argv[i + 1] : nullptr;
+        if (0 == strcmp(argv[i], "--quick"))
+        {
+            quick = true;
+        }
+        else if ((0 == strcmp(argv[i], "--input")) && value)
+        {
+            input = value;
+            ++i;
+        }
+        else if ((0 == strcmp(argv[i], "--output")) && value)
+        {
+            outputPath = value;
+            ++i;
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--quick] [--input <trace file>] [--output <file.json>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<uint8_t> trace;
+    if (nullptr == input)
+    {
+        trace = SyntheticTrace(quick ? 100000u : 1000000u);
+    }
+    else if (!ReadFile(input, trace))
+    {
+        fprintf(stderr, "unable to read %s\n", input);
+        return 1;
+    }
+
+    //best of several passes, each with a new decoder
+    const int passes = quick ? 3 : 7;
+    double bestSeconds = 0.0;
+    QsDecoderStats stats;
+    uint64_t described = 0;
+    for (int pass = 0; pass < passes; ++pass)
+    {
+        CountingListener listener;
+        QsDecoder decoder(listener);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t offset = 0; offset < trace.size(); offset += CHUNK_SIZE)
+        {
+            decoder.Feed(trace.data() + offset, std::min(CHUNK_SIZE, trace.size() - offset));
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if ((0 == pass) || (elapsed.count() < bestSeconds))
+        {
+            bestSeconds = elapsed.count();
+        }
+        stats = decoder.Stats();
+        described = listener.described;
+    }
+
+    double stormRate = StormAssertsPerSecond(quick ? 1000000u : 10000000u);
+
+    FILE * output = (nullptr == outputPath) ? stdout : fopen(outputPath, "w");
+    if (nullptr == output)
+    {
+        fprintf(stderr, "unable to write %s\n", outputPath);
+        return 1;
+    }
+    fprintf(output, "{\n");
+    fprintf(output, "  \"benchmark\": \"qassert-meta-qs\",\n");
+    fprintf(output, "  \"input\": \"%s\",\n", (nullptr == input) ? "synthetic" : input);
+    fprintf(output, "  \"bytes\": %zu,\n", trace.size());
+    fprintf(output, "  \"frames\": %llu,\n", static_cast<unsigned long long>(stats.frames));
+    fprintf(output, "  \"asserts\": %llu,\n", static_cast<unsigned long long>(stats.asserts));
+    fprintf(output, "  \"described_asserts\": %llu,\n", static_cast<unsigned long long>(described));
+    fprintf(output, "  \"checksum_errors\": %llu,\n", static_cast<unsigned long long>(stats.checksumErrors));
+    fprintf(output, "  \"seconds\": %.6f,\n", bestSeconds);
+    fprintf(output, "  \"mb_per_s\": %.1f,\n", static_cast<double>(trace.size()) / bestSeconds / 1e6);
+    fprintf(output, "  \"records_per_s\": %.0f,\n", static_cast<double>(stats.frames) / bestSeconds);
+    fprintf(output, "  \"storm_asserts_per_s\": %.0f\n", stormRate);
+    fprintf(output, "}\n");
+    if (output != stdout)
+    {
+        fclose(output);
+    }
+    return 0;
+}
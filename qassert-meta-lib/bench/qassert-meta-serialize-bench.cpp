@@ -0,0 +1,174 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * Serialization throughput, exporting large tables.
+ *
+ * usage: qassert-meta-serialize-bench [--quick] [--output <file.json>]
+ *
+ * Serializes a synthetic registered table of 100k entries as JSON and CBOR,
+ * and the internal table as JSON from its generated text and escaped at
+ * runtime, through a 64KB buffer whose flushes are discarded. Reports the
+ * best of several passes in MB/s and entries/s as JSON.
+ */
+
+#include "qassert-meta-serialize.h"
+#include "qassert-meta-synthetic.h"
+extern "C" {
+#include "qassert-meta-private.h"
+}
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace qassert_meta;
+
+namespace {
+
+constexpr size_t BUFFER_SIZE = 64u * 1024u;
+
+struct Result {
+    std::string name;
+    uint64_t entries;
+    uint64_t bytes;
+    double seconds;
+};
+
+bool Discard(const uint8_t * data, size_t size, void * context)
+{
+    (void)data;
+    (void)size;
+    (void)context;
+    return true;
+}
+
+Result Measure(const std::string & name, QAssertMetaSerializeFormat format, int passes,
+               bool (*write)(QAssertMetaSerializer *))
+{
+    static uint8_t buffer[BUFFER_SIZE];
+    Result result = {name, 0, 0, 0.0};
+    for (int pass = 0; pass < passes; ++pass)
+    {
+        QAssertMetaSerializer serializer;
+        QAssertMetaSerializerInit(&serializer, format, buffer, sizeof(buffer), Discard, nullptr);
+        auto start = std::chrono::steady_clock::now();
+        bool ok = write(&serializer) && QAssertMetaSerializeFinish(&serializer);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (!ok)
+        {
+            fprintf(stderr, "%s failed\n", name.c_str());
+        }
+        if ((0 == pass) || (elapsed.count() < result.seconds))
+        {
+            result.seconds = elapsed.count();
+        }
+        result.entries = serializer.entries;
+        result.bytes = QAssertMetaSerializedBytes(&serializer);
+    }
+    return result;
+}
+
+bool WriteAll(QAssertMetaSerializer * serializer)
+{
+    return QAssertMetaSerializeBeginArray(serializer) && QAssertMetaSerializeAll(serializer) &&
+           QAssertMetaSerializeEndArray(serializer);
+}
+
+bool WriteBuiltinAtRuntime(QAssertMetaSerializer * serializer)
+{
+    return QAssertMetaSerializeBeginArray(serializer) &&
+           QAssertMetaSerializeItems(serializer, m_qassert_meta_items, SIZE_MAX) &&
+           QAssertMetaSerializeEndArray(serializer);
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    bool quick = false;
+    const char * outputPath = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (0 == strcmp(argv[i], "--quick"))
+        {
+            quick = true;
+        }
+        else if ((0 == strcmp(argv[i], "--output")) && ((i + 1) < argc))
+        {
+            outputPath = argv[++i];
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--quick] [--output <file.json>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    const int passes = quick ? 3 : 7;
+    std::vector<Result> results;
+
+    //internal table only
+    QAssertMetaInit();
+    results.push_back(Measure("builtin.json_generated", QASSERT_META_SERIALIZE_JSON, passes * 10, WriteAll));
+    results.push_back(Measure("builtin.json_runtime", QASSERT_META_SERIALIZE_JSON, passes * 10,
+                              WriteBuiltinAtRuntime));
+    results.push_back(Measure("builtin.cbor", QASSERT_META_SERIALIZE_CBOR, passes * 10, WriteAll));
+
+    SyntheticTableConfig config;
+    config.itemCount = quick ? 10000u : 100000u;
+    config.moduleCount = config.itemCount / 10u;
+    SyntheticTable table(config);
+    QAssertMetaRegisterTable(table.Items());
+    const std::string prefix = "synthetic_" + std::to_string(table.Size());
+    results.push_back(Measure(prefix + ".json", QASSERT_META_SERIALIZE_JSON, passes, WriteAll));
+    results.push_back(Measure(prefix + ".cbor", QASSERT_META_SERIALIZE_CBOR, passes, WriteAll));
+    QAssertMetaInit();
+
+    FILE * output = (nullptr == outputPath) ? stdout : fopen(outputPath, "w");
+    if (nullptr == output)
+    {
+        fprintf(stderr, "unable to write %s\n", outputPath);
+        return 1;
+    }
+    fprintf(output, "{\n");
+    fprintf(output, "  \"benchmark\": \"qassert-meta-serialize\",\n");
+    fprintf(output, "  \"buffer_size\": %zu,\n", BUFFER_SIZE);
+    fprintf(output, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const Result & result = results[i];
+        fprintf(output, "    {\"name\": \"%s\", \"entries\": %llu, \"bytes\": %llu, \"seconds\": %.6f, "
+                        "\"mb_per_s\": %.1f, \"entries_per_s\": %.0f}%s\n",
+                result.name.c_str(), static_cast<unsigned long long>(result.entries),
+                static_cast<unsigned long long>(result.bytes), result.seconds,
+                static_cast<double>(result.bytes) / result.seconds / 1e6,
+                static_cast<double>(result.entries) / result.seconds, (i + 1 < results.size()) ? "," : "");
+    }
+    fprintf(output, "  ]\n}\n");
+    if (output != stdout)
+    {
+        fclose(output);
+    }
+    return 0;
+}
@@ -0,0 +1,134 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_ASYNC_H
+#define QASSERT_META_QASSERT_META_ASYNC_H
+
+#include "qassert-meta.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Asynchronous lookup (host only), for triage tools whose unknown callback
+ * is slow, such as one querying a database or another process.
+ *
+ * A submitted lookup found in the internal, application or registered
+ * tables completes inline. Otherwise it is queued for a bounded pool of
+ * worker threads, which call the unknown callback. Submissions of a key
+ * already queued or running wait for that call rather than making another.
+ * Each submission is completed once, on the configured completion callback
+ * (on a worker thread), or queued for QAssertMetaAsyncPoll and signalled on
+ * a pollable file descriptor (an eventfd on Linux, else a pipe).
+ *
+ * The unknown callback is then called from several threads at once, and
+ * must be thread safe. Submit and Poll may be called from any thread.
+ *
+ * An unknown context callback is given an arena of config.arenaSize bytes,
+ * one per worker, and no userData. Strings it generates are copied to each
+ * submission waiting for the key. They remain valid during the completion
+ * callback, or until the next QAssertMetaAsyncPoll.
+ */
+
+typedef struct QAssertMetaAsync QAssertMetaAsync;
+
+typedef enum {
+    QASSERT_META_ASYNC_FOUND,     //completed inline, output provided
+    QASSERT_META_ASYNC_NOT_FOUND, //completed inline: not in the tables, and no unknown callback to ask
+    QASSERT_META_ASYNC_PENDING,   //queued, a completion will follow
+    QASSERT_META_ASYNC_FULL       //refused, too many lookups pending
+} QAssertMetaAsyncStatus;
+
+typedef struct {
+    char module[QASSERT_META_CALLBACK_MODULE_SIZE];
+    int id;
+    bool found;
+    QAssertMetaDescription description; //as provided by the unknown callback, if found
+    void * userData;                    //as submitted
+} QAssertMetaAsyncCompletion;
+
+typedef void (*QAssertMetaAsyncCallback)(const QAssertMetaAsyncCompletion * completion, void * context);
+
+typedef struct {
+    size_t workers;        //threads calling the unknown callback, 0: 2
+    size_t maxKeys;        //distinct module/id pairs queued or running, 0: 64
+    size_t maxPending;     //submissions awaiting completion (or their last poll), 0: 4 x maxKeys
+    QAssertMetaAsyncCallback callback; //NULL: completions are polled
+    void * context;
+    size_t arenaSize;      //bytes of each worker's arena for an unknown context callback, 0: none
+} QAssertMetaAsyncConfig;
+
+typedef struct {
+    uint64_t submitted;
+    uint64_t completedInline;
+    uint64_t deduplicated; //joined a key already queued or running
+    uint64_t resolverCalls;
+    uint64_t refused;
+} QAssertMetaAsyncStats;
+
+/**
+ * Start the worker pool.
+ * @param config: NULL for the defaults.
+ * @return: NULL if out of memory, or threads could not be created.
+ */
+QAssertMetaAsync * QAssertMetaAsyncCreate(const QAssertMetaAsyncConfig * config);
+
+/**
+ * Stop the worker pool, waiting for unknown callback calls in progress.
+ * Lookups not yet completed are dropped, without completion.
+ */
+void QAssertMetaAsyncDestroy(QAssertMetaAsync * async);
+
+/**
+ * Submit a lookup.
+ * @param output:   filled in if QASSERT_META_ASYNC_FOUND is returned.
+ * @param userData: returned with the completion.
+ * Modules of QASSERT_META_CALLBACK_MODULE_SIZE bytes or more are not given
+ * to the unknown callback, as with QAssertMetaGetDescriptionN.
+ */
+QAssertMetaAsyncStatus QAssertMetaAsyncSubmit(QAssertMetaAsync * async, const char * module, int id,
+                                              QAssertMetaDescription * output, void * userData);
+
+/**
+ * @return: a file descriptor, readable while completions are waiting to
+ *          be polled. Not to be read or closed by the caller.
+ */
+int QAssertMetaAsyncFd(const QAssertMetaAsync * async);
+
+/**
+ * Take up to max waiting completions, in the order completed. Never blocks.
+ * Generated strings of the completions taken by the previous call are released.
+ * @return: the number of completions taken.
+ */
+size_t QAssertMetaAsyncPoll(QAssertMetaAsync * async, QAssertMetaAsyncCompletion * completions, size_t max);
+
+void QAssertMetaAsyncGetStats(QAssertMetaAsync * async, QAssertMetaAsyncStats * stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //QASSERT_META_QASSERT_META_ASYNC_H
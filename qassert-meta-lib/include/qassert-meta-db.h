@@ -0,0 +1,140 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_DB_H
+#define QASSERT_META_QASSERT_META_DB_H
+
+#include "qassert-meta.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Binary QASSERT meta database (host only).
+ *
+ * A position independent, little endian file holding a header, a hashed
+ * index, the entries and a deduplicated string pool. Readers map the file
+ * and look up entries directly from the image, no parsing or allocation.
+ *
+ *  header:   QAssertMetaDbHeader
+ *  buckets:  bucketCount x uint32, entry index + 1, 0 if empty (linear probing)
+ *  entries:  entryCount x QAssertMetaDbEntry
+ *  strings:  NUL terminated strings, offsets relative to stringsOffset
+ */
+#define QASSERT_META_DB_MAGIC     0x444D4151u  //"QAMD"
+#define QASSERT_META_DB_VERSION   1u
+#define QASSERT_META_DB_NO_STRING 0xFFFFFFFFu
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t fileSize;
+    uint32_t entryCount;
+    uint32_t bucketCount;   //power of two
+    uint32_t bucketsOffset;
+    uint32_t entriesOffset;
+    uint32_t stringsOffset;
+    uint32_t stringsSize;
+} QAssertMetaDbHeader;
+
+typedef struct {
+    uint32_t hash;     //see QAssertMetaPrivateHash
+    int32_t  id;
+    uint32_t module;   //string pool offsets, or QASSERT_META_DB_NO_STRING
+    uint32_t brief;
+    uint32_t tips;
+    uint32_t url;
+} QAssertMetaDbEntry;
+
+/**
+ * An opened database. Treat as opaque.
+ */
+typedef struct {
+    const uint8_t * image;
+    size_t size;
+    void * mapping;     //non NULL if mapped by QAssertMetaDbOpen
+    size_t mappingSize;
+} QAssertMetaDb;
+
+/**
+ * Write the internal QP table (with its link time overrides), the
+ * application table and all registered tables to a database.
+ * Entries are written in lookup order; if a module/id pair is duplicated
+ * the first occurrence wins, matching QAssertMetaGetDescription.
+ * @return: true if the database was completely written.
+ */
+bool QAssertMetaDbWrite(FILE * file);
+
+/**
+ * Convenience wrapper of QAssertMetaDbWrite, (re)creating the file at path.
+ */
+bool QAssertMetaDbExport(const char * path);
+
+/**
+ * Memory map a database file.
+ * @return: true if mapped and the header is valid.
+ */
+bool QAssertMetaDbOpen(QAssertMetaDb * db, const char * path);
+
+/**
+ * Use a database image already in memory. The image must be 4 byte aligned
+ * and remain valid while the db is in use.
+ * @return: true if the header is valid.
+ */
+bool QAssertMetaDbAttach(QAssertMetaDb * db, const void * image, size_t size);
+
+/**
+ * Release the mapping, if any, of an opened database.
+ */
+void QAssertMetaDbClose(QAssertMetaDb * db);
+
+/**
+ * Lookup a module/id pair. Output strings point into the image.
+ * @return: true: found and output filled in.
+ */
+bool QAssertMetaDbLookup(const QAssertMetaDb * db, const char * module, int id, QAssertMetaDescription* output);
+
+/**
+ * Lookup a module/id pair, with the module given as a slice of length bytes
+ * of a larger buffer, which need not be NUL terminated.
+ * @return: true: found and output filled in.
+ */
+bool QAssertMetaDbLookupN(const QAssertMetaDb * db, const char * module, size_t length, int id,
+                          QAssertMetaDescription* output);
+
+/**
+ * Resolve unknown asserts from the database, by registering
+ * an UnknownQAssertCallback. Pass NULL to remove the callback.
+ * The db must remain open while installed.
+ */
+void QAssertMetaDbInstall(const QAssertMetaDb * db);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //QASSERT_META_QASSERT_META_DB_H
@@ -0,0 +1,104 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_ENUMERATE_H
+#define QASSERT_META_QASSERT_META_ENUMERATE_H
+
+#include "qassert-meta.h"
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Enumeration of the entries the library knows, without copying: each
+ * entry points at the item in its table. The walk is in lookup order:
+ *
+ *  - the internal table, in (module, id) order, each item replaced by its
+ *    link time override if any. A module and id range are resolved by
+ *    binary search of the generated module index.
+ *  - the application table, then each registered table, in table order.
+ *    A module with an id range narrower than an indexed table is resolved
+ *    by probing the table's hash index for each id, in id order (a pair
+ *    duplicated within the table is then found once, as by lookups).
+ *
+ * The order is stable, the same for every walk of the same tables. A
+ * filtered walk yields its entries in the order of the unfiltered walk,
+ * unless probing a table not sorted by id. A pair duplicated across tables
+ * is enumerated each time, the first being the one looked up.
+ *
+ * Tables must not be registered or QAssertMetaInit called during a walk.
+ * Iterators are independent, so walks may run on many threads.
+ */
+
+typedef enum {
+    QASSERT_META_SOURCE_BUILTIN,     //the internal QP table, or its override
+    QASSERT_META_SOURCE_APPLICATION, //QASSERT_META_APPLICATION_TABLE
+    QASSERT_META_SOURCE_REGISTERED   //a table registered via QAssertMetaRegisterTable
+} QAssertMetaSource;
+
+typedef struct {
+    const QAssertMetaItem * item;
+    QAssertMetaSource source;
+    size_t table; //the registered table, in registration order, for QASSERT_META_SOURCE_REGISTERED
+} QAssertMetaEntry;
+
+//iterator state, see QAssertMetaIteratorInit. Fields are private.
+typedef struct {
+    const char * module;
+    size_t moduleLength;
+    int minId;
+    int maxId;
+    size_t source;  //0: the internal table, n: QAssertMetaPrivateGetTable(n - 1)
+    size_t group;   //the internal table's module being walked
+    size_t groupEnd;
+    const QAssertMetaItem * items;
+    size_t position;
+    size_t end;
+    int64_t probeId;
+    bool probing;
+    bool done;
+} QAssertMetaIterator;
+
+/**
+ * Start a walk of the entries of a module (or all modules) with ids in [minId, maxId].
+ * @param module:  terminated module name, NULL for all modules. Must remain
+ *                 valid during the walk.
+ * For all entries: QAssertMetaIteratorInit(&iterator, NULL, INT_MIN, INT_MAX)
+ */
+void QAssertMetaIteratorInit(QAssertMetaIterator * iterator, const char * module, int minId, int maxId);
+
+/**
+ * Get the next entry.
+ * @return: false at the end of the walk.
+ */
+bool QAssertMetaIteratorNext(QAssertMetaIterator * iterator, QAssertMetaEntry * entry);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //QASSERT_META_QASSERT_META_ENUMERATE_H
@@ -0,0 +1,71 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_FUZZY_H
+#define QASSERT_META_QASSERT_META_FUZZY_H
+
+#include "qassert-meta.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//candidates below this confidence (percent) are not reported
+#ifndef QASSERT_META_FUZZY_MIN_CONFIDENCE
+#define QASSERT_META_FUZZY_MIN_CONFIDENCE 25
+#endif
+
+/**
+ *   An approximate match, an internal QP table (as looked up, with link
+ *   time overrides) or application table item, and the confidence
+ *   (0..100 percent) that it is the assert which was intended.
+ */
+typedef struct {
+    const QAssertMetaItem * item;
+    unsigned confidence;
+} QAssertMetaFuzzyMatch;
+
+/**
+ * Approximate lookup, for log records where QAssertMetaGetDescription
+ * found no exact match, for example a truncated module ("qf_ac") or a
+ * corrupted id.
+ *
+ * Internal table modules are found via a bigram index generated at build
+ * time, application table modules are compared directly. Modules are
+ * scored by edit distance, or by length when the module is a
+ * truncation of a known module. Ids score by exact match, a one or two bit
+ * difference, or the same id family (hundreds). Does not allocate.
+ *
+ * @param module:     the (possibly damaged) module string. An empty module has no matches.
+ * @param id:         the (possibly damaged) id.
+ * @param matches:    output array for the best candidates, highest confidence first.
+ * @param maxMatches: capacity of matches.
+ * @return: the number of matches written.
+ */
+size_t QAssertMetaFuzzyLookup(const char * module, int id, QAssertMetaFuzzyMatch * matches, size_t maxMatches);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //QASSERT_META_QASSERT_META_FUZZY_H
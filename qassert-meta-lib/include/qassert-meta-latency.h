@@ -0,0 +1,94 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_LATENCY_H
+#define QASSERT_META_QASSERT_META_LATENCY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Lookup latency instrumentation, for confirming QAssertMetaGetDescription
+ * remains cheap as tables grow. Only collected when the library is built
+ * with QASSERT_META_ENABLE_LATENCY_HISTOGRAM=1 (cmake option
+ * CMS_QASSERT_META_ENABLE_LATENCY_HISTOGRAM).
+ *
+ * Each lookup is timed (rdtsc cycles on x86, otherwise clock_gettime
+ * nanoseconds, or a timestamp macro provided via QASSERT_META_LATENCY_TIMESTAMP)
+ * and counted in a log2 bucket of its outcome's histogram. Bucket 0 holds
+ * latencies below 2, bucket n latencies in [2^n, 2^(n+1)). Counters are
+ * relaxed atomics, so lookups may run on many threads. Never allocates.
+ */
+#ifndef QASSERT_META_ENABLE_LATENCY_HISTOGRAM
+#define QASSERT_META_ENABLE_LATENCY_HISTOGRAM 0
+#endif
+
+#define QASSERT_META_LATENCY_BUCKET_COUNT 32
+
+typedef enum {
+    QASSERT_META_LATENCY_BUILTIN_HIT,
+    QASSERT_META_LATENCY_REGISTERED_HIT,
+    QASSERT_META_LATENCY_CALLBACK_HIT,
+    QASSERT_META_LATENCY_MISS,
+    QASSERT_META_LATENCY_CATEGORY_COUNT
+} QAssertMetaLatencyCategory;
+
+typedef struct {
+    uint32_t buckets[QASSERT_META_LATENCY_CATEGORY_COUNT][QASSERT_META_LATENCY_BUCKET_COUNT];
+} QAssertMetaLatencyHistogram;
+
+//receives one NUL terminated line of a histogram dump, without a line ending.
+typedef void (*QAssertMetaLatencyLineWriter)(const char * line, void * context);
+
+/**
+ * Snapshot the histograms.
+ * @return: false if the instrumentation is not enabled in this build.
+ */
+bool QAssertMetaLatencyGetHistogram(QAssertMetaLatencyHistogram * histogram);
+
+/**
+ * @return: the unit of the latencies, for example "cycles" or "ns".
+ */
+const char * QAssertMetaLatencyUnit(void);
+
+/**
+ * Dump the non-empty buckets as text lines, for example
+ * "builtin_hit [64, 128) cycles: 1200".
+ * @return: false if the instrumentation is not enabled in this build.
+ */
+bool QAssertMetaLatencyDump(QAssertMetaLatencyLineWriter writer, void * context);
+
+/**
+ * Zero all histograms.
+ */
+void QAssertMetaLatencyReset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //QASSERT_META_QASSERT_META_LATENCY_H
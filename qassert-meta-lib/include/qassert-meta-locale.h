@@ -0,0 +1,152 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_LOCALE_H
+#define QASSERT_META_QASSERT_META_LOCALE_H
+
+#include "qassert-meta.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Localization packs of the internal QP table (host only).
+ *
+ * A pack holds translated brief and tips strings of one locale, stored
+ * parallel to the internal table so lookups share its generated key index:
+ * a pack contains no keys or index of its own. Packs are little endian,
+ * position independent files, memory mapped by the first lookup with their
+ * locale. A locale never used costs only its registration.
+ *
+ *  header:   QAssertMetaLocaleHeader
+ *  entries:  keyCount x QAssertMetaLocaleEntry, in internal table order
+ *  strings:  NUL terminated strings, offsets relative to stringsOffset
+ *
+ * keyFingerprint identifies the keys of the internal table the pack was
+ * written for. A pack of a different table is rejected, English is used.
+ */
+#define QASSERT_META_LOCALE_MAGIC     0x4C4D4151u  //"QAML"
+#define QASSERT_META_LOCALE_VERSION   1u
+#define QASSERT_META_LOCALE_NO_STRING 0xFFFFFFFFu
+
+//maximum number of locales that may be registered via QAssertMetaLocaleRegister
+#ifndef QASSERT_META_MAX_LOCALES
+#define QASSERT_META_MAX_LOCALES 8
+#endif
+
+//maximum length of a locale name, such as "de" or "ja_JP"
+#define QASSERT_META_LOCALE_NAME_SIZE 16
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t fileSize;
+    uint32_t keyCount;       //entries in the internal table
+    uint32_t keyFingerprint; //see QAssertMetaLocaleKeyFingerprint
+    uint32_t locale;         //string pool offset
+    uint32_t entriesOffset;
+    uint32_t stringsOffset;
+    uint32_t stringsSize;
+} QAssertMetaLocaleHeader;
+
+typedef struct {
+    uint32_t brief;          //string pool offsets, or QASSERT_META_LOCALE_NO_STRING
+    uint32_t tips;
+} QAssertMetaLocaleEntry;
+
+/**
+ * A translation of an internal table entry. NULL fields are not translated.
+ */
+typedef struct {
+    const char * module;
+    int id;
+    const char * brief;
+    const char * tips;
+} QAssertMetaTranslation;
+
+/**
+ * @return: the fingerprint of the keys of the internal table, in table order.
+ */
+uint32_t QAssertMetaLocaleKeyFingerprint(void);
+
+/**
+ * Write a localization pack of the internal table.
+ * @param locale:       the locale name, shorter than QASSERT_META_LOCALE_NAME_SIZE.
+ * @param translations: count translations. If a key is translated more than
+ *                      once, the first translation wins.
+ * @param unmatched:    if not NULL, the number of translations of keys not in the
+ *                      internal table (not written).
+ * @return: true if the pack was completely written.
+ */
+bool QAssertMetaLocaleWritePack(FILE * file, const char * locale, const QAssertMetaTranslation * translations,
+                                size_t count, size_t * unmatched);
+
+/**
+ * Register the pack of a locale, mapped by the first lookup with the locale.
+ * Not thread safe with lookups, register at startup.
+ * @param locale:  the locale name, such as "de" or "ja".
+ * @param path:    the pack file, copied.
+ * @return: true: registered. false: invalid arguments, locale already
+ *          registered or no room remaining.
+ */
+bool QAssertMetaLocaleRegister(const char * locale, const char * path);
+
+/**
+ * Unmap and remove all registered locales. Not thread safe with lookups.
+ */
+void QAssertMetaLocaleReset(void);
+
+/**
+ * @return: true if the pack of the locale is registered and mapped.
+ */
+bool QAssertMetaLocaleIsLoaded(const char * locale);
+
+/**
+ * Get a description of a Q_ASSERT in the given locale, as QAssertMetaGetDescription,
+ * with the brief and tips of internal table entries taken from the locale's pack.
+ * Fields the pack does not translate, and entries of other tables, are English.
+ * Entries with a link time override keep the application's override text.
+ * A locale "de_AT" or "de-AT" without a pack of its own uses the pack of "de".
+ * Thread safe; the pack is mapped by the first lookup to use it.
+ * @param locale:  the locale, NULL or a locale without a pack for English.
+ * @return: true:  assert identified and description provided.  false, this assert was not found.
+ */
+bool QAssertMetaGetLocalizedDescription(const char * locale, const char * module, int id,
+                                        QAssertMetaDescription * output);
+
+/**
+ * As QAssertMetaGetLocalizedDescription, with the module given as a slice
+ * of length bytes, see QAssertMetaGetDescriptionN.
+ */
+bool QAssertMetaGetLocalizedDescriptionN(const char * locale, const char * module, size_t length, int id,
+                                         QAssertMetaDescription * output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //QASSERT_META_QASSERT_META_LOCALE_H
@@ -0,0 +1,122 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_OUTPUT_H
+#define QASSERT_META_QASSERT_META_OUTPUT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Description output for test suites, which hit the same intentional
+ * asserts thousands of times. Each assert is counted per module/id in a
+ * fixed size seen set (a hash and a probe, no lookup of the description)
+ * and printed according to the policy: every time, once, or in full once
+ * then as a one line brief, optionally rate limited by a token bucket.
+ * A summary of the counts per assert may be written at the end of the run.
+ *
+ * Not thread safe: call from the test runner's thread, or serialize.
+ */
+
+//module/id pairs counted, others are printed as if first seen
+#ifndef QASSERT_META_OUTPUT_MAX_KEYS
+#define QASSERT_META_OUTPUT_MAX_KEYS 128
+#endif
+
+//longer module names are kept truncated, and distinguished by their hash.
+//The summary then uses the module as passed to QAssertMetaOutputAssert.
+#ifndef QASSERT_META_OUTPUT_MODULE_SIZE
+#define QASSERT_META_OUTPUT_MODULE_SIZE 32
+#endif
+
+//longer lines are truncated
+#ifndef QASSERT_META_OUTPUT_LINE_SIZE
+#define QASSERT_META_OUTPUT_LINE_SIZE 256
+#endif
+
+typedef enum {
+    QASSERT_META_OUTPUT_EVERY_TIME,        //the full description for every assert
+    QASSERT_META_OUTPUT_ONCE,              //the full description the first time, then nothing
+    QASSERT_META_OUTPUT_BRIEF_AFTER_FIRST  //the full description the first time, then one line
+} QAssertMetaOutputMode;
+
+//receives one NUL terminated line of output, without a line ending.
+typedef void (*QAssertMetaOutputLineWriter)(const char * line, void * context);
+
+typedef struct {
+    QAssertMetaOutputMode mode;
+    uint32_t burst;               //token bucket size, in asserts printed. 0: not rate limited
+    uint32_t perSecond;           //tokens added per second
+    uint32_t (*clockMs)(void);    //NULL: a monotonic clock, if the platform has one
+    QAssertMetaOutputLineWriter writer;
+    void * context;
+} QAssertMetaOutputPolicy;
+
+typedef struct {
+    uint32_t asserts;
+    uint32_t printedFull;
+    uint32_t printedBrief;
+    uint32_t repeatsSuppressed; //by the mode
+    uint32_t rateLimited;       //by the token bucket
+    uint32_t distinct;          //module/id pairs in the seen set
+    uint32_t untracked;         //asserts of pairs not fitting in the seen set
+} QAssertMetaOutputCounters;
+
+/**
+ * Set the output policy, clearing the seen set and counters.
+ * @param policy: NULL disables output.
+ */
+void QAssertMetaOutputSetPolicy(const QAssertMetaOutputPolicy * policy);
+
+/**
+ * Count an assert and print its description according to the policy,
+ * for example from Q_onError of a test build.
+ * @param module: a module of QASSERT_META_OUTPUT_MODULE_SIZE characters or
+ *                more must remain valid until the summary, as QP's static
+ *                module names do.
+ * @return: true if anything was written.
+ */
+bool QAssertMetaOutputAssert(const char * module, int id);
+
+/**
+ * Write the number of times each module/id was counted, most frequent
+ * first, with its brief description.
+ */
+void QAssertMetaOutputSummary(void);
+
+void QAssertMetaOutputGetCounters(QAssertMetaOutputCounters * counters);
+
+/**
+ * Clear the seen set and counters, keeping the policy.
+ */
+void QAssertMetaOutputReset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //QASSERT_META_QASSERT_META_OUTPUT_H
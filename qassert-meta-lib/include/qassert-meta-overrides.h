@@ -0,0 +1,119 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_OVERRIDES_H
+#define QASSERT_META_QASSERT_META_OVERRIDES_H
+
+#include "qassert-meta.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Link time customization of the descriptions, with no registration and
+ * no callback.
+ *
+ * Each module of the internal QP table has an empty override table, a weak
+ * definition generated at build time. An application replaces descriptions
+ * of that module by defining the table in its own sources:
+ *
+ *     QASSERT_META_MODULE_OVERRIDE(qf_actq) = {
+ *         {"qf_actq", 190, {"Event queue of my AO is full", NULL, NULL}},
+ *         {NULL, -1, {NULL, NULL, NULL}}
+ *     };
+ *
+ * The override of an internal table hit is found via the module of the hit,
+ * so modules without overrides cost one extra load and compare. Overrides
+ * only apply to ids of the internal table; other items belong in the
+ * application table.
+ *
+ * Application modules are added by defining the application table, which
+ * is searched after the internal table and before registered tables:
+ *
+ *     static const QAssertMetaItem m_app_items[] = {...};
+ *     QASSERT_META_APPLICATION_TABLE(m_app_items);
+ *
+ * Its index is built in static storage sized by the macro, once, by the
+ * first lookup reaching the table. If a module/id pair is duplicated in
+ * either kind of table, the first occurrence wins.
+ *
+ * Definitions must be linked as objects of the application: the linker does
+ * not pull an override out of a static library, as nothing references it.
+ */
+
+#ifndef QASSERT_META_WEAK
+#if defined(__GNUC__) || defined(__clang__)
+#define QASSERT_META_WEAK __attribute__((weak))
+#elif defined(__ICCARM__)
+#define QASSERT_META_WEAK __weak
+#else
+#error "provide QASSERT_META_WEAK, the weak linkage attribute of this compiler"
+#endif
+#endif
+
+#ifdef __cplusplus
+#define QASSERT_META_OVERRIDE_LINKAGE extern "C"
+#else
+#define QASSERT_META_OVERRIDE_LINKAGE extern
+#endif
+
+/**
+ * Define the override table of an internal table module, a table of
+ * QAssertMetaItem terminated by an item with a NULL module. The module
+ * is given as an identifier, characters invalid in identifiers (and a
+ * leading digit) are '_': module "qf-act" is QASSERT_META_MODULE_OVERRIDE(qf_act).
+ * qassert-meta-gen fails on a table with modules differing only in such
+ * characters, such as "qf-act" and "qf_act", as they share an identifier.
+ */
+#define QASSERT_META_MODULE_OVERRIDE(module) \
+    QASSERT_META_OVERRIDE_LINKAGE const QAssertMetaItem qassert_meta_override_##module[]; \
+    const QAssertMetaItem qassert_meta_override_##module[]
+
+typedef struct {
+    const QAssertMetaItem * items; //NULL if the application defines no table
+    void * indexStorage;
+    size_t storageSize;
+} QAssertMetaApplicationTable;
+
+//weak default without items, see QASSERT_META_APPLICATION_TABLE.
+extern const QAssertMetaApplicationTable qassert_meta_application_table;
+
+/**
+ * Define the application table as the given array (not a pointer) of
+ * QAssertMetaItem, terminated by an item with a NULL module, along with
+ * storage for its index (32 bytes per item).
+ */
+#define QASSERT_META_APPLICATION_TABLE(items) \
+    static uint32_t qassert_meta_application_index_[8u * (sizeof(items) / sizeof((items)[0]))]; \
+    QASSERT_META_OVERRIDE_LINKAGE const QAssertMetaApplicationTable qassert_meta_application_table; \
+    const QAssertMetaApplicationTable qassert_meta_application_table = { \
+        (items), qassert_meta_application_index_, sizeof(qassert_meta_application_index_) \
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //QASSERT_META_QASSERT_META_OVERRIDES_H
@@ -0,0 +1,154 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_RECORDER_H
+#define QASSERT_META_QASSERT_META_RECORDER_H
+
+#include "qassert-meta.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Persistent assert recording, for Q_onError handlers with no time to print.
+ *
+ * Asserts are recorded into a ring buffer in RAM which is not initialized
+ * at startup (the .noinit section), so the records survive a watchdog or
+ * software reset. Recording costs a short hash of the module name and a few
+ * stores. After the reset, the records are validated and described:
+ *
+ *     QASSERT_META_RECORDER_STORAGE(m_assert_records, 16);
+ *
+ *     void Q_onError(char const * module, int_t id) {
+ *         QAssertMetaRecordAssert(module, id, DWT->CYCCNT, 0,
+ *                                 (uint32_t)(uintptr_t)__builtin_return_address(0));
+ *         NVIC_SystemReset();
+ *     }
+ *
+ *     int main(void) {
+ *         if (QAssertMetaRecorderInit(m_assert_records, sizeof(m_assert_records)) > 0) {
+ *             ...QAssertMetaRecorderRead, QAssertMetaRecorderDescribe, QAssertMetaRecorderClear
+ *         }
+ *     }
+ *
+ * The linker script must place .noinit outside of the RAM zeroed or
+ * initialized at startup.
+ */
+
+//places data in RAM not initialized at startup. Other toolchains must
+//define it, before QASSERT_META_RECORDER_STORAGE can be used.
+#ifndef QASSERT_META_NOINIT
+#if defined(__GNUC__) || defined(__clang__)
+#define QASSERT_META_NOINIT __attribute__((section(".noinit")))
+#elif defined(__ICCARM__)
+#define QASSERT_META_NOINIT __no_init
+#endif
+#endif
+
+/**
+ * A recorded assert. Addresses are the low 32 bits, as on 32 bit targets.
+ */
+typedef struct {
+    uint16_t module;    //QAssertMetaRecorderModuleCode of the module
+    uint16_t check;     //of the other fields, so a record torn by a reset is ignored
+    int32_t id;
+    uint32_t sequence;  //records written before this one, since the buffer was cleared
+    uint32_t timestamp; //as given, for example a cycle or tick counter
+    uint32_t pc;        //as given, 0 if not known
+    uint32_t lr;
+} QAssertMetaRecord;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t capacity;  //records following the header
+    uint32_t next;      //sequence of the next record
+    uint32_t check;     //of magic and capacity
+} QAssertMetaRecorderHeader;
+
+//bytes of storage for a buffer of capacity records
+#define QASSERT_META_RECORDER_SIZE(capacity) \
+    (sizeof(QAssertMetaRecorderHeader) + ((capacity) * sizeof(QAssertMetaRecord)))
+
+//define static, uninitialized storage for a buffer of capacity records
+#if defined(QASSERT_META_NOINIT)
+#define QASSERT_META_RECORDER_STORAGE(name, capacity) \
+    QASSERT_META_NOINIT static uint32_t name[QASSERT_META_RECORDER_SIZE(capacity) / sizeof(uint32_t)]
+#else
+//a compile error naming the fix, only where storage is defined
+#define QASSERT_META_RECORDER_STORAGE(name, capacity) \
+    typedef char QASSERT_META_NOINIT_must_be_defined_for_this_toolchain_##name[-1]
+#endif
+
+/**
+ * Attach the recorder to its storage, at startup. Records of a previous run
+ * are kept if the buffer is valid, otherwise (such as at power up, when the
+ * RAM holds noise) it is cleared.
+ * @param storage: 4 byte aligned, not initialized at startup. NULL detaches.
+ * @param size:    of storage in bytes, see QASSERT_META_RECORDER_SIZE.
+ * @return: the number of valid records kept from the previous run.
+ */
+size_t QAssertMetaRecorderInit(void * storage, size_t size);
+
+/**
+ * Record an assert, overwriting the oldest record once the buffer is full.
+ * Does nothing if no storage is attached. Not reentrant: for the fatal
+ * error handler, or callers serialized by the application.
+ * @param module:    the module string of the assert.
+ * @param timestamp: any time base, for example a cycle or tick counter.
+ * @param pc, lr:    optional program counter and return address, 0 if unknown.
+ */
+void QAssertMetaRecordAssert(const char * module, int id, uint32_t timestamp, uint32_t pc, uint32_t lr);
+
+/**
+ * Copy the valid records, oldest first, skipping any torn by a reset.
+ * @return: the number of records copied, at most max.
+ */
+size_t QAssertMetaRecorderRead(QAssertMetaRecord * output, size_t max);
+
+/**
+ * Remove all records, for example once reported.
+ */
+void QAssertMetaRecorderClear(void);
+
+/**
+ * Resolve a record to its module, by the module code and id, among the
+ * internal, application and registered tables, then describe it with
+ * QAssertMetaGetDescription.
+ * @param module: set to the module name, NULL if not resolved.
+ * @return: true if resolved and described.
+ */
+bool QAssertMetaRecorderDescribe(const QAssertMetaRecord * record, const char ** module,
+                                 QAssertMetaDescription * output);
+
+/**
+ * The compact code recorded for a module name, a 16 bit hash.
+ */
+uint16_t QAssertMetaRecorderModuleCode(const char * module);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //QASSERT_META_QASSERT_META_RECORDER_H
@@ -0,0 +1,67 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_SEARCH_H
+#define QASSERT_META_QASSERT_META_SEARCH_H
+
+#include "qassert-meta.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *   A search result, an internal QP table or application table item, and
+ *   its relevance.
+ */
+typedef struct {
+    const QAssertMetaItem * item;
+    unsigned matchedTerms; //number of distinct query terms found in the item
+    unsigned score;        //weighted occurrences of the matched terms
+} QAssertMetaSearchResult;
+
+/**
+ * Search the brief and tips text of the internal QP table for a symptom,
+ * for example "queue full" or "memory corruption". Items are searched as
+ * QAssertMetaGetDescription finds them, that is with their link time
+ * overrides, followed by the application table. Registered tables are
+ * not searched.
+ *
+ * Uses an inverted index generated at build time, so queries only tokenize
+ * the text of overrides and the application table. Query terms are case
+ * insensitive, and also match longer words with the same prefix at a lower
+ * score ("corrupt" finds "corruption"). Results are ranked by the number of
+ * matched terms, then score, then table order. Does not allocate.
+ *
+ * @param query:      the search text.
+ * @param results:    output array for the best results.
+ * @param maxResults: capacity of results.
+ * @return: the number of results written.
+ */
+size_t QAssertMetaSearch(const char * query, QAssertMetaSearchResult * results, size_t maxResults);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //QASSERT_META_QASSERT_META_SEARCH_H
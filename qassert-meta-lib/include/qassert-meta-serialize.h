@@ -0,0 +1,143 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_SERIALIZE_H
+#define QASSERT_META_QASSERT_META_SERIALIZE_H
+
+#include "qassert-meta.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Streaming JSON and CBOR serialization of assert descriptions, into a
+ * caller provided buffer. When the buffer fills it is handed to a flush
+ * function (or written to a file descriptor) and reused, so tables of any
+ * size are exported through a fixed buffer. Never allocates.
+ *
+ * Each entry is a map of "module", "id", "brief", "tips" and "url", the
+ * latter three omitted when NULL. JSON strings are escaped per RFC 8259,
+ * non-ASCII bytes are written as is (the tables are UTF-8). The escaped
+ * JSON of the internal table entries is generated at build time, so
+ * exporting them is a copy. CBOR (RFC 8949) uses definite length text
+ * strings and integers, and indefinite length arrays.
+ *
+ * Entries written outside of an array are separate JSON texts, one per
+ * line (JSON Lines), or a CBOR sequence (RFC 8742).
+ *
+ * A serializer is not thread safe, use one per thread.
+ */
+
+typedef enum {
+    QASSERT_META_SERIALIZE_JSON,
+    QASSERT_META_SERIALIZE_CBOR
+} QAssertMetaSerializeFormat;
+
+//receives the next size bytes of output. return false to stop serialization (such as on a write error).
+typedef bool (*QAssertMetaSerializeFlush)(const uint8_t * data, size_t size, void * context);
+
+//the serializer state, see QAssertMetaSerializerInit. Fields are private.
+typedef struct {
+    QAssertMetaSerializeFormat format;
+    uint8_t * buffer;
+    size_t size;
+    size_t used;
+    QAssertMetaSerializeFlush flush;
+    void * context;
+    int fd;
+    uint64_t flushed;   //bytes handed to flush
+    uint32_t entries;   //entries written
+    bool inArray;
+    bool arrayEmpty;
+    bool truncated;     //without flush, an entry did not fit
+    bool failed;
+} QAssertMetaSerializer;
+
+/**
+ * Initialize a serializer writing into buffer.
+ * @param flush:  receives the buffer's contents when it fills, and on
+ *                QAssertMetaSerializeFinish. NULL: the output must fit in
+ *                the buffer. An entry that does not fit is not written, nor
+ *                are the entries after it, but room is kept to end an open
+ *                array, so the buffer holds valid (if incomplete) output.
+ */
+void QAssertMetaSerializerInit(QAssertMetaSerializer * serializer, QAssertMetaSerializeFormat format,
+                               void * buffer, size_t size, QAssertMetaSerializeFlush flush, void * context);
+
+#if defined(__unix__) || defined(__APPLE__)
+/**
+ * Initialize a serializer writing to a file descriptor through buffer,
+ * retrying interrupted and partial writes.
+ */
+void QAssertMetaSerializerInitFd(QAssertMetaSerializer * serializer, QAssertMetaSerializeFormat format,
+                                 void * buffer, size_t size, int fd);
+#endif
+
+/**
+ * Start an array, the following entries are its elements until
+ * QAssertMetaSerializeEndArray. Arrays do not nest. An array started is
+ * ended, even after entries that did not fit.
+ */
+bool QAssertMetaSerializeBeginArray(QAssertMetaSerializer * serializer);
+bool QAssertMetaSerializeEndArray(QAssertMetaSerializer * serializer);
+
+/**
+ * Write one entry.
+ * @return: false if the serializer has failed, or an entry did not fit (now or before).
+ */
+bool QAssertMetaSerializeEntry(QAssertMetaSerializer * serializer, const char * module, int id,
+                               const QAssertMetaDescription * description);
+
+/**
+ * Write count items of a table, stopping early at an item with a NULL module.
+ * Pass SIZE_MAX to write a whole terminated table.
+ */
+bool QAssertMetaSerializeItems(QAssertMetaSerializer * serializer, const QAssertMetaItem * items, size_t count);
+
+/**
+ * Write every entry the library knows, in lookup order: the internal table
+ * (with link time overrides applied), the application table, then each
+ * registered table. A pair duplicated across tables is written each time,
+ * the first being the one looked up.
+ */
+bool QAssertMetaSerializeAll(QAssertMetaSerializer * serializer);
+
+/**
+ * Flush the remaining output.
+ * @return: true if all output was written, false also if an entry did not fit.
+ */
+bool QAssertMetaSerializeFinish(QAssertMetaSerializer * serializer);
+
+/**
+ * @return: the number of bytes of output so far, flushed or in the buffer.
+ */
+uint64_t QAssertMetaSerializedBytes(const QAssertMetaSerializer * serializer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //QASSERT_META_QASSERT_META_SERIALIZE_H
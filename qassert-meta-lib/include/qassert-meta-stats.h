@@ -0,0 +1,85 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_STATS_H
+#define QASSERT_META_QASSERT_META_STATS_H
+
+#include "qassert-meta.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Lookup statistics, for finding which asserts test suites or a fleet
+ * actually trigger. Only collected when the library is built with
+ * QASSERT_META_ENABLE_STATS=1 (cmake option CMS_QASSERT_META_ENABLE_STATS),
+ * otherwise the lookup path contains no statistics code at all.
+ *
+ * Counters are relaxed atomics, updated and read without locks. They are
+ * not cleared by QAssertMetaInit(), so they accumulate across test cases.
+ */
+#ifndef QASSERT_META_ENABLE_STATS
+#define QASSERT_META_ENABLE_STATS 0
+#endif
+
+typedef struct {
+    uint32_t lookups;               //calls of QAssertMetaGetDescription
+    uint32_t nullArgumentRejections;
+    uint32_t builtinHits;           //found in the internal QP table, including link time overrides
+    uint32_t applicationHits;       //found in the link time application table
+    uint32_t registeredHits;        //found in a registered table
+    uint32_t unknownCallbackCalls;
+    uint32_t unknownCallbackHits;
+    uint32_t misses;                //not found, including by the callback
+    uint32_t registeredTableHits[QASSERT_META_MAX_REGISTERED_TABLES]; //by registration order
+} QAssertMetaStatsCounters;
+
+//visitor of an internal QP table entry's hit count, return false to stop.
+typedef bool (*QAssertMetaStatsEntryVisitor)(const QAssertMetaItem * item, uint32_t hits, void * context);
+
+/**
+ * Snapshot the lookup counters. Each counter is read atomically, the set is
+ * not a single atomic snapshot while lookups are in progress.
+ * @return: false if statistics are not enabled in this build.
+ */
+bool QAssertMetaStatsGetCounters(QAssertMetaStatsCounters * counters);
+
+/**
+ * Visit the internal QP table entries which have been hit at least once,
+ * in table order, with their hit counts.
+ * @return: the number of entries visited.
+ */
+size_t QAssertMetaStatsForEachEntry(QAssertMetaStatsEntryVisitor visitor, void * context);
+
+/**
+ * Zero all counters.
+ */
+void QAssertMetaStatsReset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //QASSERT_META_QASSERT_META_STATS_H
@@ -24,6 +24,7 @@
 #define QASSERT_META_QASSERT_META_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -38,12 +39,90 @@ typedef struct {
     const char * url;   //a URL for more, if available.
 } QAssertMetaDescription;
 
+/**
+ *   Source location of a QASSERT, in the QP sources the tables were built from.
+ */
+typedef struct {
+    const char * file;     //relative to the QP source root
+    unsigned line;
+    const char * function; //enclosing function, NULL if unknown
+} QAssertMetaLocation;
+
+/**
+ *   QASSERT Meta item, a module/id pair and its description.
+ *   Tables of items are terminated by an item with a NULL module.
+ */
+typedef struct {
+    const char * module;
+    int id;
+    QAssertMetaDescription description;
+} QAssertMetaItem;
+
+//maximum number of tables that may be registered via QAssertMetaRegisterTable
+#ifndef QASSERT_META_MAX_REGISTERED_TABLES
+#define QASSERT_META_MAX_REGISTERED_TABLES 8
+#endif
+
 //typedef for a callback that may be used to extend this module
 //to provide Meta for application or other QASSERT sources
 typedef bool (*UnknownQAssertCallback)(const char * module, int id, QAssertMetaDescription* output);
 
 /**
- * Initialize the QAssertMeta module.
+ * Caller owned scratch memory, for descriptions generated by an unknown
+ * context callback. Strings are allocated from it in turn and released
+ * together by QAssertMetaArenaReset. Never allocates from the heap.
+ * An arena must not be used by two threads at once; give each its own.
+ */
+typedef struct {
+    char * buffer;
+    size_t size;
+    size_t used;
+    bool exhausted; //an allocation did not fit since the last reset
+} QAssertMetaArena;
+
+/**
+ *   Context of a lookup, given to an unknown context callback.
+ */
+typedef struct {
+    QAssertMetaArena * arena; //NULL if the caller provided none
+    void * userData;          //as given by the caller
+} QAssertMetaLookupContext;
+
+//typedef for a callback as UnknownQAssertCallback, that may generate the
+//description's strings in the context's arena. They remain valid until the
+//caller resets the arena.
+typedef bool (*UnknownQAssertContextCallback)(const char * module, int id, QAssertMetaLookupContext * context,
+                                              QAssertMetaDescription* output);
+
+void QAssertMetaArenaInit(QAssertMetaArena * arena, void * buffer, size_t size);
+
+/**
+ * Release every string of the arena at once.
+ */
+void QAssertMetaArenaReset(QAssertMetaArena * arena);
+
+/**
+ * @return: size bytes of the arena (unaligned, for characters), or NULL if
+ *          the arena is NULL or full.
+ */
+char * QAssertMetaArenaAlloc(QAssertMetaArena * arena, size_t size);
+
+/**
+ * Format a string into the arena, as snprintf.
+ * @return: the string, or NULL if the arena is NULL or the string does not
+ *          fit, in which case nothing is allocated.
+ */
+const char * QAssertMetaArenaPrintf(QAssertMetaArena * arena, const char * format, ...)
+#if defined(__GNUC__) || defined(__clang__)
+    __attribute__((format(printf, 2, 3)))
+#endif
+    ;
+
+/**
+ * Initialize the QAssertMeta module, removing any callback and registered
+ * tables. Optional at startup: the built-in tables are prebuilt at compile
+ * time and the module is statically initialized, so lookups work before,
+ * or without, any call to this function.
  */
 void QAssertMetaInit(void);
 
@@ -54,6 +133,63 @@ void QAssertMetaInit(void);
  */
 void QAssertMetaRegisterUnknownCallback(UnknownQAssertCallback callback);
 
+/**
+ * Register a callback to be executed, before any UnknownQAssertCallback,
+ * if a module/id pair is found to be unknown. Lookups via
+ * QAssertMetaGetDescriptionWithContext pass their context; other lookups
+ * pass a context without an arena.
+ * @param callback:  the callback, NULL to remove it.
+ */
+void QAssertMetaRegisterUnknownContextCallback(UnknownQAssertContextCallback callback);
+
+/**
+ * Register an additional table of QASSERT meta items, for example
+ * application asserts. Registered tables are searched, in registration
+ * order, after the internal QP table and before the unknown callback.
+ * @param items:  the table, terminated by an item with a NULL module.
+ *                Must remain valid until the next QAssertMetaInit().
+ * @return: true: table registered. false: NULL table or no room remaining.
+ */
+bool QAssertMetaRegisterTable(const QAssertMetaItem * items);
+
+/**
+ * Bytes of index storage required by QAssertMetaRegisterIndexedTable
+ * for the given table.
+ * @param items:  the table, terminated by an item with a NULL module.
+ */
+size_t QAssertMetaIndexStorageSize(const QAssertMetaItem * items);
+
+/**
+ * Register an additional table, as QAssertMetaRegisterTable, along with
+ * caller provided storage for a hash index of the table. Lookups in the
+ * table then cost the same regardless of its size. The library does not
+ * allocate, and uses exactly QAssertMetaIndexStorageSize(items) bytes.
+ * The index is built once, by the first lookup reaching the table, so
+ * registration costs nothing if no assert fires. Concurrent lookups are
+ * safe; any racing with that build scan the table instead.
+ * If a module/id pair is duplicated in the table, the first occurrence wins.
+ * @param items:        the table, terminated by an item with a NULL module.
+ * @param indexStorage: 4 byte aligned storage, must remain valid with the table.
+ * @param storageSize:  size of indexStorage in bytes.
+ * @return: true: table registered. false: invalid arguments, insufficient storage
+ *                or no room remaining.
+ */
+bool QAssertMetaRegisterIndexedTable(const QAssertMetaItem * items, void * indexStorage, size_t storageSize);
+
+/**
+ *   Memory in use for registered tables.
+ */
+typedef struct {
+    size_t registeredTables;
+    size_t registeredItems;
+    size_t indexBytes;       //index storage in use, summed over all indexed tables
+} QAssertMetaFootprint;
+
+/**
+ * Report the memory in use for registered tables.
+ */
+void QAssertMetaGetFootprint(QAssertMetaFootprint * footprint);
+
 /**
  * Get a description of a Q_ASSERT based on the module and id.
  * @param module:  The module string provided with the Q_ASSERT
@@ -63,6 +199,51 @@ void QAssertMetaRegisterUnknownCallback(UnknownQAssertCallback callback);
  */
 bool QAssertMetaGetDescription(const char * module, int id, QAssertMetaDescription* output);
 
+/**
+ * Get a description of a Q_ASSERT, as QAssertMetaGetDescription, giving
+ * the unknown context callback a context, such as a per thread arena for
+ * generated strings. The description may point into the arena.
+ * @param context:  the lookup context, NULL for none.
+ */
+bool QAssertMetaGetDescriptionWithContext(const char * module, int id, QAssertMetaLookupContext * context,
+                                          QAssertMetaDescription* output);
+
+//size of the copy of a module slice given to the unknown callback, see QAssertMetaGetDescriptionN
+#ifndef QASSERT_META_CALLBACK_MODULE_SIZE
+#define QASSERT_META_CALLBACK_MODULE_SIZE 64
+#endif
+
+/**
+ * Get a description of a Q_ASSERT, as QAssertMetaGetDescription, with the
+ * module given as a slice of a larger buffer (such as a log record), which
+ * need not be NUL terminated. Hashing and comparison use the slice in place.
+ * The unknown callback, requiring a terminated module, is given a copy, and
+ * is not called for slices of QASSERT_META_CALLBACK_MODULE_SIZE bytes or more.
+ * @param module:  The module, length bytes, need not be terminated.
+ * @param length:  The length of the module in bytes.
+ * @param id:      The id value provided with the Q_ASSERT
+ * @param output:  a valid pointer. This structure will be filled in if the return is true.
+ * @return:  true:  assert identified and description provided.  false, this assert was not found.
+ */
+bool QAssertMetaGetDescriptionN(const char * module, size_t length, int id, QAssertMetaDescription* output);
+
+/**
+ * Get the source location of a Q_ASSERT of the internal table, available if
+ * the library was built with locations (qassert_meta_add_library LOCATIONS).
+ * Resolved through the same hash index as QAssertMetaGetDescription.
+ * @param module:  The module string provided with the Q_ASSERT
+ * @param id:      The id value provided with the Q_ASSERT
+ * @param output:  a valid pointer. This structure will be filled in if the return is true.
+ * @return:  true:  location known and provided.  false, no location for this assert.
+ */
+bool QAssertMetaGetLocation(const char * module, int id, QAssertMetaLocation * output);
+
+/**
+ * As QAssertMetaGetLocation, with the module given as a slice of length
+ * bytes, see QAssertMetaGetDescriptionN.
+ */
+bool QAssertMetaGetLocationN(const char * module, size_t length, int id, QAssertMetaLocation * output);
+
 #ifdef __cplusplus
 }
 #endif
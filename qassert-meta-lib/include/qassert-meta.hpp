@@ -0,0 +1,213 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_HPP
+#define QASSERT_META_QASSERT_META_HPP
+
+#include "qassert-meta.h"
+#include "qassert-meta-constexpr-items.hpp"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Header only C++ (C++14 or later) interface to the internal QP table.
+ *
+ * The table is emitted as constexpr data by qassert-meta-gen, so lookups
+ * with constant arguments are evaluated at compile time, and coverage
+ * checks may be static_asserts:
+ *
+ *     static_assert(qassert_meta::contains("qf_actq", 190), "undocumented assert");
+ *
+ * Runtime lookups binary search an index sorted at compile time. Only the
+ * internal table, as built, is covered: link time overrides (see
+ * qassert-meta-overrides.h) are not visible to constant evaluation, use
+ * describe_linked() for the text QAssertMetaGetDescription finds. The
+ * application table, registered tables and the unknown callback remain
+ * available through QAssertMetaGetDescription.
+ */
+namespace qassert_meta {
+
+struct Key {
+    const char * module;
+    int id;
+};
+
+namespace detail {
+
+constexpr std::size_t BUILTIN_ITEM_COUNT = sizeof(BuiltinTable<>::items) / sizeof(BuiltinTable<>::items[0]);
+
+constexpr const QAssertMetaItem & BuiltinItem(std::size_t i)
+{
+    return BuiltinTable<>::items[i];
+}
+
+//orders by module (as strcmp) then id
+constexpr int Compare(const char * module, int id, const QAssertMetaItem & item)
+{
+    std::size_t i = 0;
+    while ((module[i] != '\0') && (module[i] == item.module[i]))
+    {
+        ++i;
+    }
+
+    const unsigned char lhs = static_cast<unsigned char>(module[i]);
+    const unsigned char rhs = static_cast<unsigned char>(item.module[i]);
+    if (lhs != rhs)
+    {
+        return (lhs < rhs) ? -1 : 1;
+    }
+    return (id < item.id) ? -1 : ((id > item.id) ? 1 : 0);
+}
+
+struct SortedIndex {
+    std::uint16_t items[BUILTIN_ITEM_COUNT];
+};
+
+//stable, so the first of any duplicated pair sorts first, as with the C lookup
+constexpr SortedIndex SortBuiltinItems()
+{
+    SortedIndex index = {};
+    for (std::size_t i = 0; i < BUILTIN_ITEM_COUNT; ++i)
+    {
+        std::size_t j = i;
+        while ((j > 0) && (Compare(BuiltinItem(i).module, BuiltinItem(i).id, BuiltinItem(index.items[j - 1])) < 0))
+        {
+            index.items[j] = index.items[j - 1];
+            --j;
+        }
+        index.items[j] = static_cast<std::uint16_t>(i);
+    }
+    return index;
+}
+
+//one definition for all translation units, as BuiltinTable
+template <typename Unused = void>
+struct SortedBuiltinTable {
+    static constexpr SortedIndex index = SortBuiltinItems();
+};
+
+template <typename Unused>
+constexpr SortedIndex SortedBuiltinTable<Unused>::index;
+
+//the i-th item in module/id order
+constexpr const QAssertMetaItem & SortedBuiltinItem(std::size_t i)
+{
+    return BuiltinItem(SortedBuiltinTable<>::index.items[i]);
+}
+
+} // namespace detail
+
+/**
+ * @return: the number of items in the internal table.
+ */
+constexpr std::size_t item_count()
+{
+    return detail::BUILTIN_ITEM_COUNT;
+}
+
+/**
+ * @return: the internal table item for module/id, nullptr if unknown.
+ */
+constexpr const QAssertMetaItem * find(const char * module, int id)
+{
+    if (nullptr == module)
+    {
+        return nullptr;
+    }
+
+    std::size_t low = 0;
+    std::size_t high = detail::BUILTIN_ITEM_COUNT;
+    while (low < high)
+    {
+        const std::size_t middle = low + ((high - low) / 2);
+        if (detail::Compare(module, id, detail::SortedBuiltinItem(middle)) > 0)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    if ((low < detail::BUILTIN_ITEM_COUNT) &&
+        (0 == detail::Compare(module, id, detail::SortedBuiltinItem(low))))
+    {
+        return &detail::SortedBuiltinItem(low);
+    }
+    return nullptr;
+}
+
+/**
+ * @return: true if module/id is in the internal table.
+ */
+constexpr bool contains(const char * module, int id)
+{
+    return nullptr != find(module, id);
+}
+
+/**
+ * @return: true if every key is in the internal table.
+ */
+template <std::size_t N>
+constexpr bool contains_all(const Key (&keys)[N])
+{
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        if (!contains(keys[i].module, keys[i].id))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @return: the description of module/id in the internal table as built,
+ *          all members nullptr if unknown.
+ */
+constexpr QAssertMetaDescription describe(const char * module, int id)
+{
+    const QAssertMetaItem * item = find(module, id);
+    return (nullptr != item) ? item->description : QAssertMetaDescription{nullptr, nullptr, nullptr};
+}
+
+/**
+ * Runtime only: the description of an internal table module/id as looked
+ * up, that is with its link time override if any. All members nullptr if
+ * module/id is not in the internal table.
+ */
+inline QAssertMetaDescription describe_linked(const char * module, int id)
+{
+    QAssertMetaDescription description = {nullptr, nullptr, nullptr};
+    const QAssertMetaItem * item = find(module, id);
+    if (nullptr != item)
+    {
+        //the internal table is searched first, so this is the item or its override
+        (void)QAssertMetaGetDescription(item->module, item->id, &description);
+    }
+    return description;
+}
+
+} // namespace qassert_meta
+
+#endif //QASSERT_META_QASSERT_META_HPP
@@ -0,0 +1,94 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "qassert-meta.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+void QAssertMetaArenaInit(QAssertMetaArena * arena, void * buffer, size_t size)
+{
+    if (NULL == arena)
+    {
+        return;
+    }
+
+    arena->buffer = buffer;
+    arena->size = (NULL != buffer) ? size : 0;
+    arena->used = 0;
+    arena->exhausted = false;
+}
+
+void QAssertMetaArenaReset(QAssertMetaArena * arena)
+{
+    if (NULL != arena)
+    {
+        arena->used = 0;
+        arena->exhausted = false;
+    }
+}
+
+char * QAssertMetaArenaAlloc(QAssertMetaArena * arena, size_t size)
+{
+    if (NULL == arena)
+    {
+        return NULL;
+    }
+    if (size > (arena->size - arena->used))
+    {
+        arena->exhausted = true;
+        return NULL;
+    }
+
+    char * allocation = &arena->buffer[arena->used];
+    arena->used += size;
+    return allocation;
+}
+
+const char * QAssertMetaArenaPrintf(QAssertMetaArena * arena, const char * format, ...)
+{
+    if ((NULL == arena) || (NULL == format))
+    {
+        return NULL;
+    }
+
+    size_t room = arena->size - arena->used;
+    if (0 == room)
+    {
+        arena->exhausted = true;
+        return NULL;
+    }
+
+    //format straight into the free space, allocated only if it fits
+    char * text = &arena->buffer[arena->used];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(text, room, format, args);
+    va_end(args);
+    if ((length < 0) || ((size_t)length >= room))
+    {
+        arena->exhausted = true;
+        return NULL;
+    }
+
+    arena->used += (size_t)length + 1u;
+    return text;
+}
@@ -0,0 +1,522 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "qassert-meta-async.h"
+#include "qassert-meta-private.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#endif
+
+#define DEFAULT_WORKERS 2u
+#define DEFAULT_MAX_KEYS 64u
+#define DEFAULT_PENDING_PER_KEY 4u
+
+//a submission awaiting completion
+typedef struct Request {
+    QAssertMetaAsyncCompletion completion;
+    char * text;               //config.arenaSize bytes, for strings generated by a context callback
+    struct Request * next;
+} Request;
+
+//a module/id pair queued or running, and the submissions waiting for it
+typedef struct Key {
+    char module[QASSERT_META_CALLBACK_MODULE_SIZE];
+    int id;
+    uint32_t hash;
+    Request * waiters;
+    Request * lastWaiter;
+    struct Key * next;         //work queue, or free list
+    struct Key * nextInFlight;
+} Key;
+
+typedef struct {
+    QAssertMetaAsync * async;
+    QAssertMetaArena arena;
+} Worker;
+
+struct QAssertMetaAsync {
+    QAssertMetaAsyncConfig config;
+    pthread_mutex_t lock;
+    pthread_cond_t work;
+    pthread_t * threads;
+    Worker * workers;
+    size_t threadCount;
+    bool stopping;
+
+    Key * keys;
+    Key * freeKeys;
+    Key * queueHead;
+    Key * queueTail;
+    Key * inFlight;           //queued or running, for deduplication
+    Request * requests;
+    Request * freeRequests;
+    Request * doneHead;       //completions to poll
+    Request * doneTail;
+    Request * polled;         //taken by the last poll, freed by the next
+    char * text;              //arenas of the workers, then text of the requests
+
+    int readFd;
+    int writeFd;
+    bool signalled;           //readFd is readable
+
+    atomic_uint_fast64_t submitted;
+    atomic_uint_fast64_t completedInline;
+    atomic_uint_fast64_t deduplicated;
+    atomic_uint_fast64_t resolverCalls;
+    atomic_uint_fast64_t refused;
+};
+
+static void Count(atomic_uint_fast64_t * counter)
+{
+    atomic_fetch_add_explicit(counter, 1u, memory_order_relaxed);
+}
+
+static void Signal(QAssertMetaAsync * async)
+{
+    uint64_t one = 1u;
+#if defined(__linux__)
+    ssize_t size = sizeof(one); //eventfd, 8 byte counter
+#else
+    ssize_t size = 1;           //pipe
+#endif
+    while ((write(async->writeFd, &one, (size_t)size) < 0) && (EINTR == errno))
+    {
+    }
+    async->signalled = true;
+}
+
+static void ClearSignal(QAssertMetaAsync * async)
+{
+    uint64_t value;
+    while ((read(async->readFd, &value, sizeof(value)) < 0) && (EINTR == errno))
+    {
+    }
+    async->signalled = false;
+}
+
+static bool OpenSignal(QAssertMetaAsync * async)
+{
+#if defined(__linux__)
+    async->readFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    async->writeFd = async->readFd;
+    return async->readFd >= 0;
+#else
+    int fds[2];
+    if (0 != pipe(fds))
+    {
+        return false;
+    }
+    for (int i = 0; i < 2; ++i)
+    {
+        fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+        fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+    }
+    async->readFd = fds[0];
+    async->writeFd = fds[1];
+    return true;
+#endif
+}
+
+static void CloseSignal(QAssertMetaAsync * async)
+{
+    if (async->readFd >= 0)
+    {
+        close(async->readFd);
+    }
+    if ((async->writeFd >= 0) && (async->writeFd != async->readFd))
+    {
+        close(async->writeFd);
+    }
+}
+
+static void RemoveInFlight(QAssertMetaAsync * async, const Key * key)
+{
+    for (Key ** link = &async->inFlight; NULL != *link; link = &(*link)->nextInFlight)
+    {
+        if (*link == key)
+        {
+            *link = key->nextInFlight;
+            return;
+        }
+    }
+}
+
+//a string generated in arena, moved to the same offset of text
+static const char * Rebase(const QAssertMetaArena * arena, char * text, const char * string)
+{
+    bool generated = (NULL != string) && (string >= arena->buffer) && (string < (arena->buffer + arena->used));
+    return generated ? (text + (string - arena->buffer)) : string;
+}
+
+/**
+ * Complete the submissions waiting for a key, called with the lock held.
+ * Strings generated in the worker's arena are copied to each submission.
+ */
+static void Complete(QAssertMetaAsync * async, Key * key, bool found, const QAssertMetaDescription * description,
+                     const QAssertMetaArena * arena)
+{
+    RemoveInFlight(async, key);
+    Request * waiters = key->waiters;
+    Request * lastWaiter = key->lastWaiter;
+    key->next = async->freeKeys;
+    async->freeKeys = key;
+
+    for (Request * request = waiters; NULL != request; request = request->next)
+    {
+        request->completion.found = found;
+        request->completion.description = *description;
+        if (arena->used > 0)
+        {
+            memcpy(request->text, arena->buffer, arena->used);
+            request->completion.description.brief = Rebase(arena, request->text, description->brief);
+            request->completion.description.tips = Rebase(arena, request->text, description->tips);
+            request->completion.description.url = Rebase(arena, request->text, description->url);
+        }
+    }
+
+    if (NULL != async->config.callback)
+    {
+        //delivered without the lock, submissions may continue meanwhile
+        pthread_mutex_unlock(&async->lock);
+        for (Request * request = waiters; NULL != request; request = request->next)
+        {
+            async->config.callback(&request->completion, async->config.context);
+        }
+        pthread_mutex_lock(&async->lock);
+        lastWaiter->next = async->freeRequests;
+        async->freeRequests = waiters;
+        return;
+    }
+
+    if (NULL == async->doneHead)
+    {
+        async->doneHead = waiters;
+    }
+    else
+    {
+        async->doneTail->next = waiters;
+    }
+    async->doneTail = lastWaiter;
+    if (!async->signalled)
+    {
+        Signal(async);
+    }
+}
+
+static void * WorkerThread(void * argument)
+{
+    Worker * worker = argument;
+    QAssertMetaAsync * async = worker->async;
+    pthread_mutex_lock(&async->lock);
+    while (!async->stopping)
+    {
+        Key * key = async->queueHead;
+        if (NULL == key)
+        {
+            pthread_cond_wait(&async->work, &async->lock);
+            continue;
+        }
+        async->queueHead = key->next;
+        if (NULL == async->queueHead)
+        {
+            async->queueTail = NULL;
+        }
+        pthread_mutex_unlock(&async->lock);
+
+        //the key stays in flight during the call, so repeats join it
+        QAssertMetaDescription description = {NULL, NULL, NULL};
+        QAssertMetaArenaReset(&worker->arena);
+        QAssertMetaLookupContext context = {(worker->arena.size > 0) ? &worker->arena : NULL, NULL};
+        bool found = QAssertMetaPrivateCallUnknown(key->module, key->id, &context, &description);
+        Count(&async->resolverCalls);
+
+        pthread_mutex_lock(&async->lock);
+        if (!found)
+        {
+            description.brief = NULL;
+            description.tips = NULL;
+            description.url = NULL;
+            QAssertMetaArenaReset(&worker->arena);
+        }
+        Complete(async, key, found, &description, &worker->arena);
+    }
+    pthread_mutex_unlock(&async->lock);
+    return NULL;
+}
+
+static void Stop(QAssertMetaAsync * async)
+{
+    pthread_mutex_lock(&async->lock);
+    async->stopping = true;
+    pthread_cond_broadcast(&async->work);
+    pthread_mutex_unlock(&async->lock);
+    for (size_t i = 0; i < async->threadCount; ++i)
+    {
+        pthread_join(async->threads[i], NULL);
+    }
+    async->threadCount = 0;
+}
+
+static void Free(QAssertMetaAsync * async)
+{
+    CloseSignal(async);
+    pthread_cond_destroy(&async->work);
+    pthread_mutex_destroy(&async->lock);
+    free(async->threads);
+    free(async->workers);
+    free(async->keys);
+    free(async->requests);
+    free(async->text);
+    free(async);
+}
+
+QAssertMetaAsync * QAssertMetaAsyncCreate(const QAssertMetaAsyncConfig * config)
+{
+    QAssertMetaAsync * async = calloc(1, sizeof(QAssertMetaAsync));
+    if (NULL == async)
+    {
+        return NULL;
+    }
+
+    if (NULL != config)
+    {
+        async->config = *config;
+    }
+    if (0 == async->config.workers)
+    {
+        async->config.workers = DEFAULT_WORKERS;
+    }
+    if (0 == async->config.maxKeys)
+    {
+        async->config.maxKeys = DEFAULT_MAX_KEYS;
+    }
+    if (0 == async->config.maxPending)
+    {
+        async->config.maxPending = DEFAULT_PENDING_PER_KEY * async->config.maxKeys;
+    }
+
+    async->readFd = -1;
+    async->writeFd = -1;
+    pthread_mutex_init(&async->lock, NULL);
+    pthread_cond_init(&async->work, NULL);
+    size_t arenaSize = async->config.arenaSize;
+    async->threads = calloc(async->config.workers, sizeof(pthread_t));
+    async->workers = calloc(async->config.workers, sizeof(Worker));
+    async->keys = calloc(async->config.maxKeys, sizeof(Key));
+    async->requests = calloc(async->config.maxPending, sizeof(Request));
+    async->text = (arenaSize > 0) ? malloc((async->config.workers + async->config.maxPending) * arenaSize) : NULL;
+    if ((NULL == async->threads) || (NULL == async->workers) || (NULL == async->keys) ||
+        (NULL == async->requests) || ((arenaSize > 0) && (NULL == async->text)) || !OpenSignal(async))
+    {
+        Free(async);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < async->config.workers; ++i)
+    {
+        async->workers[i].async = async;
+        QAssertMetaArenaInit(&async->workers[i].arena, (arenaSize > 0) ? (async->text + (i * arenaSize)) : NULL,
+                             arenaSize);
+    }
+
+    for (size_t i = 0; i < async->config.maxKeys; ++i)
+    {
+        async->keys[i].next = async->freeKeys;
+        async->freeKeys = &async->keys[i];
+    }
+    for (size_t i = 0; i < async->config.maxPending; ++i)
+    {
+        async->requests[i].text =
+            (arenaSize > 0) ? (async->text + ((async->config.workers + i) * arenaSize)) : NULL;
+        async->requests[i].next = async->freeRequests;
+        async->freeRequests = &async->requests[i];
+    }
+
+    for (size_t i = 0; i < async->config.workers; ++i)
+    {
+        if (0 != pthread_create(&async->threads[i], NULL, WorkerThread, &async->workers[i]))
+        {
+            Stop(async);
+            Free(async);
+            return NULL;
+        }
+        ++async->threadCount;
+    }
+    return async;
+}
+
+void QAssertMetaAsyncDestroy(QAssertMetaAsync * async)
+{
+    if (NULL != async)
+    {
+        Stop(async);
+        Free(async);
+    }
+}
+
+QAssertMetaAsyncStatus QAssertMetaAsyncSubmit(QAssertMetaAsync * async, const char * module, int id,
+                                              QAssertMetaDescription * output, void * userData)
+{
+    if ((NULL == async) || (NULL == module) || (NULL == output))
+    {
+        return QASSERT_META_ASYNC_NOT_FOUND;
+    }
+
+    Count(&async->submitted);
+    size_t length = strlen(module);
+    if (QAssertMetaPrivateSearchTables(module, length, id, output))
+    {
+        Count(&async->completedInline);
+        return QASSERT_META_ASYNC_FOUND;
+    }
+    if ((!QAssertMetaPrivateHasUnknownCallback()) || (length >= QASSERT_META_CALLBACK_MODULE_SIZE))
+    {
+        Count(&async->completedInline);
+        return QASSERT_META_ASYNC_NOT_FOUND;
+    }
+
+    uint32_t hash = QAssertMetaPrivateHash(module, length, id);
+    pthread_mutex_lock(&async->lock);
+    Key * key = async->inFlight;
+    while ((NULL != key) && ((key->hash != hash) || (key->id != id) || (0 != strcmp(key->module, module))))
+    {
+        key = key->nextInFlight;
+    }
+
+    Request * request = async->freeRequests;
+    if ((NULL == request) || ((NULL == key) && (NULL == async->freeKeys)) || async->stopping)
+    {
+        pthread_mutex_unlock(&async->lock);
+        Count(&async->refused);
+        return QASSERT_META_ASYNC_FULL;
+    }
+
+    if (NULL != key)
+    {
+        Count(&async->deduplicated);
+    }
+    else
+    {
+        key = async->freeKeys;
+        async->freeKeys = key->next;
+        memcpy(key->module, module, length + 1u);
+        key->id = id;
+        key->hash = hash;
+        key->waiters = NULL;
+        key->lastWaiter = NULL;
+        key->next = NULL;
+        key->nextInFlight = async->inFlight;
+        async->inFlight = key;
+        if (NULL == async->queueTail)
+        {
+            async->queueHead = key;
+        }
+        else
+        {
+            async->queueTail->next = key;
+        }
+        async->queueTail = key;
+        pthread_cond_signal(&async->work);
+    }
+
+    async->freeRequests = request->next;
+    memcpy(request->completion.module, module, length + 1u);
+    request->completion.id = id;
+    request->completion.found = false;
+    request->completion.userData = userData;
+    request->next = NULL;
+    if (NULL == key->lastWaiter)
+    {
+        key->waiters = request;
+    }
+    else
+    {
+        key->lastWaiter->next = request;
+    }
+    key->lastWaiter = request;
+    pthread_mutex_unlock(&async->lock);
+    return QASSERT_META_ASYNC_PENDING;
+}
+
+int QAssertMetaAsyncFd(const QAssertMetaAsync * async)
+{
+    return (NULL != async) ? async->readFd : -1;
+}
+
+size_t QAssertMetaAsyncPoll(QAssertMetaAsync * async, QAssertMetaAsyncCompletion * completions, size_t max)
+{
+    if ((NULL == async) || (NULL == completions))
+    {
+        return 0;
+    }
+
+    size_t count = 0;
+    pthread_mutex_lock(&async->lock);
+    while (NULL != async->polled)
+    {
+        Request * request = async->polled;
+        async->polled = request->next;
+        request->next = async->freeRequests;
+        async->freeRequests = request;
+    }
+
+    //kept until the next poll, as completions may point to their text
+    while ((count < max) && (NULL != async->doneHead))
+    {
+        Request * request = async->doneHead;
+        completions[count++] = request->completion;
+        async->doneHead = request->next;
+        request->next = async->polled;
+        async->polled = request;
+    }
+    if (NULL == async->doneHead)
+    {
+        async->doneTail = NULL;
+        if (async->signalled)
+        {
+            ClearSignal(async);
+        }
+    }
+    pthread_mutex_unlock(&async->lock);
+    return count;
+}
+
+void QAssertMetaAsyncGetStats(QAssertMetaAsync * async, QAssertMetaAsyncStats * stats)
+{
+    if ((NULL == async) || (NULL == stats))
+    {
+        return;
+    }
+
+    stats->submitted = atomic_load_explicit(&async->submitted, memory_order_relaxed);
+    stats->completedInline = atomic_load_explicit(&async->completedInline, memory_order_relaxed);
+    stats->deduplicated = atomic_load_explicit(&async->deduplicated, memory_order_relaxed);
+    stats->resolverCalls = atomic_load_explicit(&async->resolverCalls, memory_order_relaxed);
+    stats->refused = atomic_load_explicit(&async->refused, memory_order_relaxed);
+}
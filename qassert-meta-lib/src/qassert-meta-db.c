@@ -0,0 +1,499 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "qassert-meta-db.h"
+#include "qassert-meta-overrides.h"
+#include "qassert-meta-private.h"
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const QAssertMetaDb * m_installed_db = NULL;
+
+static uint32_t ReadU32(const uint8_t * p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void WriteU32(uint8_t * p, uint32_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+#define HEADER_FIELD(image, field) ReadU32((image) + offsetof(QAssertMetaDbHeader, field))
+#define ENTRY_FIELD(entry, field)  ReadU32((entry) + offsetof(QAssertMetaDbEntry, field))
+
+static uint32_t Align4(uint32_t value)
+{
+    return (value + 3u) & ~3u;
+}
+
+// ---------------------------------------------------------------------
+// writer
+
+typedef struct {
+    const QAssertMetaItem * item;
+    uint32_t hash;
+} WriterEntry;
+
+typedef struct {
+    WriterEntry * entries;
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t * slots;      //dedup of module/id, entry index + 1
+    uint32_t slotCount;
+    uint8_t * strings;
+    uint32_t stringsSize;
+    uint32_t stringsCapacity;
+    uint32_t * stringSlots; //dedup of strings, offset + 1
+    uint32_t stringSlotCount;
+} Writer;
+
+static uint32_t HashString(const char * str)
+{
+    return QAssertMetaPrivateHash(str, strlen(str), 0);
+}
+
+static uint32_t SlotCountFor(uint32_t count)
+{
+    uint32_t slots = 16;
+    while (slots < (count * 2u))
+    {
+        slots *= 2u;
+    }
+    return slots;
+}
+
+static bool WriterAddItem(Writer * writer, const QAssertMetaItem * item)
+{
+    uint32_t hash = QAssertMetaPrivateHash(item->module, strlen(item->module), item->id);
+    uint32_t mask = writer->slotCount - 1u;
+    uint32_t slot = hash & mask;
+    while (writer->slots[slot] != 0)
+    {
+        const WriterEntry * existing = &writer->entries[writer->slots[slot] - 1u];
+        if ((existing->hash == hash) && (existing->item->id == item->id) &&
+            (0 == strcmp(existing->item->module, item->module)))
+        {
+            return true; //first occurrence wins
+        }
+        slot = (slot + 1u) & mask;
+    }
+
+    if (writer->count == writer->capacity)
+    {
+        return false;
+    }
+    writer->entries[writer->count].item = item;
+    writer->entries[writer->count].hash = hash;
+    ++writer->count;
+    writer->slots[slot] = writer->count;
+    return true;
+}
+
+static uint32_t WriterAddString(Writer * writer, const char * str)
+{
+    if (NULL == str)
+    {
+        return QASSERT_META_DB_NO_STRING;
+    }
+
+    uint32_t mask = writer->stringSlotCount - 1u;
+    uint32_t slot = HashString(str) & mask;
+    while (writer->stringSlots[slot] != 0)
+    {
+        uint32_t offset = writer->stringSlots[slot] - 1u;
+        if (0 == strcmp((const char *)&writer->strings[offset], str))
+        {
+            return offset;
+        }
+        slot = (slot + 1u) & mask;
+    }
+
+    size_t length = strlen(str) + 1u;
+    while ((writer->stringsSize + length) > writer->stringsCapacity)
+    {
+        uint32_t capacity = (writer->stringsCapacity == 0) ? 4096u : (writer->stringsCapacity * 2u);
+        uint8_t * strings = realloc(writer->strings, capacity);
+        if (NULL == strings)
+        {
+            return QASSERT_META_DB_NO_STRING;
+        }
+        writer->strings = strings;
+        writer->stringsCapacity = capacity;
+    }
+
+    uint32_t offset = writer->stringsSize;
+    memcpy(&writer->strings[offset], str, length);
+    writer->stringsSize += (uint32_t)length;
+    writer->stringSlots[slot] = offset + 1u;
+    return offset;
+}
+
+static uint32_t CountItems(const QAssertMetaItem * items)
+{
+    uint32_t count = 0;
+    while (items[count].module != NULL)
+    {
+        ++count;
+    }
+    return count;
+}
+
+static void WriterFree(Writer * writer)
+{
+    free(writer->entries);
+    free(writer->slots);
+    free(writer->strings);
+    free(writer->stringSlots);
+}
+
+static bool WriterAddItems(Writer * writer, const QAssertMetaItem * items)
+{
+    for (uint32_t i = 0; items[i].module != NULL; ++i)
+    {
+        if (!WriterAddItem(writer, &items[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//in lookup order, so the first of a duplicated pair is the one QAssertMetaGetDescription finds
+static bool WriterCollect(Writer * writer)
+{
+    const QAssertMetaItem * application = qassert_meta_application_table.items;
+    uint32_t total = CountItems(m_qassert_meta_items) + ((NULL != application) ? CountItems(application) : 0u);
+    for (size_t t = 0; t < QAssertMetaPrivateRegisteredTableCount(); ++t)
+    {
+        total += CountItems(QAssertMetaPrivateRegisteredTable(t));
+    }
+
+    writer->capacity = total;
+    writer->slotCount = SlotCountFor(total);
+    writer->stringSlotCount = SlotCountFor(total * 4u);
+    writer->entries = calloc((total == 0) ? 1 : total, sizeof(WriterEntry));
+    writer->slots = calloc(writer->slotCount, sizeof(uint32_t));
+    writer->stringSlots = calloc(writer->stringSlotCount, sizeof(uint32_t));
+    if ((NULL == writer->entries) || (NULL == writer->slots) || (NULL == writer->stringSlots))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; m_qassert_meta_items[i].module != NULL; ++i)
+    {
+        if (!WriterAddItem(writer, QAssertMetaPrivateBuiltinEntry(&m_qassert_meta_items[i])))
+        {
+            return false;
+        }
+    }
+
+    if ((NULL != application) && !WriterAddItems(writer, application))
+    {
+        return false;
+    }
+
+    for (size_t t = 0; t < QAssertMetaPrivateRegisteredTableCount(); ++t)
+    {
+        if (!WriterAddItems(writer, QAssertMetaPrivateRegisteredTable(t)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool QAssertMetaDbWrite(FILE * file)
+{
+    if (NULL == file)
+    {
+        return false;
+    }
+
+    Writer writer;
+    memset(&writer, 0, sizeof(writer));
+    bool ok = WriterCollect(&writer);
+
+    uint32_t bucketCount = SlotCountFor(writer.count);
+    uint32_t headerSize = Align4((uint32_t)sizeof(QAssertMetaDbHeader));
+    uint32_t bucketsOffset = headerSize;
+    uint32_t entriesOffset = bucketsOffset + (bucketCount * 4u);
+    uint32_t entriesSize = writer.count * (uint32_t)sizeof(QAssertMetaDbEntry);
+    uint32_t stringsOffset = entriesOffset + entriesSize;
+
+    uint8_t * image = NULL;
+    if (ok)
+    {
+        image = calloc(1, stringsOffset);
+        ok = (NULL != image);
+    }
+
+    for (uint32_t i = 0; ok && (i < writer.count); ++i)
+    {
+        const QAssertMetaItem * item = writer.entries[i].item;
+        uint8_t * entry = image + entriesOffset + (i * sizeof(QAssertMetaDbEntry));
+        uint32_t strings[4] = {
+            WriterAddString(&writer, item->module),
+            WriterAddString(&writer, item->description.brief),
+            WriterAddString(&writer, item->description.tips),
+            WriterAddString(&writer, item->description.url)
+        };
+        ok = (strings[0] != QASSERT_META_DB_NO_STRING) &&
+             ((NULL == item->description.brief) || (strings[1] != QASSERT_META_DB_NO_STRING)) &&
+             ((NULL == item->description.tips) || (strings[2] != QASSERT_META_DB_NO_STRING)) &&
+             ((NULL == item->description.url) || (strings[3] != QASSERT_META_DB_NO_STRING));
+
+        WriteU32(entry + offsetof(QAssertMetaDbEntry, hash), writer.entries[i].hash);
+        WriteU32(entry + offsetof(QAssertMetaDbEntry, id), (uint32_t)item->id);
+        WriteU32(entry + offsetof(QAssertMetaDbEntry, module), strings[0]);
+        WriteU32(entry + offsetof(QAssertMetaDbEntry, brief), strings[1]);
+        WriteU32(entry + offsetof(QAssertMetaDbEntry, tips), strings[2]);
+        WriteU32(entry + offsetof(QAssertMetaDbEntry, url), strings[3]);
+
+        uint32_t mask = bucketCount - 1u;
+        uint32_t slot = writer.entries[i].hash & mask;
+        while (ReadU32(image + bucketsOffset + (slot * 4u)) != 0)
+        {
+            slot = (slot + 1u) & mask;
+        }
+        WriteU32(image + bucketsOffset + (slot * 4u), i + 1u);
+    }
+
+    uint32_t stringsSize = Align4(writer.stringsSize);
+    if (ok)
+    {
+        WriteU32(image + offsetof(QAssertMetaDbHeader, magic), QASSERT_META_DB_MAGIC);
+        WriteU32(image + offsetof(QAssertMetaDbHeader, version), QASSERT_META_DB_VERSION);
+        WriteU32(image + offsetof(QAssertMetaDbHeader, headerSize), headerSize);
+        WriteU32(image + offsetof(QAssertMetaDbHeader, fileSize), stringsOffset + stringsSize);
+        WriteU32(image + offsetof(QAssertMetaDbHeader, entryCount), writer.count);
+        WriteU32(image + offsetof(QAssertMetaDbHeader, bucketCount), bucketCount);
+        WriteU32(image + offsetof(QAssertMetaDbHeader, bucketsOffset), bucketsOffset);
+        WriteU32(image + offsetof(QAssertMetaDbHeader, entriesOffset), entriesOffset);
+        WriteU32(image + offsetof(QAssertMetaDbHeader, stringsOffset), stringsOffset);
+        WriteU32(image + offsetof(QAssertMetaDbHeader, stringsSize), stringsSize);
+
+        static const uint8_t padding[4] = {0, 0, 0, 0};
+        ok = (1 == fwrite(image, stringsOffset, 1, file)) &&
+             ((writer.stringsSize == 0) || (1 == fwrite(writer.strings, writer.stringsSize, 1, file))) &&
+             ((stringsSize == writer.stringsSize) ||
+              (1 == fwrite(padding, stringsSize - writer.stringsSize, 1, file)));
+    }
+
+    free(image);
+    WriterFree(&writer);
+    return ok;
+}
+
+bool QAssertMetaDbExport(const char * path)
+{
+    if (NULL == path)
+    {
+        return false;
+    }
+
+    FILE * file = fopen(path, "wb");
+    if (NULL == file)
+    {
+        return false;
+    }
+
+    bool ok = QAssertMetaDbWrite(file);
+    ok = (0 == fclose(file)) && ok;
+    return ok;
+}
+
+// ---------------------------------------------------------------------
+// reader
+
+static bool RegionValid(uint32_t offset, uint64_t length, size_t size)
+{
+    return ((offset % 4u) == 0) && (((uint64_t)offset + length) <= size);
+}
+
+bool QAssertMetaDbAttach(QAssertMetaDb * db, const void * image, size_t size)
+{
+    if ((NULL == db) || (NULL == image) || (size < sizeof(QAssertMetaDbHeader)))
+    {
+        return false;
+    }
+
+    const uint8_t * bytes = image;
+    uint32_t bucketCount = HEADER_FIELD(bytes, bucketCount);
+    uint32_t entryCount = HEADER_FIELD(bytes, entryCount);
+    bool valid = (HEADER_FIELD(bytes, magic) == QASSERT_META_DB_MAGIC) &&
+                 (HEADER_FIELD(bytes, version) == QASSERT_META_DB_VERSION) &&
+                 (HEADER_FIELD(bytes, fileSize) <= size) &&
+                 (bucketCount != 0) && ((bucketCount & (bucketCount - 1u)) == 0) &&
+                 (entryCount < bucketCount) &&
+                 RegionValid(HEADER_FIELD(bytes, bucketsOffset), (uint64_t)bucketCount * 4u, size) &&
+                 RegionValid(HEADER_FIELD(bytes, entriesOffset),
+                             (uint64_t)entryCount * sizeof(QAssertMetaDbEntry), size) &&
+                 RegionValid(HEADER_FIELD(bytes, stringsOffset), HEADER_FIELD(bytes, stringsSize), size);
+    //the string pool must end with a terminator, so no string can overrun it.
+    uint32_t stringsSize = HEADER_FIELD(bytes, stringsSize);
+    if ((!valid) || ((stringsSize != 0) && (bytes[HEADER_FIELD(bytes, stringsOffset) + stringsSize - 1u] != 0)))
+    {
+        return false;
+    }
+
+    db->image = bytes;
+    db->size = size;
+    db->mapping = NULL;
+    db->mappingSize = 0;
+    return true;
+}
+
+bool QAssertMetaDbOpen(QAssertMetaDb * db, const char * path)
+{
+    if ((NULL == db) || (NULL == path))
+    {
+        return false;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+    void * mapping = MAP_FAILED;
+    if ((0 == fstat(fd, &info)) && (info.st_size > 0))
+    {
+        mapping = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+
+    if (MAP_FAILED == mapping)
+    {
+        return false;
+    }
+
+    if (!QAssertMetaDbAttach(db, mapping, (size_t)info.st_size))
+    {
+        munmap(mapping, (size_t)info.st_size);
+        return false;
+    }
+
+    db->mapping = mapping;
+    db->mappingSize = (size_t)info.st_size;
+    return true;
+}
+
+void QAssertMetaDbClose(QAssertMetaDb * db)
+{
+    if (NULL == db)
+    {
+        return;
+    }
+
+    if (m_installed_db == db)
+    {
+        QAssertMetaDbInstall(NULL);
+    }
+
+    if (db->mapping != NULL)
+    {
+        munmap(db->mapping, db->mappingSize);
+    }
+    db->image = NULL;
+    db->size = 0;
+    db->mapping = NULL;
+    db->mappingSize = 0;
+}
+
+static const char * DbString(const QAssertMetaDb * db, uint32_t offset)
+{
+    uint32_t stringsSize = HEADER_FIELD(db->image, stringsSize);
+    if (offset >= stringsSize)
+    {
+        return NULL;
+    }
+    return (const char *)(db->image + HEADER_FIELD(db->image, stringsOffset) + offset);
+}
+
+bool QAssertMetaDbLookup(const QAssertMetaDb * db, const char * module, int id, QAssertMetaDescription* output)
+{
+    return (NULL != module) && QAssertMetaDbLookupN(db, module, strlen(module), id, output);
+}
+
+bool QAssertMetaDbLookupN(const QAssertMetaDb * db, const char * module, size_t length, int id,
+                          QAssertMetaDescription* output)
+{
+    if ((NULL == db) || (NULL == db->image) || (NULL == module) || (NULL == output))
+    {
+        return false;
+    }
+
+    const uint8_t * image = db->image;
+    const uint8_t * buckets = image + HEADER_FIELD(image, bucketsOffset);
+    const uint8_t * entries = image + HEADER_FIELD(image, entriesOffset);
+    uint32_t entryCount = HEADER_FIELD(image, entryCount);
+    uint32_t mask = HEADER_FIELD(image, bucketCount) - 1u;
+    uint32_t hash = QAssertMetaPrivateHash(module, length, id);
+
+    //a valid image always has an empty bucket, the bound only guards corrupt images
+    uint32_t slot = hash & mask;
+    for (uint32_t probe = 0; probe <= mask; ++probe, slot = (slot + 1u) & mask)
+    {
+        uint32_t index = ReadU32(buckets + (slot * 4u));
+        if ((0 == index) || (index > entryCount))
+        {
+            return false;
+        }
+
+        const uint8_t * entry = entries + ((index - 1u) * sizeof(QAssertMetaDbEntry));
+        if ((ENTRY_FIELD(entry, hash) != hash) || ((int32_t)ENTRY_FIELD(entry, id) != id))
+        {
+            continue;
+        }
+
+        const char * entryModule = DbString(db, ENTRY_FIELD(entry, module));
+        if ((entryModule != NULL) && QAssertMetaPrivateModuleEquals(entryModule, module, length))
+        {
+            output->brief = DbString(db, ENTRY_FIELD(entry, brief));
+            output->tips = DbString(db, ENTRY_FIELD(entry, tips));
+            output->url = DbString(db, ENTRY_FIELD(entry, url));
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool InstalledDbCallback(const char * module, int id, QAssertMetaDescription* output)
+{
+    return QAssertMetaDbLookup(m_installed_db, module, id, output);
+}
+
+void QAssertMetaDbInstall(const QAssertMetaDb * db)
+{
+    m_installed_db = db;
+    QAssertMetaRegisterUnknownCallback((NULL == db) ? NULL : InstalledDbCallback);
+}
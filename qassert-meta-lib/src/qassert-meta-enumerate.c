@@ -0,0 +1,220 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "qassert-meta-enumerate.h"
+#include "qassert-meta-private.h"
+#include "qassert-meta-fuzzy-private.h"
+#include <string.h>
+
+//a table is probed per id when the id range is at most 1/PROBE_RATIO of its size
+#define PROBE_RATIO 8u
+
+/**
+ * Compare a module of the generated index with the module slice, as strcmp.
+ */
+static int CompareModule(const QAssertMetaFuzzyModule * indexed, const char * module, size_t length)
+{
+    size_t common = (indexed->length < length) ? indexed->length : length;
+    int result = memcmp(indexed->name, module, common);
+    if (result == 0)
+    {
+        result = (indexed->length > length) - (indexed->length < length);
+    }
+    return result;
+}
+
+static void StartGroup(QAssertMetaIterator * iterator)
+{
+    const QAssertMetaFuzzyModule * module = &m_qassert_meta_fuzzy_modules[iterator->group];
+    size_t low = module->firstItem;
+    size_t high = low + module->itemCount;
+    iterator->end = high;
+
+    //first item of the module with id >= minId, the module's items are sorted by id
+    while (low < high)
+    {
+        size_t middle = low + ((high - low) / 2u);
+        if (m_qassert_meta_items[m_qassert_meta_fuzzy_module_items[middle]].id < iterator->minId)
+        {
+            low = middle + 1u;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    iterator->position = low;
+}
+
+static void StartBuiltin(QAssertMetaIterator * iterator)
+{
+    iterator->group = 0;
+    iterator->groupEnd = m_qassert_meta_fuzzy_module_count;
+    if (NULL != iterator->module)
+    {
+        //modules are sorted by name
+        size_t low = 0;
+        size_t high = m_qassert_meta_fuzzy_module_count;
+        while (low < high)
+        {
+            size_t middle = low + ((high - low) / 2u);
+            if (CompareModule(&m_qassert_meta_fuzzy_modules[middle], iterator->module, iterator->moduleLength) < 0)
+            {
+                low = middle + 1u;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        bool found = (low < m_qassert_meta_fuzzy_module_count) &&
+                     (0 == CompareModule(&m_qassert_meta_fuzzy_modules[low], iterator->module, iterator->moduleLength));
+        iterator->group = low;
+        iterator->groupEnd = found ? (low + 1u) : low;
+    }
+
+    if (iterator->group < iterator->groupEnd)
+    {
+        StartGroup(iterator);
+    }
+}
+
+static const QAssertMetaItem * NextBuiltin(QAssertMetaIterator * iterator)
+{
+    while (iterator->group < iterator->groupEnd)
+    {
+        if (iterator->position < iterator->end)
+        {
+            const QAssertMetaItem * item = &m_qassert_meta_items[m_qassert_meta_fuzzy_module_items[iterator->position]];
+            if (item->id <= iterator->maxId)
+            {
+                ++iterator->position;
+                return QAssertMetaPrivateBuiltinEntry(item);
+            }
+            iterator->position = iterator->end; //past the id range
+        }
+
+        ++iterator->group;
+        if (iterator->group < iterator->groupEnd)
+        {
+            StartGroup(iterator);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Move to the next table with items, from source onwards.
+ * @return: false if there are no more tables.
+ */
+static bool StartTable(QAssertMetaIterator * iterator, size_t source)
+{
+    QAssertMetaTableInfo info;
+    for (; (source - 1u) <= QAssertMetaPrivateRegisteredTableCount(); ++source)
+    {
+        if (QAssertMetaPrivateGetTable(source - 1u, &info))
+        {
+            uint64_t span = (uint64_t)((int64_t)iterator->maxId - (int64_t)iterator->minId) + 1u;
+            iterator->source = source;
+            iterator->items = info.items;
+            iterator->position = 0;
+            iterator->end = info.itemCount;
+            iterator->probing = (NULL != iterator->module) && info.indexed &&
+                                (span <= (info.itemCount / PROBE_RATIO));
+            iterator->probeId = iterator->minId;
+            return true;
+        }
+    }
+    return false;
+}
+
+static const QAssertMetaItem * NextInTable(QAssertMetaIterator * iterator)
+{
+    if (iterator->probing)
+    {
+        while (iterator->probeId <= iterator->maxId)
+        {
+            int id = (int)iterator->probeId++;
+            const QAssertMetaItem * item = QAssertMetaPrivateSearchTable(iterator->source - 1u, iterator->module,
+                                                                        iterator->moduleLength, id);
+            if (NULL != item)
+            {
+                return item;
+            }
+        }
+        return NULL;
+    }
+
+    while (iterator->position < iterator->end)
+    {
+        const QAssertMetaItem * item = &iterator->items[iterator->position++];
+        if ((item->id >= iterator->minId) && (item->id <= iterator->maxId) &&
+            ((NULL == iterator->module) ||
+             QAssertMetaPrivateModuleEquals(item->module, iterator->module, iterator->moduleLength)))
+        {
+            return item;
+        }
+    }
+    return NULL;
+}
+
+void QAssertMetaIteratorInit(QAssertMetaIterator * iterator, const char * module, int minId, int maxId)
+{
+    if (NULL == iterator)
+    {
+        return;
+    }
+
+    memset(iterator, 0, sizeof(*iterator));
+    iterator->module = module;
+    iterator->moduleLength = (NULL != module) ? strlen(module) : 0;
+    iterator->minId = minId;
+    iterator->maxId = maxId;
+    iterator->done = (minId > maxId);
+    if (!iterator->done)
+    {
+        StartBuiltin(iterator);
+    }
+}
+
+bool QAssertMetaIteratorNext(QAssertMetaIterator * iterator, QAssertMetaEntry * entry)
+{
+    if ((NULL == iterator) || (NULL == entry))
+    {
+        return false;
+    }
+
+    while (!iterator->done)
+    {
+        const QAssertMetaItem * item = (0 == iterator->source) ? NextBuiltin(iterator) : NextInTable(iterator);
+        if (NULL != item)
+        {
+            entry->item = item;
+            entry->source = (iterator->source == 0) ? QASSERT_META_SOURCE_BUILTIN :
+                            (iterator->source == 1) ? QASSERT_META_SOURCE_APPLICATION : QASSERT_META_SOURCE_REGISTERED;
+            entry->table = (iterator->source >= 2) ? (iterator->source - 2u) : 0u;
+            return true;
+        }
+        iterator->done = !StartTable(iterator, iterator->source + 1u);
+    }
+    return false;
+}
@@ -0,0 +1,56 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_FUZZY_PRIVATE_H
+#define QASSERT_META_QASSERT_META_FUZZY_PRIVATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+//marks the start and end of a module name when forming bigrams
+#define QASSERT_META_FUZZY_START '^'
+#define QASSERT_META_FUZZY_END   '$'
+
+typedef struct {
+    const char * name;
+    uint16_t length;
+    uint16_t firstItem;  //into m_qassert_meta_fuzzy_module_items
+    uint16_t itemCount;
+} QAssertMetaFuzzyModule;
+
+typedef struct {
+    char gram[2];
+    uint16_t firstModule; //into m_qassert_meta_fuzzy_gram_modules
+    uint16_t moduleCount;
+} QAssertMetaFuzzyGram;
+
+//generated at build time by qassert-meta-gen.
+//modules sorted by name, module items (m_qassert_meta_items indexes) sorted by id,
+//grams sorted by their two characters.
+extern const QAssertMetaFuzzyModule m_qassert_meta_fuzzy_modules[];
+extern const size_t m_qassert_meta_fuzzy_module_count;
+extern const uint16_t m_qassert_meta_fuzzy_module_items[];
+extern const QAssertMetaFuzzyGram m_qassert_meta_fuzzy_grams[];
+extern const size_t m_qassert_meta_fuzzy_gram_count;
+extern const uint16_t m_qassert_meta_fuzzy_gram_modules[];
+
+#endif //QASSERT_META_QASSERT_META_FUZZY_PRIVATE_H
@@ -0,0 +1,256 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "qassert-meta-fuzzy.h"
+#include "qassert-meta-fuzzy-private.h"
+#include "qassert-meta-overrides.h"
+#include "qassert-meta-private.h"
+#include "qassert-meta-generated.h"
+#include <string.h>
+
+//module names longer than this are compared by their first characters only
+#define MAX_COMPARE_LENGTH 32
+
+//module and id similarities are scaled 0..SCALE
+#define SCALE 100u
+
+static int CompareGram(const char lhs[2], char a, char b)
+{
+    if (lhs[0] != a)
+    {
+        return ((unsigned char)lhs[0] < (unsigned char)a) ? -1 : 1;
+    }
+    if (lhs[1] != b)
+    {
+        return ((unsigned char)lhs[1] < (unsigned char)b) ? -1 : 1;
+    }
+    return 0;
+}
+
+static const QAssertMetaFuzzyGram * FindGram(char a, char b)
+{
+    size_t low = 0;
+    size_t high = m_qassert_meta_fuzzy_gram_count;
+    while (low < high)
+    {
+        size_t mid = low + ((high - low) / 2);
+        int result = CompareGram(m_qassert_meta_fuzzy_grams[mid].gram, a, b);
+        if (result == 0)
+        {
+            return &m_qassert_meta_fuzzy_grams[mid];
+        }
+        if (result < 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return NULL;
+}
+
+static size_t EditDistance(const char * lhs, size_t lhsLength, const char * rhs, size_t rhsLength)
+{
+    size_t rows[2][MAX_COMPARE_LENGTH + 1];
+    size_t * previous = rows[0];
+    size_t * current = rows[1];
+
+    for (size_t j = 0; j <= rhsLength; ++j)
+    {
+        previous[j] = j;
+    }
+
+    for (size_t i = 1; i <= lhsLength; ++i)
+    {
+        current[0] = i;
+        for (size_t j = 1; j <= rhsLength; ++j)
+        {
+            size_t substitute = previous[j - 1] + ((lhs[i - 1] == rhs[j - 1]) ? 0u : 1u);
+            size_t remove = previous[j] + 1u;
+            size_t insert = current[j - 1] + 1u;
+            size_t best = (substitute < remove) ? substitute : remove;
+            current[j] = (best < insert) ? best : insert;
+        }
+        size_t * swap = previous;
+        previous = current;
+        current = swap;
+    }
+    return previous[rhsLength];
+}
+
+static unsigned ModuleSimilarity(const char * query, size_t queryLength, const char * name, size_t length)
+{
+    size_t moduleLength = (length < MAX_COMPARE_LENGTH) ? length : MAX_COMPARE_LENGTH;
+    if (0 == moduleLength)
+    {
+        return 0; //an application module may be empty, nothing of the query is in it
+    }
+    if ((queryLength <= moduleLength) && (0 == strncmp(query, name, queryLength)))
+    {
+        //exact, or truncated: more of the name present is more certain
+        return (unsigned)(((SCALE * 6u) / 10u) + (((SCALE * 4u) / 10u) * queryLength) / moduleLength);
+    }
+
+    size_t distance = EditDistance(query, queryLength, name, moduleLength);
+    size_t longest = (queryLength > moduleLength) ? queryLength : moduleLength;
+    return (distance >= longest) ? 0u : (unsigned)((SCALE * (longest - distance)) / longest);
+}
+
+static unsigned CountBits(unsigned value)
+{
+    unsigned count = 0;
+    while (value != 0)
+    {
+        value &= value - 1u;
+        ++count;
+    }
+    return count;
+}
+
+static unsigned IdSimilarity(int query, int id)
+{
+    if (query == id)
+    {
+        return SCALE;
+    }
+
+    unsigned flipped = CountBits((unsigned)query ^ (unsigned)id);
+    if (flipped == 1)
+    {
+        return (SCALE * 8u) / 10u;
+    }
+    if (flipped == 2)
+    {
+        return (SCALE * 6u) / 10u;
+    }
+    if ((query / 100) == (id / 100))
+    {
+        return SCALE / 2u;
+    }
+    return 0;
+}
+
+static void InsertMatch(QAssertMetaFuzzyMatch * matches, size_t * count, size_t maxMatches,
+                        const QAssertMetaFuzzyMatch * candidate)
+{
+    size_t position = *count;
+    while ((position > 0) && (candidate->confidence > matches[position - 1].confidence))
+    {
+        --position;
+    }
+    if (position >= maxMatches)
+    {
+        return;
+    }
+
+    size_t last = (*count < maxMatches) ? *count : (maxMatches - 1);
+    memmove(&matches[position + 1], &matches[position], (last - position) * sizeof(QAssertMetaFuzzyMatch));
+    matches[position] = *candidate;
+    if (*count < maxMatches)
+    {
+        ++(*count);
+    }
+}
+
+size_t QAssertMetaFuzzyLookup(const char * module, int id, QAssertMetaFuzzyMatch * matches, size_t maxMatches)
+{
+    if ((NULL == module) || (NULL == matches) || (0 == maxMatches))
+    {
+        return 0;
+    }
+
+    //an empty query would be a truncation of every module
+    size_t queryLength = strlen(module);
+    if (0 == queryLength)
+    {
+        return 0;
+    }
+    if (queryLength > MAX_COMPARE_LENGTH)
+    {
+        queryLength = MAX_COMPARE_LENGTH;
+    }
+
+    //candidate modules share at least one bigram with the query
+    bool candidates[QASSERT_META_BUILTIN_MODULE_COUNT + 1]; //+1, never a zero length array
+    memset(candidates, 0, sizeof(candidates));
+    char previous = QASSERT_META_FUZZY_START;
+    for (size_t i = 0; i <= queryLength; ++i)
+    {
+        char current = (i < queryLength) ? module[i] : QASSERT_META_FUZZY_END;
+        const QAssertMetaFuzzyGram * gram = FindGram(previous, current);
+        for (size_t m = 0; (gram != NULL) && (m < gram->moduleCount); ++m)
+        {
+            candidates[m_qassert_meta_fuzzy_gram_modules[gram->firstModule + m]] = true;
+        }
+        previous = current;
+    }
+
+    size_t count = 0;
+    for (size_t m = 0; m < m_qassert_meta_fuzzy_module_count; ++m)
+    {
+        if (!candidates[m])
+        {
+            continue;
+        }
+
+        const QAssertMetaFuzzyModule * candidate = &m_qassert_meta_fuzzy_modules[m];
+        unsigned moduleSimilarity = ModuleSimilarity(module, queryLength, candidate->name, candidate->length);
+        if (moduleSimilarity < QASSERT_META_FUZZY_MIN_CONFIDENCE)
+        {
+            continue;
+        }
+
+        for (size_t i = 0; i < candidate->itemCount; ++i)
+        {
+            const QAssertMetaItem * item = &m_qassert_meta_items[m_qassert_meta_fuzzy_module_items[candidate->firstItem + i]];
+            QAssertMetaFuzzyMatch match = {QAssertMetaPrivateBuiltinEntry(item),
+                                           (moduleSimilarity * IdSimilarity(id, item->id)) / SCALE};
+            if (match.confidence >= QASSERT_META_FUZZY_MIN_CONFIDENCE)
+            {
+                InsertMatch(matches, &count, maxMatches, &match);
+            }
+        }
+    }
+
+    //application modules are not in the bigram index, each module is scored once per run of its items
+    const QAssertMetaItem * application = qassert_meta_application_table.items;
+    const char * scoredModule = NULL;
+    unsigned moduleSimilarity = 0;
+    for (size_t i = 0; (NULL != application) && (NULL != application[i].module); ++i)
+    {
+        const QAssertMetaItem * item = &application[i];
+        if ((NULL == scoredModule) || (0 != strcmp(scoredModule, item->module)))
+        {
+            scoredModule = item->module;
+            moduleSimilarity = ModuleSimilarity(module, queryLength, item->module, strlen(item->module));
+        }
+
+        QAssertMetaFuzzyMatch match = {item, (moduleSimilarity * IdSimilarity(id, item->id)) / SCALE};
+        if (match.confidence >= QASSERT_META_FUZZY_MIN_CONFIDENCE)
+        {
+            InsertMatch(matches, &count, maxMatches, &match);
+        }
+    }
+    return count;
+}
@@ -0,0 +1,57 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_LATENCY_PRIVATE_H
+#define QASSERT_META_QASSERT_META_LATENCY_PRIVATE_H
+
+#include "qassert-meta-latency.h"
+
+#if QASSERT_META_ENABLE_LATENCY_HISTOGRAM
+
+#if defined(QASSERT_META_LATENCY_TIMESTAMP)
+    #ifndef QASSERT_META_LATENCY_UNIT
+    #define QASSERT_META_LATENCY_UNIT "ticks"
+    #endif
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    #define QASSERT_META_LATENCY_TIMESTAMP() ((uint64_t)__rdtsc())
+    #define QASSERT_META_LATENCY_UNIT "cycles"
+#else
+    #include <time.h>
+    static inline uint64_t QAssertMetaPrivateMonotonicNs(void)
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return ((uint64_t)now.tv_sec * 1000000000u) + (uint64_t)now.tv_nsec;
+    }
+    #define QASSERT_META_LATENCY_TIMESTAMP() QAssertMetaPrivateMonotonicNs()
+    #define QASSERT_META_LATENCY_UNIT "ns"
+#endif
+
+/**
+ * Count one lookup of the given category and latency.
+ */
+void QAssertMetaPrivateLatencyRecord(QAssertMetaLatencyCategory category, uint64_t latency);
+
+#endif //QASSERT_META_ENABLE_LATENCY_HISTOGRAM
+
+#endif //QASSERT_META_QASSERT_META_LATENCY_PRIVATE_H
@@ -0,0 +1,140 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "qassert-meta-latency.h"
+#include "qassert-meta-latency-private.h"
+
+#if QASSERT_META_ENABLE_LATENCY_HISTOGRAM
+
+#include <stdatomic.h>
+#include <stdio.h>
+
+static atomic_uint_least32_t m_buckets[QASSERT_META_LATENCY_CATEGORY_COUNT][QASSERT_META_LATENCY_BUCKET_COUNT];
+
+static const char * const CATEGORY_NAMES[QASSERT_META_LATENCY_CATEGORY_COUNT] = {
+    "builtin_hit",
+    "registered_hit",
+    "callback_hit",
+    "miss"
+};
+
+static unsigned BucketOf(uint64_t latency)
+{
+    unsigned bucket = 0;
+    while ((latency >= 2u) && (bucket < (QASSERT_META_LATENCY_BUCKET_COUNT - 1u)))
+    {
+        latency >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+void QAssertMetaPrivateLatencyRecord(QAssertMetaLatencyCategory category, uint64_t latency)
+{
+    (void)atomic_fetch_add_explicit(&m_buckets[category][BucketOf(latency)], 1u, memory_order_relaxed);
+}
+
+bool QAssertMetaLatencyGetHistogram(QAssertMetaLatencyHistogram * histogram)
+{
+    if (NULL == histogram)
+    {
+        return false;
+    }
+
+    for (size_t c = 0; c < QASSERT_META_LATENCY_CATEGORY_COUNT; ++c)
+    {
+        for (size_t b = 0; b < QASSERT_META_LATENCY_BUCKET_COUNT; ++b)
+        {
+            histogram->buckets[c][b] = (uint32_t)atomic_load_explicit(&m_buckets[c][b], memory_order_relaxed);
+        }
+    }
+    return true;
+}
+
+const char * QAssertMetaLatencyUnit(void)
+{
+    return QASSERT_META_LATENCY_UNIT;
+}
+
+bool QAssertMetaLatencyDump(QAssertMetaLatencyLineWriter writer, void * context)
+{
+    QAssertMetaLatencyHistogram histogram;
+    if ((NULL == writer) || !QAssertMetaLatencyGetHistogram(&histogram))
+    {
+        return false;
+    }
+
+    char line[96];
+    for (size_t c = 0; c < QASSERT_META_LATENCY_CATEGORY_COUNT; ++c)
+    {
+        for (size_t b = 0; b < QASSERT_META_LATENCY_BUCKET_COUNT; ++b)
+        {
+            if (histogram.buckets[c][b] == 0)
+            {
+                continue;
+            }
+
+            unsigned long long low = (b == 0) ? 0u : (1ull << b);
+            snprintf(line, sizeof(line), "%s [%llu, %llu) %s: %lu", CATEGORY_NAMES[c],
+                     low, 1ull << (b + 1u), QASSERT_META_LATENCY_UNIT, (unsigned long)histogram.buckets[c][b]);
+            writer(line, context);
+        }
+    }
+    return true;
+}
+
+void QAssertMetaLatencyReset(void)
+{
+    for (size_t c = 0; c < QASSERT_META_LATENCY_CATEGORY_COUNT; ++c)
+    {
+        for (size_t b = 0; b < QASSERT_META_LATENCY_BUCKET_COUNT; ++b)
+        {
+            atomic_store_explicit(&m_buckets[c][b], 0u, memory_order_relaxed);
+        }
+    }
+}
+
+#else
+
+bool QAssertMetaLatencyGetHistogram(QAssertMetaLatencyHistogram * histogram)
+{
+    (void)histogram;
+    return false;
+}
+
+const char * QAssertMetaLatencyUnit(void)
+{
+    return "";
+}
+
+bool QAssertMetaLatencyDump(QAssertMetaLatencyLineWriter writer, void * context)
+{
+    (void)writer;
+    (void)context;
+    return false;
+}
+
+void QAssertMetaLatencyReset(void)
+{
+}
+
+#endif //QASSERT_META_ENABLE_LATENCY_HISTOGRAM
@@ -0,0 +1,414 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "qassert-meta-locale.h"
+#include "qassert-meta-private.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//a registered pack, mapped by the first lookup with its locale.
+typedef struct {
+    char name[QASSERT_META_LOCALE_NAME_SIZE];
+    char * path;
+    _Atomic(const uint8_t *) image; //NULL until mapped and valid
+    atomic_bool attempted;          //a failed pack is not retried
+    void * mapping;
+    size_t mappingSize;
+} LocalePack;
+
+static LocalePack m_locales[QASSERT_META_MAX_LOCALES];
+static size_t m_locale_count = 0;
+static pthread_mutex_t m_load_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static uint32_t ReadU32(const uint8_t * p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void WriteU32(uint8_t * p, uint32_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+#define HEADER_FIELD(image, field) ReadU32((image) + offsetof(QAssertMetaLocaleHeader, field))
+
+static uint32_t Align4(uint32_t value)
+{
+    return (value + 3u) & ~3u;
+}
+
+static uint32_t CountItems(void)
+{
+    uint32_t count = 0;
+    while (m_qassert_meta_items[count].module != NULL)
+    {
+        ++count;
+    }
+    return count;
+}
+
+uint32_t QAssertMetaLocaleKeyFingerprint(void)
+{
+    uint32_t fingerprint = 2166136261u;
+    for (uint32_t i = 0; m_qassert_meta_items[i].module != NULL; ++i)
+    {
+        const QAssertMetaItem * item = &m_qassert_meta_items[i];
+        fingerprint ^= QAssertMetaPrivateHash(item->module, strlen(item->module), item->id);
+        fingerprint *= 16777619u;
+    }
+    return fingerprint;
+}
+
+// ---------------------------------------------------------------------
+// writer
+
+typedef struct {
+    uint8_t * data;
+    uint32_t size;
+    uint32_t capacity;
+} StringPool;
+
+static uint32_t PoolAdd(StringPool * pool, const char * str)
+{
+    size_t length = strlen(str) + 1u;
+    while ((pool->size + length) > pool->capacity)
+    {
+        uint32_t capacity = (pool->capacity == 0) ? 4096u : (pool->capacity * 2u);
+        uint8_t * data = realloc(pool->data, capacity);
+        if (NULL == data)
+        {
+            return QASSERT_META_LOCALE_NO_STRING;
+        }
+        pool->data = data;
+        pool->capacity = capacity;
+    }
+
+    uint32_t offset = pool->size;
+    memcpy(&pool->data[offset], str, length);
+    pool->size += (uint32_t)length;
+    return offset;
+}
+
+bool QAssertMetaLocaleWritePack(FILE * file, const char * locale, const QAssertMetaTranslation * translations,
+                                size_t count, size_t * unmatched)
+{
+    if ((NULL == file) || (NULL == locale) || (strlen(locale) >= QASSERT_META_LOCALE_NAME_SIZE) ||
+        ((NULL == translations) && (count != 0)))
+    {
+        return false;
+    }
+
+    uint32_t keyCount = CountItems();
+    const QAssertMetaTranslation ** byKey = calloc((keyCount == 0) ? 1 : keyCount, sizeof(*byKey));
+    if (NULL == byKey)
+    {
+        return false;
+    }
+
+    size_t missing = 0;
+    for (size_t t = 0; t < count; ++t)
+    {
+        const char * module = translations[t].module;
+        const QAssertMetaItem * item = (NULL != module) ?
+                                       QAssertMetaPrivateSearchBuiltin(module, strlen(module), translations[t].id) : NULL;
+        if (NULL == item)
+        {
+            ++missing;
+        }
+        else if (NULL == byKey[item - m_qassert_meta_items])
+        {
+            byKey[item - m_qassert_meta_items] = &translations[t];
+        }
+    }
+    if (NULL != unmatched)
+    {
+        *unmatched = missing;
+    }
+
+    uint32_t headerSize = Align4((uint32_t)sizeof(QAssertMetaLocaleHeader));
+    uint32_t entriesOffset = headerSize;
+    uint32_t stringsOffset = entriesOffset + (keyCount * (uint32_t)sizeof(QAssertMetaLocaleEntry));
+    uint8_t * image = calloc(1, stringsOffset);
+    StringPool pool = {NULL, 0, 0};
+    uint32_t localeOffset = PoolAdd(&pool, locale);
+    bool ok = (NULL != image) && (localeOffset != QASSERT_META_LOCALE_NO_STRING);
+
+    for (uint32_t i = 0; ok && (i < keyCount); ++i)
+    {
+        const QAssertMetaTranslation * translation = byKey[i];
+        uint32_t brief = QASSERT_META_LOCALE_NO_STRING;
+        uint32_t tips = QASSERT_META_LOCALE_NO_STRING;
+        if ((NULL != translation) && (NULL != translation->brief))
+        {
+            brief = PoolAdd(&pool, translation->brief);
+            ok = (brief != QASSERT_META_LOCALE_NO_STRING);
+        }
+        if (ok && (NULL != translation) && (NULL != translation->tips))
+        {
+            tips = PoolAdd(&pool, translation->tips);
+            ok = (tips != QASSERT_META_LOCALE_NO_STRING);
+        }
+
+        uint8_t * entry = image + entriesOffset + (i * sizeof(QAssertMetaLocaleEntry));
+        WriteU32(entry + offsetof(QAssertMetaLocaleEntry, brief), brief);
+        WriteU32(entry + offsetof(QAssertMetaLocaleEntry, tips), tips);
+    }
+
+    uint32_t stringsSize = Align4(pool.size);
+    if (ok)
+    {
+        WriteU32(image + offsetof(QAssertMetaLocaleHeader, magic), QASSERT_META_LOCALE_MAGIC);
+        WriteU32(image + offsetof(QAssertMetaLocaleHeader, version), QASSERT_META_LOCALE_VERSION);
+        WriteU32(image + offsetof(QAssertMetaLocaleHeader, headerSize), headerSize);
+        WriteU32(image + offsetof(QAssertMetaLocaleHeader, fileSize), stringsOffset + stringsSize);
+        WriteU32(image + offsetof(QAssertMetaLocaleHeader, keyCount), keyCount);
+        WriteU32(image + offsetof(QAssertMetaLocaleHeader, keyFingerprint), QAssertMetaLocaleKeyFingerprint());
+        WriteU32(image + offsetof(QAssertMetaLocaleHeader, locale), localeOffset);
+        WriteU32(image + offsetof(QAssertMetaLocaleHeader, entriesOffset), entriesOffset);
+        WriteU32(image + offsetof(QAssertMetaLocaleHeader, stringsOffset), stringsOffset);
+        WriteU32(image + offsetof(QAssertMetaLocaleHeader, stringsSize), stringsSize);
+
+        static const uint8_t padding[4] = {0, 0, 0, 0};
+        ok = (1 == fwrite(image, stringsOffset, 1, file)) &&
+             (1 == fwrite(pool.data, pool.size, 1, file)) &&
+             ((stringsSize == pool.size) || (1 == fwrite(padding, stringsSize - pool.size, 1, file)));
+    }
+
+    free(image);
+    free(pool.data);
+    free(byKey);
+    return ok;
+}
+
+// ---------------------------------------------------------------------
+// reader
+
+static bool RegionValid(uint32_t offset, uint64_t length, size_t size)
+{
+    return ((offset % 4u) == 0) && (((uint64_t)offset + length) <= size);
+}
+
+static bool PackValid(const uint8_t * image, size_t size)
+{
+    if (size < sizeof(QAssertMetaLocaleHeader))
+    {
+        return false;
+    }
+
+    uint32_t keyCount = HEADER_FIELD(image, keyCount);
+    uint32_t stringsSize = HEADER_FIELD(image, stringsSize);
+    bool valid = (HEADER_FIELD(image, magic) == QASSERT_META_LOCALE_MAGIC) &&
+                 (HEADER_FIELD(image, version) == QASSERT_META_LOCALE_VERSION) &&
+                 (HEADER_FIELD(image, fileSize) <= size) &&
+                 (keyCount == CountItems()) &&
+                 (HEADER_FIELD(image, keyFingerprint) == QAssertMetaLocaleKeyFingerprint()) &&
+                 RegionValid(HEADER_FIELD(image, entriesOffset),
+                             (uint64_t)keyCount * sizeof(QAssertMetaLocaleEntry), size) &&
+                 RegionValid(HEADER_FIELD(image, stringsOffset), stringsSize, size) &&
+                 (HEADER_FIELD(image, locale) < stringsSize);
+    //the string pool must end with a terminator, so no string can overrun it.
+    return valid && (image[HEADER_FIELD(image, stringsOffset) + stringsSize - 1u] == 0);
+}
+
+static void MapPack(LocalePack * pack)
+{
+    int fd = open(pack->path, O_RDONLY);
+    if (fd < 0)
+    {
+        return;
+    }
+
+    struct stat info;
+    void * mapping = MAP_FAILED;
+    if ((0 == fstat(fd, &info)) && (info.st_size > 0))
+    {
+        mapping = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+
+    if (MAP_FAILED == mapping)
+    {
+        return;
+    }
+    if (!PackValid(mapping, (size_t)info.st_size))
+    {
+        munmap(mapping, (size_t)info.st_size);
+        return;
+    }
+
+    pack->mapping = mapping;
+    pack->mappingSize = (size_t)info.st_size;
+    atomic_store_explicit(&pack->image, (const uint8_t *)mapping, memory_order_release);
+}
+
+/**
+ * @return: the pack image, mapping it if this is the first lookup to use
+ *          the pack, or NULL if it can not be used.
+ */
+static const uint8_t * LoadPack(LocalePack * pack)
+{
+    const uint8_t * image = atomic_load_explicit(&pack->image, memory_order_acquire);
+    if ((NULL != image) || atomic_load_explicit(&pack->attempted, memory_order_acquire))
+    {
+        return image;
+    }
+
+    pthread_mutex_lock(&m_load_lock);
+    if (!atomic_load_explicit(&pack->attempted, memory_order_relaxed))
+    {
+        MapPack(pack);
+        atomic_store_explicit(&pack->attempted, true, memory_order_release);
+    }
+    pthread_mutex_unlock(&m_load_lock);
+    return atomic_load_explicit(&pack->image, memory_order_acquire);
+}
+
+static LocalePack * FindPack(const char * locale, size_t length)
+{
+    for (size_t i = 0; i < m_locale_count; ++i)
+    {
+        if ((0 == strncmp(m_locales[i].name, locale, length)) && (m_locales[i].name[length] == '\0'))
+        {
+            return &m_locales[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @return: the pack of the locale, or of its language ("de" for "de_AT"), or NULL.
+ */
+static LocalePack * FindLocale(const char * locale)
+{
+    size_t length = strlen(locale);
+    LocalePack * pack = FindPack(locale, length);
+    size_t language = strcspn(locale, "-_");
+    if ((NULL == pack) && (language < length))
+    {
+        pack = FindPack(locale, language);
+    }
+    return pack;
+}
+
+bool QAssertMetaLocaleRegister(const char * locale, const char * path)
+{
+    if ((NULL == locale) || (NULL == path) || (locale[0] == '\0') ||
+        (strlen(locale) >= QASSERT_META_LOCALE_NAME_SIZE) ||
+        (m_locale_count >= QASSERT_META_MAX_LOCALES) || (NULL != FindPack(locale, strlen(locale))))
+    {
+        return false;
+    }
+
+    LocalePack * pack = &m_locales[m_locale_count];
+    pack->path = strdup(path);
+    if (NULL == pack->path)
+    {
+        return false;
+    }
+    strcpy(pack->name, locale);
+    atomic_store_explicit(&pack->image, NULL, memory_order_relaxed);
+    atomic_store_explicit(&pack->attempted, false, memory_order_relaxed);
+    pack->mapping = NULL;
+    pack->mappingSize = 0;
+    ++m_locale_count;
+    return true;
+}
+
+void QAssertMetaLocaleReset(void)
+{
+    for (size_t i = 0; i < m_locale_count; ++i)
+    {
+        if (NULL != m_locales[i].mapping)
+        {
+            munmap(m_locales[i].mapping, m_locales[i].mappingSize);
+        }
+        free(m_locales[i].path);
+        memset(&m_locales[i], 0, sizeof(m_locales[i]));
+    }
+    m_locale_count = 0;
+}
+
+bool QAssertMetaLocaleIsLoaded(const char * locale)
+{
+    LocalePack * pack = (NULL != locale) ? FindPack(locale, strlen(locale)) : NULL;
+    return (NULL != pack) && (NULL != atomic_load_explicit(&pack->image, memory_order_acquire));
+}
+
+static void Localize(const char * locale, const char * module, size_t length, int id,
+                     QAssertMetaDescription * output)
+{
+    LocalePack * pack = (NULL != locale) ? FindLocale(locale) : NULL;
+    const uint8_t * image = (NULL != pack) ? LoadPack(pack) : NULL;
+    const QAssertMetaItem * item = (NULL != image) ? QAssertMetaPrivateSearchBuiltin(module, length, id) : NULL;
+    if ((NULL == item) || (QAssertMetaPrivateBuiltinEntry(item) != item))
+    {
+        return; //English, or the application's own text for a link time override
+    }
+
+    const uint8_t * entry = image + HEADER_FIELD(image, entriesOffset) +
+                            ((size_t)(item - m_qassert_meta_items) * sizeof(QAssertMetaLocaleEntry));
+    const char * strings = (const char *)image + HEADER_FIELD(image, stringsOffset);
+    uint32_t stringsSize = HEADER_FIELD(image, stringsSize);
+    uint32_t brief = ReadU32(entry + offsetof(QAssertMetaLocaleEntry, brief));
+    uint32_t tips = ReadU32(entry + offsetof(QAssertMetaLocaleEntry, tips));
+
+    //each field falls back to English on its own
+    if (brief < stringsSize)
+    {
+        output->brief = strings + brief;
+    }
+    if (tips < stringsSize)
+    {
+        output->tips = strings + tips;
+    }
+}
+
+bool QAssertMetaGetLocalizedDescription(const char * locale, const char * module, int id,
+                                        QAssertMetaDescription * output)
+{
+    if (!QAssertMetaGetDescription(module, id, output))
+    {
+        return false;
+    }
+    Localize(locale, module, strlen(module), id, output);
+    return true;
+}
+
+bool QAssertMetaGetLocalizedDescriptionN(const char * locale, const char * module, size_t length, int id,
+                                         QAssertMetaDescription * output)
+{
+    if (!QAssertMetaGetDescriptionN(module, length, id, output))
+    {
+        return false;
+    }
+    Localize(locale, module, length, id, output);
+    return true;
+}
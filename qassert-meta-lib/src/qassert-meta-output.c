@@ -0,0 +1,278 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#if !defined(QASSERT_META_OUTPUT_CLOCK_MS) && (defined(__unix__) || defined(__APPLE__)) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L //clock_gettime
+#endif
+
+#include "qassert-meta-output.h"
+#include "qassert-meta.h"
+#include "qassert-meta-private.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(QASSERT_META_OUTPUT_CLOCK_MS)
+    //provided by the build, in milliseconds
+#elif defined(__unix__) || defined(__APPLE__)
+    #include <time.h>
+    static uint32_t MonotonicMs(void)
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return ((uint32_t)now.tv_sec * 1000u) + (uint32_t)(now.tv_nsec / 1000000);
+    }
+    #define QASSERT_META_OUTPUT_CLOCK_MS() MonotonicMs()
+#else
+    //no clock: the bucket is never refilled, unless the policy provides a clock
+    #define QASSERT_META_OUTPUT_CLOCK_MS() 0u
+#endif
+
+//the seen set is at most half full, for short probes
+#define SLOT_COUNT (2u * QASSERT_META_OUTPUT_MAX_KEYS)
+#define TOKEN 1000u //bucket levels are in thousandths of a token
+
+typedef struct {
+    uint32_t hash;
+    int id;
+    uint32_t count; //0 if the slot is empty
+    char module[QASSERT_META_OUTPUT_MODULE_SIZE];
+    const char * name; //as first passed, if module is truncated, else NULL
+} SeenSlot;
+
+static QAssertMetaOutputPolicy m_policy = {QASSERT_META_OUTPUT_EVERY_TIME, 0, 0, NULL, NULL, NULL};
+static QAssertMetaOutputCounters m_counters = {0, 0, 0, 0, 0, 0, 0};
+static SeenSlot m_seen[SLOT_COUNT];
+static uint32_t m_tokens = 0; //thousandths
+static uint32_t m_refilledMs = 0;
+static uint32_t m_pendingLimited = 0; //rate limited since the last assert written
+
+static void WriteLine(const char * format, ...)
+{
+    char line[QASSERT_META_OUTPUT_LINE_SIZE];
+    va_list args;
+    va_start(args, format);
+    (void)vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    m_policy.writer(line, m_policy.context);
+}
+
+//write each line of a multi line text, indented
+static void WriteText(const char * label, const char * text)
+{
+    while (NULL != text)
+    {
+        const char * newline = strchr(text, '\n');
+        int length = (NULL != newline) ? (int)(newline - text) : (int)strlen(text);
+        WriteLine("    %s%.*s", label, length, text);
+        label = "";
+        text = (NULL != newline) ? (newline + 1) : NULL;
+    }
+}
+
+static uint32_t NowMs(void)
+{
+    return (NULL != m_policy.clockMs) ? m_policy.clockMs() : QASSERT_META_OUTPUT_CLOCK_MS();
+}
+
+static bool TakeToken(void)
+{
+    if (0 == m_policy.burst)
+    {
+        return true;
+    }
+
+    uint32_t now = NowMs();
+    uint64_t refill = (uint64_t)(now - m_refilledMs) * m_policy.perSecond; //thousandths, as elapsed is in ms
+    uint64_t capacity = (uint64_t)m_policy.burst * TOKEN;
+    m_tokens = (uint32_t)(((m_tokens + refill) < capacity) ? (m_tokens + refill) : capacity);
+    m_refilledMs = now;
+
+    if (m_tokens < TOKEN)
+    {
+        return false;
+    }
+    m_tokens -= TOKEN;
+    return true;
+}
+
+/**
+ * Count a module/id in the seen set.
+ * @return: its count including this one, or 0 if the set is full.
+ */
+static uint32_t CountSeen(const char * module, int id)
+{
+    size_t length = strlen(module);
+    size_t stored = (length < QASSERT_META_OUTPUT_MODULE_SIZE) ? length : (QASSERT_META_OUTPUT_MODULE_SIZE - 1u);
+    uint32_t hash = QAssertMetaPrivateHash(module, length, id);
+    for (uint32_t probe = 0; probe < SLOT_COUNT; ++probe)
+    {
+        SeenSlot * slot = &m_seen[(hash + probe) % SLOT_COUNT];
+        if (0 == slot->count)
+        {
+            if (m_counters.distinct >= QASSERT_META_OUTPUT_MAX_KEYS)
+            {
+                return 0;
+            }
+            slot->hash = hash;
+            slot->id = id;
+            memcpy(slot->module, module, stored);
+            slot->module[stored] = '\0';
+            slot->name = (stored < length) ? module : NULL;
+            ++m_counters.distinct;
+        }
+        else if ((slot->hash != hash) || (slot->id != id) || (0 != strncmp(slot->module, module, stored)) ||
+                 (slot->module[stored] != '\0'))
+        {
+            continue;
+        }
+        return ++slot->count;
+    }
+    return 0;
+}
+
+void QAssertMetaOutputSetPolicy(const QAssertMetaOutputPolicy * policy)
+{
+    QAssertMetaOutputPolicy disabled = {QASSERT_META_OUTPUT_EVERY_TIME, 0, 0, NULL, NULL, NULL};
+    m_policy = (NULL != policy) ? *policy : disabled;
+    QAssertMetaOutputReset();
+}
+
+void QAssertMetaOutputReset(void)
+{
+    memset(m_seen, 0, sizeof(m_seen));
+    memset(&m_counters, 0, sizeof(m_counters));
+    m_tokens = m_policy.burst * TOKEN;
+    m_refilledMs = NowMs();
+    m_pendingLimited = 0;
+}
+
+bool QAssertMetaOutputAssert(const char * module, int id)
+{
+    if ((NULL == m_policy.writer) || (NULL == module))
+    {
+        return false;
+    }
+
+    ++m_counters.asserts;
+    uint32_t count = CountSeen(module, id);
+    m_counters.untracked += (0 == count) ? 1u : 0u;
+    bool repeat = (count > 1u);
+    if (repeat && (QASSERT_META_OUTPUT_ONCE == m_policy.mode))
+    {
+        ++m_counters.repeatsSuppressed;
+        return false;
+    }
+    if (!TakeToken())
+    {
+        ++m_counters.rateLimited;
+        ++m_pendingLimited;
+        return false;
+    }
+
+    if (m_pendingLimited > 0)
+    {
+        WriteLine("QAssert: %u assert(s) not shown, rate limited", (unsigned)m_pendingLimited);
+        m_pendingLimited = 0;
+    }
+
+    //the description is only looked up for asserts actually written
+    QAssertMetaDescription description;
+    bool described = QAssertMetaGetDescription(module, id, &description);
+    if (repeat && (QASSERT_META_OUTPUT_BRIEF_AFTER_FIRST == m_policy.mode))
+    {
+        WriteLine("QAssert: %s:%d (x%u) %s", module, id, (unsigned)count,
+                  described ? description.brief : "(no description)");
+        ++m_counters.printedBrief;
+        return true;
+    }
+
+    WriteLine("QAssert: %s:%d %s", module, id, described ? description.brief : "(no description)");
+    if (described && (NULL != description.tips))
+    {
+        WriteText("tips: ", description.tips);
+    }
+    if (described && (NULL != description.url))
+    {
+        WriteLine("    url: %s", description.url);
+    }
+    ++m_counters.printedFull;
+    return true;
+}
+
+void QAssertMetaOutputSummary(void)
+{
+    if (NULL == m_policy.writer)
+    {
+        return;
+    }
+
+    WriteLine("QAssert summary: %u assert(s), %u distinct, %u not shown (%u repeats, %u rate limited)",
+              (unsigned)m_counters.asserts, (unsigned)m_counters.distinct,
+              (unsigned)(m_counters.repeatsSuppressed + m_counters.rateLimited),
+              (unsigned)m_counters.repeatsSuppressed, (unsigned)m_counters.rateLimited);
+
+    //most frequent first, ties in slot order, without sorting the set in place
+    uint32_t previousCount = UINT32_MAX;
+    size_t previousSlot = 0;
+    bool first = true;
+    for (uint32_t written = 0; written < m_counters.distinct; ++written)
+    {
+        size_t best = SLOT_COUNT;
+        for (size_t i = 0; i < SLOT_COUNT; ++i)
+        {
+            uint32_t count = m_seen[i].count;
+            bool after = first || (count < previousCount) || ((count == previousCount) && (i > previousSlot));
+            if ((count > 0) && after && ((best == SLOT_COUNT) || (count > m_seen[best].count)))
+            {
+                best = i;
+            }
+        }
+        if (best == SLOT_COUNT)
+        {
+            break;
+        }
+
+        const SeenSlot * slot = &m_seen[best];
+        const char * module = (NULL != slot->name) ? slot->name : slot->module;
+        QAssertMetaDescription description;
+        bool described = QAssertMetaGetDescription(module, slot->id, &description);
+        WriteLine("%10u %s:%d %s", (unsigned)slot->count, module, slot->id,
+                  described ? description.brief : "(no description)");
+        previousCount = slot->count;
+        previousSlot = best;
+        first = false;
+    }
+    if (m_counters.untracked > 0)
+    {
+        WriteLine("%10u (not tracked, more than %u distinct asserts)", (unsigned)m_counters.untracked,
+                  (unsigned)QASSERT_META_OUTPUT_MAX_KEYS);
+    }
+}
+
+void QAssertMetaOutputGetCounters(QAssertMetaOutputCounters * counters)
+{
+    if (NULL != counters)
+    {
+        *counters = m_counters;
+    }
+}
@@ -24,14 +24,135 @@
 #define QASSERT_META_QASSERT_META_PRIVATE_H
 
 #include "qassert-meta.h"
+#include <stddef.h>
+#include <stdint.h>
 
+typedef QAssertMetaItem QAssertMetaInternalItem;
+
+//actual data at either qpc or qpcpp file, based on build options.
+extern QAssertMetaInternalItem m_qassert_meta_items[];
+
+//source locations as written, terminated by an item with a NULL module.
+//linked only into qassert-meta-gen, from qassert_meta_add_library LOCATIONS
+//(qassert-meta-extract --locations) or qassert-meta-no-locations.c.
 typedef struct {
     const char * module;
     int id;
-    QAssertMetaDescription description;
-} QAssertMetaInternalItem;
+    QAssertMetaLocation location;
+} QAssertMetaLocationItem;
 
-//actual data at either qpc or qpcpp file, based on build options.
-extern QAssertMetaInternalItem m_qassert_meta_items[];
+extern const QAssertMetaLocationItem m_qassert_meta_location_items[];
+
+//compact source location of an m_qassert_meta_items entry.
+typedef struct {
+    uint16_t file;     //index into m_qassert_meta_location_files + 1, 0 if no location
+    uint16_t function; //index into m_qassert_meta_location_functions + 1, 0 if unknown
+    uint32_t line;
+} QAssertMetaLocationRecord;
+
+//generated at build time by qassert-meta-gen, records parallel to
+//m_qassert_meta_items, or NULL if built without locations.
+extern const QAssertMetaLocationRecord * const m_qassert_meta_locations;
+extern const char * const m_qassert_meta_location_files[];
+extern const char * const m_qassert_meta_location_functions[];
+
+//generated at build time by qassert-meta-gen: the weak per module override
+//tables (see qassert-meta-overrides.h), and the module of each m_qassert_meta_items entry.
+extern const QAssertMetaItem * const m_qassert_meta_module_overrides[];
+extern const uint16_t m_qassert_meta_item_modules[];
+
+//a slot of a registered table's hash index, see QAssertMetaRegisterIndexedTable.
+typedef struct {
+    uint32_t hash;
+    uint32_t item; //index into the table + 1, 0 if the slot is empty
+} QAssertMetaIndexSlot;
+
+//hash index of m_qassert_meta_items, generated at build time by qassert-meta-gen.
+//at most half full, the slot count is m_qassert_meta_builtin_index_mask + 1.
+extern const QAssertMetaIndexSlot m_qassert_meta_builtin_index[];
+extern const uint32_t m_qassert_meta_builtin_index_mask;
+
+//the internal table entry of a module/id pair, found via the generated index, or NULL.
+const QAssertMetaItem * QAssertMetaPrivateSearchBuiltin(const char * module, size_t length, int id);
+
+//QAssertMetaGetDescriptionN without the unknown callback: the internal, application and registered tables.
+bool QAssertMetaPrivateSearchTables(const char * module, size_t length, int id, QAssertMetaDescription* output);
+
+//an internal table item as looked up, that is its link time override if any.
+const QAssertMetaItem * QAssertMetaPrivateBuiltinEntry(const QAssertMetaItem * item);
+
+//access to the tables registered via QAssertMetaRegisterTable,
+//for use by other modules of this library.
+size_t QAssertMetaPrivateRegisteredTableCount(void);
+const QAssertMetaItem * QAssertMetaPrivateRegisteredTable(size_t index);
+
+//@return: true if either kind of unknown callback is registered.
+bool QAssertMetaPrivateHasUnknownCallback(void);
+
+//call the unknown context callback, then the unknown callback, until one describes the pair.
+bool QAssertMetaPrivateCallUnknown(const char * module, int id, QAssertMetaLookupContext * context,
+                                  QAssertMetaDescription* output);
+
+//the tables searched after the internal table, in lookup order: the
+//application table (index 0), then registered table n at index n + 1.
+typedef struct {
+    const QAssertMetaItem * items;
+    size_t itemCount;
+    bool indexed;
+} QAssertMetaTableInfo;
+
+//@return: false if there is no such table.
+bool QAssertMetaPrivateGetTable(size_t index, QAssertMetaTableInfo * info);
+
+//the first item of the module/id pair in a table, via its index if it has one, or NULL.
+const QAssertMetaItem * QAssertMetaPrivateSearchTable(size_t index, const char * module, size_t length, int id);
+
+/**
+ * The reference lookup engine: a plain linear scan of the internal table
+ * (and its module's link time override), the application table, then each
+ * registered table (ignoring any index), then the unknown callback.
+ * Optimized lookup structures must return exactly what this returns.
+ */
+bool QAssertMetaPrivateReferenceGetDescription(const char * module, int id, QAssertMetaDescription* output);
+
+/**
+ * @return: true if the terminated name equals the module slice of length bytes.
+ *          Reads name no further than its terminator.
+ */
+static inline bool QAssertMetaPrivateModuleEquals(const char * name, const char * module, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        if ((name[i] != module[i]) || (name[i] == '\0'))
+        {
+            return false;
+        }
+    }
+    return name[length] == '\0';
+}
+
+/**
+ * 32 bit FNV-1a hash of a module/id pair. The module bytes are hashed
+ * followed by the id as 4 little endian bytes. This hash is persisted
+ * by the binary database format, do not change without bumping
+ * the database version.
+ */
+static inline uint32_t QAssertMetaPrivateHash(const char * module, size_t length, int id)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash ^= (uint8_t)module[i];
+        hash *= 16777619u;
+    }
+
+    uint32_t uid = (uint32_t)id;
+    for (int i = 0; i < 4; ++i)
+    {
+        hash ^= (uid >> (8 * i)) & 0xFFu;
+        hash *= 16777619u;
+    }
+    return hash;
+}
 
 #endif //QASSERT_META_QASSERT_META_PRIVATE_H
@@ -0,0 +1,204 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "qassert-meta-recorder.h"
+#include "qassert-meta-overrides.h"
+#include "qassert-meta-private.h"
+#include <string.h>
+
+#define RECORDER_MAGIC 0x52414D51u //"QMAR"
+
+static QAssertMetaRecorderHeader * m_recorder = NULL;
+
+static QAssertMetaRecord * Records(QAssertMetaRecorderHeader * header)
+{
+    return (QAssertMetaRecord *)(header + 1);
+}
+
+static uint32_t HeaderCheck(const QAssertMetaRecorderHeader * header)
+{
+    return ~(header->magic ^ (header->capacity * 0x9E3779B1u));
+}
+
+static uint32_t Mix(uint32_t hash, uint32_t value)
+{
+    return (hash ^ value) * 0x9E3779B1u;
+}
+
+static uint16_t RecordCheck(const QAssertMetaRecord * record)
+{
+    uint32_t hash = Mix(RECORDER_MAGIC, record->module);
+    hash = Mix(hash, (uint32_t)record->id);
+    hash = Mix(hash, record->sequence);
+    hash = Mix(hash, record->timestamp);
+    hash = Mix(hash, record->pc);
+    hash = Mix(hash, record->lr);
+    return (uint16_t)(hash ^ (hash >> 16));
+}
+
+//the record of sequence, if valid
+static const QAssertMetaRecord * ValidRecord(QAssertMetaRecorderHeader * header, uint32_t sequence)
+{
+    const QAssertMetaRecord * record = &Records(header)[sequence % header->capacity];
+    if ((record->sequence != sequence) || (record->check != RecordCheck(record)))
+    {
+        return NULL;
+    }
+    return record;
+}
+
+static uint32_t OldestSequence(const QAssertMetaRecorderHeader * header)
+{
+    return (header->next > header->capacity) ? (header->next - header->capacity) : 0;
+}
+
+size_t QAssertMetaRecorderInit(void * storage, size_t size)
+{
+    m_recorder = NULL;
+    if ((NULL == storage) || (size < QASSERT_META_RECORDER_SIZE(1)))
+    {
+        return 0;
+    }
+
+    QAssertMetaRecorderHeader * header = (QAssertMetaRecorderHeader *)storage;
+    uint32_t capacity = (uint32_t)((size - sizeof(QAssertMetaRecorderHeader)) / sizeof(QAssertMetaRecord));
+    if ((header->magic != RECORDER_MAGIC) || (header->capacity != capacity) || (header->check != HeaderCheck(header)))
+    {
+        memset(storage, 0, QASSERT_META_RECORDER_SIZE(capacity));
+        header->magic = RECORDER_MAGIC;
+        header->capacity = capacity;
+        header->check = HeaderCheck(header);
+        m_recorder = header;
+        return 0;
+    }
+
+    //a reset after writing a record, before counting it, leaves it uncounted
+    const QAssertMetaRecord * uncounted = &Records(header)[header->next % capacity];
+    if ((uncounted->sequence == header->next) && (uncounted->check == RecordCheck(uncounted)))
+    {
+        ++header->next;
+    }
+
+    size_t kept = 0;
+    for (uint32_t sequence = OldestSequence(header); sequence != header->next; ++sequence)
+    {
+        kept += (NULL != ValidRecord(header, sequence)) ? 1u : 0u;
+    }
+    m_recorder = header;
+    return kept;
+}
+
+void QAssertMetaRecordAssert(const char * module, int id, uint32_t timestamp, uint32_t pc, uint32_t lr)
+{
+    QAssertMetaRecorderHeader * header = m_recorder;
+    if (NULL == header)
+    {
+        return;
+    }
+
+    uint32_t sequence = header->next;
+    QAssertMetaRecord * record = &Records(header)[sequence % header->capacity];
+    record->module = QAssertMetaRecorderModuleCode(module);
+    record->id = (int32_t)id;
+    record->sequence = sequence;
+    record->timestamp = timestamp;
+    record->pc = pc;
+    record->lr = lr;
+    record->check = RecordCheck(record);
+    header->next = sequence + 1u;
+}
+
+size_t QAssertMetaRecorderRead(QAssertMetaRecord * output, size_t max)
+{
+    QAssertMetaRecorderHeader * header = m_recorder;
+    if ((NULL == header) || (NULL == output))
+    {
+        return 0;
+    }
+
+    size_t count = 0;
+    for (uint32_t sequence = OldestSequence(header); (sequence != header->next) && (count < max); ++sequence)
+    {
+        const QAssertMetaRecord * record = ValidRecord(header, sequence);
+        if (NULL != record)
+        {
+            output[count++] = *record;
+        }
+    }
+    return count;
+}
+
+void QAssertMetaRecorderClear(void)
+{
+    QAssertMetaRecorderHeader * header = m_recorder;
+    if (NULL != header)
+    {
+        memset(Records(header), 0, header->capacity * sizeof(QAssertMetaRecord));
+        header->next = 0;
+    }
+}
+
+uint16_t QAssertMetaRecorderModuleCode(const char * module)
+{
+    uint32_t hash = 2166136261u;
+    for (const char * c = (NULL != module) ? module : ""; *c != '\0'; ++c)
+    {
+        hash ^= (uint8_t)*c;
+        hash *= 16777619u;
+    }
+    return (uint16_t)(hash ^ (hash >> 16));
+}
+
+static const char * ResolveModule(const QAssertMetaItem * items, uint16_t code, int id)
+{
+    for (const QAssertMetaItem * item = items; (NULL != item) && (NULL != item->module); ++item)
+    {
+        if ((item->id == id) && (QAssertMetaRecorderModuleCode(item->module) == code))
+        {
+            return item->module;
+        }
+    }
+    return NULL;
+}
+
+bool QAssertMetaRecorderDescribe(const QAssertMetaRecord * record, const char ** module,
+                                 QAssertMetaDescription * output)
+{
+    if ((NULL == record) || (NULL == module) || (NULL == output))
+    {
+        return false;
+    }
+
+    //runs once after a reset, so the tables are scanned rather than indexed
+    const char * name = ResolveModule(m_qassert_meta_items, record->module, record->id);
+    if (NULL == name)
+    {
+        name = ResolveModule(qassert_meta_application_table.items, record->module, record->id);
+    }
+    for (size_t i = 0; (NULL == name) && (i < QAssertMetaPrivateRegisteredTableCount()); ++i)
+    {
+        name = ResolveModule(QAssertMetaPrivateRegisteredTable(i), record->module, record->id);
+    }
+
+    *module = name;
+    return (NULL != name) && QAssertMetaGetDescription(name, record->id, output);
+}
@@ -0,0 +1,74 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "qassert-meta-overrides.h"
+#include "qassert-meta-private.h"
+#include <string.h>
+
+static const QAssertMetaItem * ScanTable(const QAssertMetaItem * items, const char * module, int id)
+{
+    int i = 0;
+    while (items[i].module != NULL)
+    {
+        if (items[i].id == id)
+        {
+            if (0 == strcmp(module, items[i].module))
+            {
+                return &items[i];
+            }
+        }
+        ++i;
+    }
+    return NULL;
+}
+
+bool QAssertMetaPrivateReferenceGetDescription(const char * module, int id, QAssertMetaDescription* output)
+{
+    if ((NULL == output) || (NULL == module))
+    {
+        return false;
+    }
+
+    const QAssertMetaItem * item = ScanTable(m_qassert_meta_items, module, id);
+    if (item != NULL)
+    {
+        uint16_t itemModule = m_qassert_meta_item_modules[item - m_qassert_meta_items];
+        const QAssertMetaItem * replacement = ScanTable(m_qassert_meta_module_overrides[itemModule], module, id);
+        item = (replacement != NULL) ? replacement : item;
+    }
+    else if (qassert_meta_application_table.items != NULL)
+    {
+        item = ScanTable(qassert_meta_application_table.items, module, id);
+    }
+    for (size_t i = 0; (NULL == item) && (i < QAssertMetaPrivateRegisteredTableCount()); ++i)
+    {
+        item = ScanTable(QAssertMetaPrivateRegisteredTable(i), module, id);
+    }
+
+    if (item != NULL)
+    {
+        *output = item->description;
+        return true;
+    }
+
+    return QAssertMetaPrivateCallUnknown(module, id, NULL, output);
+}
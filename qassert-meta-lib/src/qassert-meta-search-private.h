@@ -0,0 +1,112 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_SEARCH_PRIVATE_H
+#define QASSERT_META_QASSERT_META_SEARCH_PRIVATE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+//tokens longer than this are truncated, identically at build and query time.
+#define QASSERT_META_SEARCH_MAX_TOKEN 32
+
+//weights of a token occurrence in the brief and tips text.
+#define QASSERT_META_SEARCH_BRIEF_WEIGHT 3
+#define QASSERT_META_SEARCH_TIPS_WEIGHT  1
+
+typedef struct {
+    const char * token;
+    uint16_t firstPosting;
+    uint16_t postingCount;
+} QAssertMetaSearchToken;
+
+typedef struct {
+    uint16_t item;   //index into m_qassert_meta_items
+    uint8_t weight;  //summed occurrence weights, saturated at 255
+} QAssertMetaSearchPosting;
+
+//generated at build time by qassert-meta-gen, tokens sorted by strcmp.
+extern const QAssertMetaSearchToken m_qassert_meta_search_tokens[];
+extern const size_t m_qassert_meta_search_token_count;
+extern const QAssertMetaSearchPosting m_qassert_meta_search_postings[];
+
+static inline bool QAssertMetaPrivateIsStopWord(const char * token)
+{
+    static const char * const stopWords[] = {
+        "an", "and", "are", "as", "at", "be", "by", "for", "from", "if", "in",
+        "is", "it", "of", "on", "or", "that", "the", "this", "to", "was", "with"
+    };
+
+    for (size_t i = 0; i < (sizeof(stopWords) / sizeof(stopWords[0])); ++i)
+    {
+        if (0 == strcmp(token, stopWords[i]))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Extract the next search token from text, lower cased into output.
+ * Tokens are runs of letters, digits and '_', at least two characters long
+ * and not a stop word. Shared by the index generator and queries.
+ * @return: the token length, 0 when the text is exhausted.
+ */
+static inline size_t QAssertMetaPrivateNextToken(const char ** cursor, char output[QASSERT_META_SEARCH_MAX_TOKEN + 1])
+{
+    const char * p = *cursor;
+    while (*p != '\0')
+    {
+        size_t length = 0;
+        while ((*p != '\0') &&
+               !(((*p >= 'a') && (*p <= 'z')) || ((*p >= 'A') && (*p <= 'Z')) ||
+                 ((*p >= '0') && (*p <= '9')) || (*p == '_')))
+        {
+            ++p;
+        }
+
+        while (((*p >= 'a') && (*p <= 'z')) || ((*p >= 'A') && (*p <= 'Z')) ||
+               ((*p >= '0') && (*p <= '9')) || (*p == '_'))
+        {
+            if (length < QASSERT_META_SEARCH_MAX_TOKEN)
+            {
+                output[length++] = ((*p >= 'A') && (*p <= 'Z')) ? (char)(*p - 'A' + 'a') : *p;
+            }
+            ++p;
+        }
+        output[length] = '\0';
+
+        if ((length >= 2) && !QAssertMetaPrivateIsStopWord(output))
+        {
+            *cursor = p;
+            return length;
+        }
+    }
+
+    *cursor = p;
+    return 0;
+}
+
+#endif //QASSERT_META_QASSERT_META_SEARCH_PRIVATE_H
@@ -0,0 +1,225 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "qassert-meta-search.h"
+#include "qassert-meta-search-private.h"
+#include "qassert-meta-overrides.h"
+#include "qassert-meta-private.h"
+#include "qassert-meta-generated.h"
+#include <string.h>
+
+//query terms beyond this are ignored
+#define MAX_QUERY_TERMS 16
+
+//exact term matches score this many times a prefix match
+#define EXACT_MATCH_FACTOR 2
+
+typedef struct {
+    uint16_t score;
+    uint16_t terms; //bit per matched query term
+} ItemScore;
+
+/**
+ * Find the range of index tokens beginning with prefix.
+ * @return: the index of the first such token, *count set to the range length.
+ */
+static size_t FindPrefixRange(const char * prefix, size_t length, size_t * count)
+{
+    size_t low = 0;
+    size_t high = m_qassert_meta_search_token_count;
+    while (low < high)
+    {
+        size_t mid = low + ((high - low) / 2);
+        if (strncmp(m_qassert_meta_search_tokens[mid].token, prefix, length) < 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    size_t end = low;
+    while ((end < m_qassert_meta_search_token_count) &&
+           (0 == strncmp(m_qassert_meta_search_tokens[end].token, prefix, length)))
+    {
+        ++end;
+    }
+    *count = end - low;
+    return low;
+}
+
+static unsigned CountBits(uint16_t value)
+{
+    unsigned count = 0;
+    while (value != 0)
+    {
+        value &= (uint16_t)(value - 1u);
+        ++count;
+    }
+    return count;
+}
+
+//candidates are inserted in table order, so ties keep table order
+static bool RanksHigher(const QAssertMetaSearchResult * lhs, const QAssertMetaSearchResult * rhs)
+{
+    if (lhs->matchedTerms != rhs->matchedTerms)
+    {
+        return lhs->matchedTerms > rhs->matchedTerms;
+    }
+    return lhs->score > rhs->score;
+}
+
+//keep the best maxResults, by insertion into the sorted results
+static void InsertResult(QAssertMetaSearchResult * results, size_t * count, size_t maxResults,
+                         const QAssertMetaSearchResult * candidate)
+{
+    size_t position = *count;
+    while ((position > 0) && RanksHigher(candidate, &results[position - 1]))
+    {
+        --position;
+    }
+    if (position >= maxResults)
+    {
+        return;
+    }
+
+    size_t last = (*count < maxResults) ? *count : (maxResults - 1);
+    memmove(&results[position + 1], &results[position], (last - position) * sizeof(QAssertMetaSearchResult));
+    results[position] = *candidate;
+    if (*count < maxResults)
+    {
+        ++(*count);
+    }
+}
+
+/**
+ * Score text not in the generated index (link time overrides and the
+ * application table) as the index would have.
+ */
+static void ScoreText(const char * text, unsigned weight, char terms[][QASSERT_META_SEARCH_MAX_TOKEN + 1],
+                      size_t termCount, ItemScore * score)
+{
+    char token[QASSERT_META_SEARCH_MAX_TOKEN + 1];
+    const char * cursor = text;
+    while ((NULL != text) && (QAssertMetaPrivateNextToken(&cursor, token) != 0))
+    {
+        for (size_t t = 0; t < termCount; ++t)
+        {
+            size_t length = strlen(terms[t]);
+            if (0 == strncmp(token, terms[t], length))
+            {
+                unsigned factor = (token[length] == '\0') ? EXACT_MATCH_FACTOR : 1u;
+                unsigned total = score->score + (weight * factor);
+                score->score = (total > UINT16_MAX) ? UINT16_MAX : (uint16_t)total;
+                score->terms |= (uint16_t)(1u << t);
+            }
+        }
+    }
+}
+
+static void ScoreItem(const QAssertMetaItem * item, char terms[][QASSERT_META_SEARCH_MAX_TOKEN + 1], size_t termCount,
+                      ItemScore * score)
+{
+    score->score = 0;
+    score->terms = 0;
+    ScoreText(item->description.brief, QASSERT_META_SEARCH_BRIEF_WEIGHT, terms, termCount, score);
+    ScoreText(item->description.tips, QASSERT_META_SEARCH_TIPS_WEIGHT, terms, termCount, score);
+}
+
+size_t QAssertMetaSearch(const char * query, QAssertMetaSearchResult * results, size_t maxResults)
+{
+    if ((NULL == query) || (NULL == results) || (0 == maxResults))
+    {
+        return 0;
+    }
+
+    ItemScore scores[QASSERT_META_BUILTIN_ITEM_COUNT + 1]; //+1, never a zero length array
+    memset(scores, 0, sizeof(scores));
+
+    char terms[MAX_QUERY_TERMS][QASSERT_META_SEARCH_MAX_TOKEN + 1];
+    size_t termCount = 0;
+    char token[QASSERT_META_SEARCH_MAX_TOKEN + 1];
+    const char * cursor = query;
+    size_t length;
+    while ((termCount < MAX_QUERY_TERMS) && ((length = QAssertMetaPrivateNextToken(&cursor, token)) != 0))
+    {
+        bool duplicate = false;
+        for (size_t t = 0; t < termCount; ++t)
+        {
+            duplicate = duplicate || (0 == strcmp(terms[t], token));
+        }
+        if (duplicate)
+        {
+            continue;
+        }
+        memcpy(terms[termCount], token, length + 1);
+
+        size_t count;
+        size_t first = FindPrefixRange(token, length, &count);
+        for (size_t t = first; t < (first + count); ++t)
+        {
+            const QAssertMetaSearchToken * indexToken = &m_qassert_meta_search_tokens[t];
+            unsigned factor = (indexToken->token[length] == '\0') ? EXACT_MATCH_FACTOR : 1u;
+            for (size_t p = 0; p < indexToken->postingCount; ++p)
+            {
+                const QAssertMetaSearchPosting * posting =
+                    &m_qassert_meta_search_postings[indexToken->firstPosting + p];
+                ItemScore * score = &scores[posting->item];
+                unsigned total = score->score + (posting->weight * factor);
+                score->score = (total > UINT16_MAX) ? UINT16_MAX : (uint16_t)total;
+                score->terms |= (uint16_t)(1u << termCount);
+            }
+        }
+        ++termCount;
+    }
+
+    //the items as looked up: overridden text is scored here, not by the index
+    size_t resultCount = 0;
+    for (size_t i = 0; i < QASSERT_META_BUILTIN_ITEM_COUNT; ++i)
+    {
+        const QAssertMetaItem * item = QAssertMetaPrivateBuiltinEntry(&m_qassert_meta_items[i]);
+        if (item != &m_qassert_meta_items[i])
+        {
+            ScoreItem(item, terms, termCount, &scores[i]);
+        }
+        if (0 != scores[i].terms)
+        {
+            QAssertMetaSearchResult candidate = {item, CountBits(scores[i].terms), scores[i].score};
+            InsertResult(results, &resultCount, maxResults, &candidate);
+        }
+    }
+
+    const QAssertMetaItem * application = qassert_meta_application_table.items;
+    for (size_t i = 0; (NULL != application) && (NULL != application[i].module); ++i)
+    {
+        ItemScore score;
+        ScoreItem(&application[i], terms, termCount, &score);
+        if (0 != score.terms)
+        {
+            QAssertMetaSearchResult candidate = {&application[i], CountBits(score.terms), score.score};
+            InsertResult(results, &resultCount, maxResults, &candidate);
+        }
+    }
+    return resultCount;
+}
@@ -0,0 +1,80 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_SERIALIZE_PRIVATE_H
+#define QASSERT_META_QASSERT_META_SERIALIZE_PRIVATE_H
+
+#include "qassert-meta-serialize.h"
+#include <stddef.h>
+#include <stdint.h>
+
+//an entry serialized as JSON, as written by QAssertMetaSerializeEntry.
+typedef struct {
+    uint32_t length;
+    const char * text;
+} QAssertMetaJsonText;
+
+//generated at build time by qassert-meta-gen, the JSON of each m_qassert_meta_items entry.
+extern const QAssertMetaJsonText m_qassert_meta_json_items[];
+
+/**
+ * The JSON escape sequence of a string byte, shared by the serializer and
+ * the generator so both escape identically.
+ * @return: the length of the sequence written to escape, or 0 if the byte
+ *          is written as is.
+ */
+static inline size_t QAssertMetaPrivateJsonEscape(uint8_t c, char escape[6])
+{
+    static const char HEX[] = "0123456789abcdef";
+    char shorthand = '\0';
+    switch (c)
+    {
+        case '"':  shorthand = '"';  break;
+        case '\\': shorthand = '\\'; break;
+        case '\b': shorthand = 'b';  break;
+        case '\f': shorthand = 'f';  break;
+        case '\n': shorthand = 'n';  break;
+        case '\r': shorthand = 'r';  break;
+        case '\t': shorthand = 't';  break;
+        default:
+            if (c >= 0x20u)
+            {
+                return 0;
+            }
+            break;
+    }
+
+    escape[0] = '\\';
+    if (shorthand != '\0')
+    {
+        escape[1] = shorthand;
+        return 2;
+    }
+    escape[1] = 'u';
+    escape[2] = '0';
+    escape[3] = '0';
+    escape[4] = HEX[c >> 4];
+    escape[5] = HEX[c & 0x0Fu];
+    return 6;
+}
+
+#endif //QASSERT_META_QASSERT_META_SERIALIZE_PRIVATE_H
@@ -0,0 +1,448 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L //write
+#endif
+
+#include "qassert-meta-serialize.h"
+#include "qassert-meta-serialize-private.h"
+#include "qassert-meta-overrides.h"
+#include "qassert-meta-private.h"
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <errno.h>
+#include <unistd.h>
+#endif
+
+#define CBOR_UNSIGNED        0x00u
+#define CBOR_NEGATIVE        0x20u
+#define CBOR_TEXT            0x60u
+#define CBOR_MAP             0xA0u
+#define CBOR_ARRAY_UNBOUNDED 0x9Fu
+#define CBOR_BREAK           0xFFu
+
+static void FlushBuffer(QAssertMetaSerializer * serializer)
+{
+    if ((NULL == serializer->flush) ||
+        !serializer->flush(serializer->buffer, serializer->used, serializer->context))
+    {
+        serializer->failed = true;
+        return;
+    }
+    serializer->flushed += serializer->used;
+    serializer->used = 0;
+}
+
+static void Put(QAssertMetaSerializer * serializer, const void * data, size_t size)
+{
+    if (size <= (serializer->size - serializer->used))
+    {
+        memcpy(&serializer->buffer[serializer->used], data, size);
+        serializer->used += size;
+        return;
+    }
+
+    const uint8_t * bytes = data;
+    while ((!serializer->failed) && (size > 0))
+    {
+        size_t room = serializer->size - serializer->used;
+        if (0 == room)
+        {
+            FlushBuffer(serializer);
+            continue;
+        }
+
+        size_t chunk = (size < room) ? size : room;
+        memcpy(&serializer->buffer[serializer->used], bytes, chunk);
+        serializer->used += chunk;
+        bytes += chunk;
+        size -= chunk;
+    }
+}
+
+//bytes ending an array, kept free in a buffer without flush
+static size_t ArrayEndSize(const QAssertMetaSerializer * serializer)
+{
+    return (QASSERT_META_SERIALIZE_JSON == serializer->format) ? 2u : 1u;
+}
+
+static void PutByte(QAssertMetaSerializer * serializer, uint8_t byte)
+{
+    Put(serializer, &byte, 1);
+}
+
+static void PutJsonString(QAssertMetaSerializer * serializer, const char * text)
+{
+    PutByte(serializer, '"');
+    const uint8_t * run = (const uint8_t *)text;
+    const uint8_t * p = run;
+    for (; *p != '\0'; ++p)
+    {
+        if ((*p >= 0x20u) && (*p != '"') && (*p != '\\'))
+        {
+            continue;
+        }
+
+        char escape[6];
+        size_t length = QAssertMetaPrivateJsonEscape(*p, escape);
+        Put(serializer, run, (size_t)(p - run));
+        Put(serializer, escape, length);
+        run = p + 1;
+    }
+    Put(serializer, run, (size_t)(p - run));
+    PutByte(serializer, '"');
+}
+
+static void PutJsonInt(QAssertMetaSerializer * serializer, int value)
+{
+    char digits[12];
+    size_t first = sizeof(digits);
+    uint32_t magnitude = (value < 0) ? (0u - (uint32_t)value) : (uint32_t)value;
+    do
+    {
+        digits[--first] = (char)('0' + (magnitude % 10u));
+        magnitude /= 10u;
+    } while (magnitude != 0);
+
+    if (value < 0)
+    {
+        digits[--first] = '-';
+    }
+    Put(serializer, &digits[first], sizeof(digits) - first);
+}
+
+static void PutJsonEntry(QAssertMetaSerializer * serializer, const char * module, int id,
+                         const QAssertMetaDescription * description)
+{
+    Put(serializer, "{\"module\":", 10);
+    PutJsonString(serializer, module);
+    Put(serializer, ",\"id\":", 6);
+    PutJsonInt(serializer, id);
+    if (NULL != description->brief)
+    {
+        Put(serializer, ",\"brief\":", 9);
+        PutJsonString(serializer, description->brief);
+    }
+    if (NULL != description->tips)
+    {
+        Put(serializer, ",\"tips\":", 8);
+        PutJsonString(serializer, description->tips);
+    }
+    if (NULL != description->url)
+    {
+        Put(serializer, ",\"url\":", 7);
+        PutJsonString(serializer, description->url);
+    }
+    PutByte(serializer, '}');
+}
+
+static void PutCborHead(QAssertMetaSerializer * serializer, uint8_t major, uint64_t value)
+{
+    uint8_t head[9];
+    size_t size;
+    if (value < 24u)
+    {
+        head[0] = (uint8_t)(major | value);
+        size = 1;
+    }
+    else
+    {
+        //1, 2, 4 or 8 byte big endian argument, additional information 24 to 27
+        unsigned exponent = (value <= 0xFFu) ? 0u : (value <= 0xFFFFu) ? 1u : (value <= 0xFFFFFFFFu) ? 2u : 3u;
+        size_t bytes = (size_t)1u << exponent;
+        head[0] = (uint8_t)(major | (24u + exponent));
+        for (size_t i = 0; i < bytes; ++i)
+        {
+            head[bytes - i] = (uint8_t)(value >> (8u * i));
+        }
+        size = bytes + 1u;
+    }
+    Put(serializer, head, size);
+}
+
+static void PutCborText(QAssertMetaSerializer * serializer, const char * text)
+{
+    size_t length = strlen(text);
+    PutCborHead(serializer, CBOR_TEXT, length);
+    Put(serializer, text, length);
+}
+
+static void PutCborEntry(QAssertMetaSerializer * serializer, const char * module, int id,
+                         const QAssertMetaDescription * description)
+{
+    unsigned pairs = 2u + ((NULL != description->brief) ? 1u : 0u) + ((NULL != description->tips) ? 1u : 0u) +
+                     ((NULL != description->url) ? 1u : 0u);
+    PutCborHead(serializer, CBOR_MAP, pairs);
+    Put(serializer, "\x66" "module", 7);
+    PutCborText(serializer, module);
+    Put(serializer, "\x62" "id", 3);
+    if (id >= 0)
+    {
+        PutCborHead(serializer, CBOR_UNSIGNED, (uint64_t)id);
+    }
+    else
+    {
+        PutCborHead(serializer, CBOR_NEGATIVE, (uint64_t)(-1 - (int64_t)id));
+    }
+    if (NULL != description->brief)
+    {
+        Put(serializer, "\x65" "brief", 6);
+        PutCborText(serializer, description->brief);
+    }
+    if (NULL != description->tips)
+    {
+        Put(serializer, "\x64" "tips", 5);
+        PutCborText(serializer, description->tips);
+    }
+    if (NULL != description->url)
+    {
+        Put(serializer, "\x63" "url", 4);
+        PutCborText(serializer, description->url);
+    }
+}
+
+/**
+ * Write an entry, either serialized now or as precomputed JSON. Without a
+ * flush function, an entry that does not fit (with the end of an open
+ * array) is removed again, leaving the buffer holding whole entries, and
+ * later entries are refused.
+ */
+static bool WriteEntry(QAssertMetaSerializer * serializer, const char * module, int id,
+                       const QAssertMetaDescription * description, const QAssertMetaJsonText * json)
+{
+    if (serializer->failed || serializer->truncated)
+    {
+        return false;
+    }
+
+    size_t mark = serializer->used;
+    bool isJson = (QASSERT_META_SERIALIZE_JSON == serializer->format);
+    if (serializer->inArray && (!serializer->arrayEmpty) && isJson)
+    {
+        PutByte(serializer, ',');
+    }
+
+    if (NULL != json)
+    {
+        Put(serializer, json->text, json->length);
+    }
+    else if (isJson)
+    {
+        PutJsonEntry(serializer, module, id, description);
+    }
+    else
+    {
+        PutCborEntry(serializer, module, id, description);
+    }
+
+    if ((!serializer->inArray) && isJson)
+    {
+        PutByte(serializer, '\n');
+    }
+
+    if (NULL == serializer->flush)
+    {
+        size_t reserved = serializer->inArray ? ArrayEndSize(serializer) : 0u;
+        if (serializer->failed || ((serializer->size - serializer->used) < reserved))
+        {
+            serializer->used = mark;
+            serializer->failed = false;
+            serializer->truncated = true;
+        }
+    }
+
+    if (serializer->failed || serializer->truncated)
+    {
+        return false;
+    }
+    serializer->arrayEmpty = false;
+    ++serializer->entries;
+    return true;
+}
+
+void QAssertMetaSerializerInit(QAssertMetaSerializer * serializer, QAssertMetaSerializeFormat format,
+                               void * buffer, size_t size, QAssertMetaSerializeFlush flush, void * context)
+{
+    if (NULL == serializer)
+    {
+        return;
+    }
+
+    serializer->format = format;
+    serializer->buffer = buffer;
+    serializer->size = (NULL != buffer) ? size : 0;
+    serializer->used = 0;
+    serializer->flush = flush;
+    serializer->context = context;
+    serializer->fd = -1;
+    serializer->flushed = 0;
+    serializer->entries = 0;
+    serializer->inArray = false;
+    serializer->arrayEmpty = true;
+    serializer->truncated = false;
+    serializer->failed = (0 == serializer->size);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+static bool WriteFd(const uint8_t * data, size_t size, void * context)
+{
+    const QAssertMetaSerializer * serializer = context;
+    while (size > 0)
+    {
+        ssize_t written = write(serializer->fd, data, size);
+        if (written < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= (size_t)written;
+    }
+    return true;
+}
+
+void QAssertMetaSerializerInitFd(QAssertMetaSerializer * serializer, QAssertMetaSerializeFormat format,
+                                 void * buffer, size_t size, int fd)
+{
+    QAssertMetaSerializerInit(serializer, format, buffer, size, WriteFd, serializer);
+    if (NULL != serializer)
+    {
+        serializer->fd = fd;
+    }
+}
+#endif
+
+bool QAssertMetaSerializeBeginArray(QAssertMetaSerializer * serializer)
+{
+    if ((NULL == serializer) || serializer->failed || serializer->truncated || serializer->inArray)
+    {
+        return false;
+    }
+    if ((NULL == serializer->flush) && ((serializer->size - serializer->used) < (1u + ArrayEndSize(serializer))))
+    {
+        serializer->truncated = true;
+        return false;
+    }
+
+    PutByte(serializer, (QASSERT_META_SERIALIZE_JSON == serializer->format) ? '[' : CBOR_ARRAY_UNBOUNDED);
+    serializer->inArray = true;
+    serializer->arrayEmpty = true;
+    return !serializer->failed;
+}
+
+bool QAssertMetaSerializeEndArray(QAssertMetaSerializer * serializer)
+{
+    if ((NULL == serializer) || serializer->failed || (!serializer->inArray))
+    {
+        return false;
+    }
+
+    if (QASSERT_META_SERIALIZE_JSON == serializer->format)
+    {
+        Put(serializer, "]\n", 2);
+    }
+    else
+    {
+        PutByte(serializer, CBOR_BREAK);
+    }
+    serializer->inArray = false;
+    return !serializer->failed;
+}
+
+bool QAssertMetaSerializeEntry(QAssertMetaSerializer * serializer, const char * module, int id,
+                               const QAssertMetaDescription * description)
+{
+    if ((NULL == serializer) || (NULL == module) || (NULL == description))
+    {
+        return false;
+    }
+    return WriteEntry(serializer, module, id, description, NULL);
+}
+
+bool QAssertMetaSerializeItems(QAssertMetaSerializer * serializer, const QAssertMetaItem * items, size_t count)
+{
+    if ((NULL == serializer) || (NULL == items))
+    {
+        return false;
+    }
+
+    bool ok = !(serializer->failed || serializer->truncated);
+    for (size_t i = 0; ok && (i < count) && (NULL != items[i].module); ++i)
+    {
+        ok = WriteEntry(serializer, items[i].module, items[i].id, &items[i].description, NULL);
+    }
+    return ok;
+}
+
+bool QAssertMetaSerializeAll(QAssertMetaSerializer * serializer)
+{
+    if (NULL == serializer)
+    {
+        return false;
+    }
+
+    //internal table entries without an override are copied as generated
+    bool isJson = (QASSERT_META_SERIALIZE_JSON == serializer->format);
+    bool ok = !(serializer->failed || serializer->truncated);
+    for (size_t i = 0; ok && (NULL != m_qassert_meta_items[i].module); ++i)
+    {
+        const QAssertMetaItem * item = &m_qassert_meta_items[i];
+        const QAssertMetaItem * entry = QAssertMetaPrivateBuiltinEntry(item);
+        const QAssertMetaJsonText * json = (isJson && (entry == item)) ? &m_qassert_meta_json_items[i] : NULL;
+        ok = WriteEntry(serializer, item->module, item->id, &entry->description, json);
+    }
+
+    if (ok && (NULL != qassert_meta_application_table.items))
+    {
+        ok = QAssertMetaSerializeItems(serializer, qassert_meta_application_table.items, SIZE_MAX);
+    }
+
+    for (size_t t = 0; ok && (t < QAssertMetaPrivateRegisteredTableCount()); ++t)
+    {
+        ok = QAssertMetaSerializeItems(serializer, QAssertMetaPrivateRegisteredTable(t), SIZE_MAX);
+    }
+    return ok;
+}
+
+bool QAssertMetaSerializeFinish(QAssertMetaSerializer * serializer)
+{
+    if (NULL == serializer)
+    {
+        return false;
+    }
+
+    if ((!serializer->failed) && (serializer->used > 0) && (NULL != serializer->flush))
+    {
+        FlushBuffer(serializer);
+    }
+    return !(serializer->failed || serializer->truncated);
+}
+
+uint64_t QAssertMetaSerializedBytes(const QAssertMetaSerializer * serializer)
+{
+    return (NULL != serializer) ? (serializer->flushed + serializer->used) : 0u;
+}
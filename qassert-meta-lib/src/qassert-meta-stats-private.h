@@ -0,0 +1,57 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_STATS_PRIVATE_H
+#define QASSERT_META_QASSERT_META_STATS_PRIVATE_H
+
+#include "qassert-meta-stats.h"
+
+#if QASSERT_META_ENABLE_STATS
+
+#include "qassert-meta-generated.h"
+#include <stdatomic.h>
+
+typedef struct {
+    atomic_uint_least32_t lookups;
+    atomic_uint_least32_t nullArgumentRejections;
+    atomic_uint_least32_t builtinHits;
+    atomic_uint_least32_t applicationHits;
+    atomic_uint_least32_t registeredHits;
+    atomic_uint_least32_t unknownCallbackCalls;
+    atomic_uint_least32_t unknownCallbackHits;
+    atomic_uint_least32_t misses;
+    atomic_uint_least32_t registeredTableHits[QASSERT_META_MAX_REGISTERED_TABLES];
+    atomic_uint_least32_t builtinEntryHits[QASSERT_META_BUILTIN_ITEM_COUNT + 1]; //+1, never a zero length array
+} QAssertMetaStatsData;
+
+extern QAssertMetaStatsData m_qassert_meta_stats;
+
+#define QASSERT_META_STATS_INCREMENT(counter) \
+    ((void)atomic_fetch_add_explicit(&m_qassert_meta_stats.counter, 1u, memory_order_relaxed))
+
+#else
+
+#define QASSERT_META_STATS_INCREMENT(counter) ((void)0)
+
+#endif //QASSERT_META_ENABLE_STATS
+
+#endif //QASSERT_META_QASSERT_META_STATS_PRIVATE_H
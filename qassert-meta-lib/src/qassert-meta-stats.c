@@ -0,0 +1,125 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "qassert-meta-stats.h"
+#include "qassert-meta-stats-private.h"
+#include "qassert-meta-private.h"
+
+#if QASSERT_META_ENABLE_STATS
+
+QAssertMetaStatsData m_qassert_meta_stats;
+
+static uint32_t Load(const atomic_uint_least32_t * counter)
+{
+    return (uint32_t)atomic_load_explicit(counter, memory_order_relaxed);
+}
+
+static void Clear(atomic_uint_least32_t * counter)
+{
+    atomic_store_explicit(counter, 0u, memory_order_relaxed);
+}
+
+bool QAssertMetaStatsGetCounters(QAssertMetaStatsCounters * counters)
+{
+    if (NULL == counters)
+    {
+        return false;
+    }
+
+    counters->lookups = Load(&m_qassert_meta_stats.lookups);
+    counters->nullArgumentRejections = Load(&m_qassert_meta_stats.nullArgumentRejections);
+    counters->builtinHits = Load(&m_qassert_meta_stats.builtinHits);
+    counters->applicationHits = Load(&m_qassert_meta_stats.applicationHits);
+    counters->registeredHits = Load(&m_qassert_meta_stats.registeredHits);
+    counters->unknownCallbackCalls = Load(&m_qassert_meta_stats.unknownCallbackCalls);
+    counters->unknownCallbackHits = Load(&m_qassert_meta_stats.unknownCallbackHits);
+    counters->misses = Load(&m_qassert_meta_stats.misses);
+    for (size_t i = 0; i < QASSERT_META_MAX_REGISTERED_TABLES; ++i)
+    {
+        counters->registeredTableHits[i] = Load(&m_qassert_meta_stats.registeredTableHits[i]);
+    }
+    return true;
+}
+
+size_t QAssertMetaStatsForEachEntry(QAssertMetaStatsEntryVisitor visitor, void * context)
+{
+    if (NULL == visitor)
+    {
+        return 0;
+    }
+
+    size_t visited = 0;
+    for (size_t i = 0; i < QASSERT_META_BUILTIN_ITEM_COUNT; ++i)
+    {
+        uint32_t hits = Load(&m_qassert_meta_stats.builtinEntryHits[i]);
+        if (hits != 0)
+        {
+            ++visited;
+            if (!visitor(&m_qassert_meta_items[i], hits, context))
+            {
+                break;
+            }
+        }
+    }
+    return visited;
+}
+
+void QAssertMetaStatsReset(void)
+{
+    Clear(&m_qassert_meta_stats.lookups);
+    Clear(&m_qassert_meta_stats.nullArgumentRejections);
+    Clear(&m_qassert_meta_stats.builtinHits);
+    Clear(&m_qassert_meta_stats.applicationHits);
+    Clear(&m_qassert_meta_stats.registeredHits);
+    Clear(&m_qassert_meta_stats.unknownCallbackCalls);
+    Clear(&m_qassert_meta_stats.unknownCallbackHits);
+    Clear(&m_qassert_meta_stats.misses);
+    for (size_t i = 0; i < QASSERT_META_MAX_REGISTERED_TABLES; ++i)
+    {
+        Clear(&m_qassert_meta_stats.registeredTableHits[i]);
+    }
+    for (size_t i = 0; i < QASSERT_META_BUILTIN_ITEM_COUNT; ++i)
+    {
+        Clear(&m_qassert_meta_stats.builtinEntryHits[i]);
+    }
+}
+
+#else
+
+bool QAssertMetaStatsGetCounters(QAssertMetaStatsCounters * counters)
+{
+    (void)counters;
+    return false;
+}
+
+size_t QAssertMetaStatsForEachEntry(QAssertMetaStatsEntryVisitor visitor, void * context)
+{
+    (void)visitor;
+    (void)context;
+    return 0;
+}
+
+void QAssertMetaStatsReset(void)
+{
+}
+
+#endif //QASSERT_META_ENABLE_STATS
@@ -21,15 +21,172 @@
 // SOFTWARE.
 
 #include "qassert-meta.h"
+#include "qassert-meta-overrides.h"
 #include "qassert-meta-private.h"
+#include "qassert-meta-stats-private.h"
+#include "qassert-meta-latency-private.h"
 #include <stddef.h>
 #include <string.h>
 
+//Indexes of registered tables are built once, by the first lookup reaching
+//the table. Lookups racing with the build scan the table instead.
+#ifndef __STDC_NO_ATOMICS__
+#include <stdatomic.h>
+typedef atomic_uint IndexState;
+#define INDEX_STATE_LOAD(state)         atomic_load_explicit(&(state), memory_order_acquire)
+#define INDEX_STATE_STORE(state, value) atomic_store_explicit(&(state), (value), memory_order_release)
+#define INDEX_STATE_CLAIM(state, expected, value) \
+    atomic_compare_exchange_strong_explicit(&(state), &(expected), (value), memory_order_acquire, memory_order_acquire)
+#else
+typedef unsigned IndexState; //single threaded targets
+#define INDEX_STATE_LOAD(state)         (state)
+#define INDEX_STATE_STORE(state, value) ((state) = (value))
+#define INDEX_STATE_CLAIM(state, expected, value) (((state) = (value)), true)
+#endif
+
+enum {
+    INDEX_UNBUILT = 0,
+    INDEX_BUILDING,
+    INDEX_BUILT
+};
+
+typedef struct {
+    const QAssertMetaItem * items;
+    QAssertMetaIndexSlot * slots; //NULL if not indexed
+    uint32_t slotMask;
+    size_t itemCount;
+    IndexState indexState;
+} RegisteredTable;
+
+//weak default, replaced by an application's QASSERT_META_APPLICATION_TABLE
+QASSERT_META_WEAK const QAssertMetaApplicationTable qassert_meta_application_table = {NULL, NULL, 0};
+
 static UnknownQAssertCallback m_unknown_callback = NULL;
+static UnknownQAssertContextCallback m_unknown_context_callback = NULL;
+static RegisteredTable m_application_table; //set up by the first lookup reaching it
+static RegisteredTable m_registered_tables[QASSERT_META_MAX_REGISTERED_TABLES];
+static size_t m_registered_table_count = 0;
+
+static const QAssertMetaItem * SearchTable(const QAssertMetaItem * items, const char * module, size_t length, int id)
+{
+    int i = 0;
+    while (items[i].module != NULL)
+    {
+        if (items[i].id == id)
+        {
+            if (QAssertMetaPrivateModuleEquals(items[i].module, module, length))
+            {
+                return &items[i];
+            }
+        }
+        ++i;
+    }
+    return NULL;
+}
+
+static const QAssertMetaItem * SearchIndex(const QAssertMetaItem * items, const QAssertMetaIndexSlot * slots,
+                                           uint32_t slotMask, const char * module, size_t length, int id)
+{
+    uint32_t hash = QAssertMetaPrivateHash(module, length, id);
+
+    //indexes are at most half full, so probing terminates
+    for (uint32_t slot = hash & slotMask; ; slot = (slot + 1u) & slotMask)
+    {
+        const QAssertMetaIndexSlot * entry = &slots[slot];
+        if (0 == entry->item)
+        {
+            return NULL;
+        }
+
+        const QAssertMetaItem * item = &items[entry->item - 1u];
+        if ((entry->hash == hash) && (item->id == id) && QAssertMetaPrivateModuleEquals(item->module, module, length))
+        {
+            return item;
+        }
+    }
+}
+
+static size_t CountItems(const QAssertMetaItem * items)
+{
+    size_t count = 0;
+    while (items[count].module != NULL)
+    {
+        ++count;
+    }
+    return count;
+}
+
+static uint32_t IndexSlotCount(size_t itemCount)
+{
+    uint32_t slots = 2;
+    while ((slots < (itemCount * 2u)) && (slots < 0x80000000u))
+    {
+        slots *= 2u;
+    }
+    return slots;
+}
+
+static void BuildIndex(RegisteredTable * table)
+{
+    memset(table->slots, 0, (table->slotMask + 1u) * sizeof(QAssertMetaIndexSlot));
+    for (size_t i = 0; i < table->itemCount; ++i)
+    {
+        const QAssertMetaItem * item = &table->items[i];
+        uint32_t hash = QAssertMetaPrivateHash(item->module, strlen(item->module), item->id);
+        uint32_t slot = hash & table->slotMask;
+        bool duplicate = false;
+        while ((!duplicate) && (table->slots[slot].item != 0))
+        {
+            const QAssertMetaItem * existing = &table->items[table->slots[slot].item - 1u];
+            duplicate = (table->slots[slot].hash == hash) && (existing->id == item->id) &&
+                        (0 == strcmp(existing->module, item->module));
+            slot = (slot + 1u) & table->slotMask;
+        }
+
+        if (!duplicate)
+        {
+            table->slots[slot].hash = hash;
+            table->slots[slot].item = (uint32_t)(i + 1u);
+        }
+    }
+}
+
+/**
+ * @return: true if the table's index is ready, building it if this is
+ *          the first lookup to reach the table.
+ */
+static bool IndexReady(RegisteredTable * table)
+{
+    unsigned state = INDEX_STATE_LOAD(table->indexState);
+    if (INDEX_UNBUILT == state)
+    {
+        unsigned expected = INDEX_UNBUILT;
+        if (INDEX_STATE_CLAIM(table->indexState, expected, INDEX_BUILDING))
+        {
+            BuildIndex(table);
+            INDEX_STATE_STORE(table->indexState, INDEX_BUILT);
+            return true;
+        }
+        state = expected;
+    }
+    return INDEX_BUILT == state;
+}
+
+static const QAssertMetaItem * SearchRegisteredTable(RegisteredTable * table, const char * module, size_t length,
+                                                     int id)
+{
+    if ((NULL == table->slots) || !IndexReady(table))
+    {
+        return SearchTable(table->items, module, length, id);
+    }
+    return SearchIndex(table->items, table->slots, table->slotMask, module, length, id);
+}
 
 void QAssertMetaInit(void)
 {
     m_unknown_callback = NULL;
+    m_unknown_context_callback = NULL;
+    m_registered_table_count = 0;
 }
 
 void QAssertMetaRegisterUnknownCallback(UnknownQAssertCallback callback)
@@ -37,35 +194,384 @@ void QAssertMetaRegisterUnknownCallback(UnknownQAssertCallback callback)
     m_unknown_callback = callback;
 }
 
-bool QAssertMetaGetDescription(const char * module, int id, QAssertMetaDescription* output)
+void QAssertMetaRegisterUnknownContextCallback(UnknownQAssertContextCallback callback)
 {
-    if ((NULL == output) || (NULL == module))
+    m_unknown_context_callback = callback;
+}
+
+bool QAssertMetaRegisterTable(const QAssertMetaItem * items)
+{
+    if ((NULL == items) || (m_registered_table_count >= QASSERT_META_MAX_REGISTERED_TABLES))
     {
         return false;
     }
 
-    bool found = false;
+    RegisteredTable * table = &m_registered_tables[m_registered_table_count];
+    table->items = items;
+    table->slots = NULL;
+    table->slotMask = 0;
+    table->itemCount = CountItems(items);
+    INDEX_STATE_STORE(table->indexState, INDEX_BUILT);
+    ++m_registered_table_count;
+    return true;
+}
 
-    //TODO: search internal for matching module/id pair
-    int i = 0;
-    while (m_qassert_meta_items[i].module != NULL)
+size_t QAssertMetaIndexStorageSize(const QAssertMetaItem * items)
+{
+    if (NULL == items)
+    {
+        return 0;
+    }
+    return IndexSlotCount(CountItems(items)) * sizeof(QAssertMetaIndexSlot);
+}
+
+bool QAssertMetaRegisterIndexedTable(const QAssertMetaItem * items, void * indexStorage, size_t storageSize)
+{
+    if ((NULL == items) || (NULL == indexStorage) || (((uintptr_t)indexStorage % sizeof(uint32_t)) != 0) ||
+        (m_registered_table_count >= QASSERT_META_MAX_REGISTERED_TABLES))
+    {
+        return false;
+    }
+
+    size_t itemCount = CountItems(items);
+    uint32_t slotCount = IndexSlotCount(itemCount);
+    if ((itemCount >= UINT32_MAX / 2u) || (storageSize < (slotCount * sizeof(QAssertMetaIndexSlot))))
+    {
+        return false;
+    }
+
+    RegisteredTable * table = &m_registered_tables[m_registered_table_count];
+    table->items = items;
+    table->slots = indexStorage;
+    table->slotMask = slotCount - 1u;
+    table->itemCount = itemCount;
+    INDEX_STATE_STORE(table->indexState, INDEX_UNBUILT);
+    ++m_registered_table_count;
+    return true;
+}
+
+void QAssertMetaGetFootprint(QAssertMetaFootprint * footprint)
+{
+    if (NULL == footprint)
     {
-        if (m_qassert_meta_items[i].id == id)
+        return;
+    }
+
+    footprint->registeredTables = m_registered_table_count;
+    footprint->registeredItems = 0;
+    footprint->indexBytes = 0;
+    for (size_t i = 0; i < m_registered_table_count; ++i)
+    {
+        footprint->registeredItems += m_registered_tables[i].itemCount;
+        if (m_registered_tables[i].slots != NULL)
         {
-            if (0 == strcmp(module, m_qassert_meta_items[i].module))
-            {
-                found = true;
-                *output = m_qassert_meta_items[i].description;
-                break;
-            }
+            footprint->indexBytes += (m_registered_tables[i].slotMask + 1u) * sizeof(QAssertMetaIndexSlot);
         }
-        ++i;
     }
+}
+
+bool QAssertMetaPrivateHasUnknownCallback(void)
+{
+    return (NULL != m_unknown_context_callback) || (NULL != m_unknown_callback);
+}
 
-    if ((!found) && (m_unknown_callback != NULL))
+bool QAssertMetaPrivateCallUnknown(const char * module, int id, QAssertMetaLookupContext * context,
+                                  QAssertMetaDescription* output)
+{
+    UnknownQAssertContextCallback contextCallback = m_unknown_context_callback;
+    if (NULL != contextCallback)
     {
-        found = m_unknown_callback(module, id, output);
+        QAssertMetaLookupContext none = {NULL, NULL};
+        if (contextCallback(module, id, (NULL != context) ? context : &none, output))
+        {
+            return true;
+        }
+    }
+
+    UnknownQAssertCallback callback = m_unknown_callback;
+    return (NULL != callback) && callback(module, id, output);
+}
+
+size_t QAssertMetaPrivateRegisteredTableCount(void)
+{
+    return m_registered_table_count;
+}
+
+const QAssertMetaItem * QAssertMetaPrivateRegisteredTable(size_t index)
+{
+    if (index >= m_registered_table_count)
+    {
+        return NULL;
+    }
+    return m_registered_tables[index].items;
+}
+
+static const QAssertMetaItem * SearchBuiltin(const char * module, size_t length, int id)
+{
+    return SearchIndex(m_qassert_meta_items, m_qassert_meta_builtin_index, m_qassert_meta_builtin_index_mask,
+                       module, length, id);
+}
+
+const QAssertMetaItem * QAssertMetaPrivateSearchBuiltin(const char * module, size_t length, int id)
+{
+    return SearchBuiltin(module, length, id);
+}
+
+/**
+ * @return: the link time override of an internal table item, or the item itself.
+ */
+static const QAssertMetaItem * ApplyOverride(const QAssertMetaItem * item, const char * module, size_t length,
+                                             int id)
+{
+    uint16_t itemModule = m_qassert_meta_item_modules[item - m_qassert_meta_items];
+    const QAssertMetaItem * overrides = m_qassert_meta_module_overrides[itemModule];
+    if (NULL == overrides->module)
+    {
+        return item;
+    }
+
+    const QAssertMetaItem * replacement = SearchTable(overrides, module, length, id);
+    return (NULL != replacement) ? replacement : item;
+}
+
+const QAssertMetaItem * QAssertMetaPrivateBuiltinEntry(const QAssertMetaItem * item)
+{
+    return ApplyOverride(item, item->module, strlen(item->module), item->id);
+}
+
+/**
+ * Set up the application table and its index, once.
+ * @return: false if the application defines no table.
+ */
+static bool PrepareApplicationTable(void)
+{
+    const QAssertMetaApplicationTable * application = &qassert_meta_application_table;
+    if (NULL == application->items)
+    {
+        return false;
+    }
+
+    unsigned expected = INDEX_UNBUILT;
+    if ((INDEX_UNBUILT == INDEX_STATE_LOAD(m_application_table.indexState)) &&
+        INDEX_STATE_CLAIM(m_application_table.indexState, expected, INDEX_BUILDING))
+    {
+        RegisteredTable * table = &m_application_table;
+        table->items = application->items;
+        table->itemCount = CountItems(application->items);
+        uint32_t slotCount = IndexSlotCount(table->itemCount);
+        table->slotMask = slotCount - 1u;
+        table->slots = NULL;
+        if ((((uintptr_t)application->indexStorage % sizeof(uint32_t)) == 0) &&
+            (application->storageSize >= (slotCount * sizeof(QAssertMetaIndexSlot))))
+        {
+            table->slots = application->indexStorage;
+            BuildIndex(table);
+        }
+        INDEX_STATE_STORE(table->indexState, INDEX_BUILT);
+    }
+    return true;
+}
+
+static const QAssertMetaItem * SearchApplicationTable(const char * module, size_t length, int id)
+{
+    const QAssertMetaApplicationTable * application = &qassert_meta_application_table;
+    if (!PrepareApplicationTable())
+    {
+        return NULL;
+    }
+
+    if ((INDEX_BUILT != INDEX_STATE_LOAD(m_application_table.indexState)) || (NULL == m_application_table.slots))
+    {
+        return SearchTable(application->items, module, length, id);
+    }
+    return SearchIndex(m_application_table.items, m_application_table.slots, m_application_table.slotMask,
+                       module, length, id);
+}
+
+bool QAssertMetaPrivateGetTable(size_t index, QAssertMetaTableInfo * info)
+{
+    if (0 == index)
+    {
+        if (!PrepareApplicationTable())
+        {
+            return false;
+        }
+        if (INDEX_BUILT != INDEX_STATE_LOAD(m_application_table.indexState))
+        {
+            //being set up by a racing lookup
+            info->items = qassert_meta_application_table.items;
+            info->itemCount = CountItems(info->items);
+            info->indexed = false;
+            return true;
+        }
+        info->items = m_application_table.items;
+        info->itemCount = m_application_table.itemCount;
+        info->indexed = (NULL != m_application_table.slots);
+        return true;
+    }
+
+    if (index > m_registered_table_count)
+    {
+        return false;
+    }
+    RegisteredTable * table = &m_registered_tables[index - 1u];
+    info->items = table->items;
+    info->itemCount = table->itemCount;
+    info->indexed = (NULL != table->slots);
+    return true;
+}
+
+const QAssertMetaItem * QAssertMetaPrivateSearchTable(size_t index, const char * module, size_t length, int id)
+{
+    if (0 == index)
+    {
+        return SearchApplicationTable(module, length, id);
+    }
+    return (index <= m_registered_table_count) ?
+           SearchRegisteredTable(&m_registered_tables[index - 1u], module, length, id) : NULL;
+}
+
+/**
+ * Search the internal, application and registered tables, not the unknown callback.
+ */
+static QAssertMetaLatencyCategory SearchTables(const char * module, size_t length, int id,
+                                               QAssertMetaDescription* output)
+{
+    const QAssertMetaItem * item = SearchBuiltin(module, length, id);
+    if (item != NULL)
+    {
+        QASSERT_META_STATS_INCREMENT(builtinHits);
+        QASSERT_META_STATS_INCREMENT(builtinEntryHits[item - m_qassert_meta_items]);
+        *output = ApplyOverride(item, module, length, id)->description;
+        return QASSERT_META_LATENCY_BUILTIN_HIT;
+    }
+
+    item = SearchApplicationTable(module, length, id);
+    if (item != NULL)
+    {
+        QASSERT_META_STATS_INCREMENT(applicationHits);
+        *output = item->description;
+        return QASSERT_META_LATENCY_REGISTERED_HIT;
+    }
+
+    for (size_t i = 0; i < m_registered_table_count; ++i)
+    {
+        item = SearchRegisteredTable(&m_registered_tables[i], module, length, id);
+        if (item != NULL)
+        {
+            QASSERT_META_STATS_INCREMENT(registeredHits);
+            QASSERT_META_STATS_INCREMENT(registeredTableHits[i]);
+            *output = item->description;
+            return QASSERT_META_LATENCY_REGISTERED_HIT;
+        }
+    }
+    return QASSERT_META_LATENCY_MISS;
+}
+
+bool QAssertMetaPrivateSearchTables(const char * module, size_t length, int id, QAssertMetaDescription* output)
+{
+    return SearchTables(module, length, id, output) != QASSERT_META_LATENCY_MISS;
+}
+
+/**
+ * @param terminated:  module[length] is known to be '\0', the unknown callback
+ *                     may be given module itself rather than a copy.
+ */
+static QAssertMetaLatencyCategory Lookup(const char * module, size_t length, bool terminated, int id,
+                                         QAssertMetaLookupContext * context, QAssertMetaDescription* output)
+{
+    QAssertMetaLatencyCategory category = SearchTables(module, length, id, output);
+    if (category != QASSERT_META_LATENCY_MISS)
+    {
+        return category;
+    }
+
+    //the callback takes a terminated module, slices are copied (if short enough)
+    char copy[QASSERT_META_CALLBACK_MODULE_SIZE];
+    if ((!terminated) && (length < sizeof(copy)))
+    {
+        memcpy(copy, module, length);
+        copy[length] = '\0';
+        module = copy;
+        terminated = true;
+    }
+
+    if (QAssertMetaPrivateHasUnknownCallback() && terminated)
+    {
+        QASSERT_META_STATS_INCREMENT(unknownCallbackCalls);
+        if (QAssertMetaPrivateCallUnknown(module, id, context, output))
+        {
+            QASSERT_META_STATS_INCREMENT(unknownCallbackHits);
+            return QASSERT_META_LATENCY_CALLBACK_HIT;
+        }
+    }
+
+    QASSERT_META_STATS_INCREMENT(misses);
+    return QASSERT_META_LATENCY_MISS;
+}
+
+static bool GetDescription(const char * module, size_t length, bool terminated, int id,
+                           QAssertMetaLookupContext * context, QAssertMetaDescription* output)
+{
+    QASSERT_META_STATS_INCREMENT(lookups);
+    if ((NULL == output) || (NULL == module))
+    {
+        QASSERT_META_STATS_INCREMENT(nullArgumentRejections);
+        return false;
+    }
+
+#if QASSERT_META_ENABLE_LATENCY_HISTOGRAM
+    uint64_t start = QASSERT_META_LATENCY_TIMESTAMP();
+    QAssertMetaLatencyCategory category = Lookup(module, length, terminated, id, context, output);
+    QAssertMetaPrivateLatencyRecord(category, QASSERT_META_LATENCY_TIMESTAMP() - start);
+#else
+    QAssertMetaLatencyCategory category = Lookup(module, length, terminated, id, context, output);
+#endif
+    return category != QASSERT_META_LATENCY_MISS;
+}
+
+bool QAssertMetaGetDescription(const char * module, int id, QAssertMetaDescription* output)
+{
+    return GetDescription(module, (NULL != module) ? strlen(module) : 0, true, id, NULL, output);
+}
+
+bool QAssertMetaGetDescriptionWithContext(const char * module, int id, QAssertMetaLookupContext * context,
+                                          QAssertMetaDescription* output)
+{
+    return GetDescription(module, (NULL != module) ? strlen(module) : 0, true, id, context, output);
+}
+
+bool QAssertMetaGetDescriptionN(const char * module, size_t length, int id, QAssertMetaDescription* output)
+{
+    return GetDescription(module, length, false, id, NULL, output);
+}
+
+bool QAssertMetaGetLocation(const char * module, int id, QAssertMetaLocation * output)
+{
+    return QAssertMetaGetLocationN(module, (NULL != module) ? strlen(module) : 0, id, output);
+}
+
+bool QAssertMetaGetLocationN(const char * module, size_t length, int id, QAssertMetaLocation * output)
+{
+    if ((NULL == output) || (NULL == module) || (NULL == m_qassert_meta_locations))
+    {
+        return false;
+    }
+
+    const QAssertMetaItem * item = SearchBuiltin(module, length, id);
+    if (NULL == item)
+    {
+        return false;
+    }
+
+    const QAssertMetaLocationRecord * record = &m_qassert_meta_locations[item - m_qassert_meta_items];
+    if (0 == record->file)
+    {
+        return false;
     }
 
-    return found;
+    output->file = m_qassert_meta_location_files[record->file - 1u];
+    output->line = record->line;
+    output->function = (0 != record->function) ? m_qassert_meta_location_functions[record->function - 1u] : NULL;
+    return true;
 }
@@ -0,0 +1,223 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CppUTest/TestHarness.h"
+#include "qassert-meta-aggregator.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace qassert_meta;
+
+namespace {
+
+const char DEVICE_LOG[] =
+    "boot version=6.9.3, serial=1234\n"
+    "0000001000 =ASSERT= Mod=qf_actq,Loc=190\n"
+    "E (1234) ASSERT qf_mem:110 in pool 2\n"
+    "reboot\r\n"
+    "0000001000 =ASSERT= Mod=qf_actq,Loc=190\r\n"
+    "version=7.0.0; ASSERT qf_actq:190\n"
+    "ASSERTION qf_actq:1 is not an assert record\n"
+    "ASSERT qf_dyn:-2"; //no final newline
+
+/**
+ * Temporary log files, removed on destruction.
+ */
+struct LogFiles {
+    LogFiles()
+    {
+        char pattern[] = "/tmp/qassert-meta-aggregate-XXXXXX";
+        CHECK_TRUE(nullptr != mkdtemp(pattern));
+        root = pattern;
+    }
+
+    ~LogFiles()
+    {
+        for (const std::string & path : paths)
+        {
+            (void)remove(path.c_str());
+        }
+        (void)rmdir(root.c_str());
+    }
+
+    void Add(const std::string & content)
+    {
+        std::string path = root + "/device-" + std::to_string(paths.size()) + ".log";
+        FILE * file = fopen(path.c_str(), "w");
+        CHECK_TRUE(nullptr != file);
+        fwrite(content.data(), 1, content.size(), file);
+        fclose(file);
+        paths.push_back(path);
+    }
+
+    std::string root;
+    std::vector<std::string> paths;
+};
+
+uint64_t CountOf(const std::vector<AggregateCount> & ranked, const char * module, int id, const char * version)
+{
+    for (const AggregateCount & count : ranked)
+    {
+        if ((count.key.module == module) && (count.key.id == id) && (count.key.version == version))
+        {
+            return count.count;
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+TEST_GROUP(qassert_meta_aggregator_tests)
+{
+    void setup() final
+    {
+    }
+
+    void teardown() final
+    {
+    }
+};
+
+TEST(qassert_meta_aggregator_tests, log_lines_report_asserts_in_qspy_and_plain_forms)
+{
+    LogAssert found;
+    const char qspy[] = "0000001000 =ASSERT= Mod=qf_actq,Loc=190";
+    CHECK_TRUE(ParseLogAssert(qspy, strlen(qspy), &found));
+    CHECK_EQUAL(190, found.id);
+    CHECK_EQUAL(7u, found.moduleLength);
+    CHECK_EQUAL(0, strncmp("qf_actq", found.module, found.moduleLength));
+
+    const char plain[] = "E (1234) ASSERT qf_mem:110 in pool 2";
+    CHECK_TRUE(ParseLogAssert(plain, strlen(plain), &found));
+    CHECK_EQUAL(110, found.id);
+    CHECK_EQUAL(0, strncmp("qf_mem", found.module, found.moduleLength));
+
+    const char * const rejected[] = {"ASSERTION qf_actq:1", "ASSERT qf_actq", "ASSERT qf_actq:", "Mod=,Loc=1",
+                                     "Mod=qf_actq,Loc=99999999999", "ASSERT :5", ""};
+    for (const char * line : rejected)
+    {
+        CHECK_FALSE(ParseLogAssert(line, strlen(line), &found));
+    }
+
+    //lines are slices of a buffer, never read past their length
+    const char truncated[] = "ASSERT qf_actq:190";
+    CHECK_TRUE(ParseLogAssert(truncated, strlen(truncated) - 1, &found));
+    CHECK_EQUAL(19, found.id);
+}
+
+TEST(qassert_meta_aggregator_tests, counts_per_module_id_and_version)
+{
+    AggregateConfig config;
+    AggregateShard shard(config);
+    shard.CountLog(DEVICE_LOG, strlen(DEVICE_LOG));
+
+    std::vector<AggregateCount> ranked = shard.Ranked();
+    CHECK_EQUAL(4u, ranked.size());
+    STRCMP_EQUAL("qf_actq", ranked[0].key.module.c_str());
+    STRCMP_EQUAL("6.9.3", ranked[0].key.version.c_str());
+    CHECK_EQUAL(2u, ranked[0].count);
+    CHECK_EQUAL(1u, CountOf(ranked, "qf_mem", 110, "6.9.3"));
+    CHECK_EQUAL(1u, CountOf(ranked, "qf_actq", 190, "7.0.0"));
+    CHECK_EQUAL(1u, CountOf(ranked, "qf_dyn", -2, "7.0.0"));
+    CHECK_EQUAL(8u, shard.Stats().lines);
+    CHECK_EQUAL(5u, shard.Stats().asserts);
+
+    config.byVersion = false;
+    AggregateShard merged(config);
+    merged.CountLog(DEVICE_LOG, strlen(DEVICE_LOG));
+    CHECK_EQUAL(3u, CountOf(merged.Ranked(), "qf_actq", 190, ""));
+}
+
+TEST(qassert_meta_aggregator_tests, parallel_shards_merge_to_the_single_threaded_counts)
+{
+    LogFiles logs;
+    for (int i = 0; i < 40; ++i)
+    {
+        std::string log = "version=1." + std::to_string(i % 3) + "\n";
+        for (int j = 0; j <= i; ++j)
+        {
+            log += "ASSERT qf_actq:190\nASSERT app:" + std::to_string(j % 7) + "\n";
+        }
+        logs.Add(log);
+    }
+
+    std::vector<std::string> files;
+    CHECK_TRUE(ListLogFiles(logs.root, files));
+    CHECK_EQUAL(40u, files.size());
+
+    AggregateConfig config;
+    AggregateStats single;
+    std::vector<AggregateCount> expected = AggregateLogs(files, config, &single);
+    config.threads = 8;
+    AggregateStats parallel;
+    std::vector<AggregateCount> actual = AggregateLogs(files, config, &parallel);
+
+    CHECK_EQUAL(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        CHECK_TRUE(expected[i].key == actual[i].key);
+        CHECK_EQUAL(expected[i].count, actual[i].count);
+    }
+    CHECK_EQUAL(40u, parallel.files);
+    CHECK_EQUAL(single.asserts, parallel.asserts);
+    CHECK_EQUAL(single.bytes, parallel.bytes);
+    CHECK_EQUAL(287u, CountOf(actual, "qf_actq", 190, "1.0")); //i = 0, 3 .. 39, 14 logs
+}
+
+TEST(qassert_meta_aggregator_tests, sketch_mode_finds_the_heavy_hitters_in_bounded_memory)
+{
+    AggregateConfig config;
+    config.sketch = true;
+    config.sketchWidth = 1024;
+    config.candidates = 16;
+    AggregateShard first(config);
+    AggregateShard second(config);
+
+    //a few frequent asserts among 5000 rare ones, split over two shards
+    for (int i = 0; i < 5000; ++i)
+    {
+        AggregateShard & shard = (i % 2) ? first : second;
+        std::string module = "app_" + std::to_string(i);
+        shard.Count(module.data(), module.size(), i, "", 0);
+        shard.Count("qf_actq", 7, 190, "", 0);
+        if ((i % 10) == 0)
+        {
+            shard.Count("qf_mem", 6, 110, "", 0);
+        }
+    }
+    first.Merge(second);
+
+    std::vector<AggregateCount> ranked = first.Ranked();
+    CHECK_TRUE(ranked.size() <= config.candidates);
+    STRCMP_EQUAL("qf_actq", ranked[0].key.module.c_str());
+    CHECK_TRUE(ranked[0].count >= 5000u); //estimates never undercount
+    CHECK_TRUE(ranked[0].count < 5100u);
+    STRCMP_EQUAL("qf_mem", ranked[1].key.module.c_str());
+    CHECK_TRUE(ranked[1].count >= 500u);
+    CHECK_EQUAL(10500u, first.Stats().asserts);
+}
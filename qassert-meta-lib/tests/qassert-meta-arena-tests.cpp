@@ -0,0 +1,187 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CppUTest/TestHarness.h"
+#include "qassert-meta.h"
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t CONTEXT_THREADS = 8;
+
+//formats the application context into the tips, falling back to a fixed text
+bool DescribeWithContext(const char * module, int id, QAssertMetaLookupContext * context,
+                         QAssertMetaDescription * output)
+{
+    if (0 != strcmp(module, "app_motor"))
+    {
+        return false;
+    }
+
+    const char * motor = (nullptr != context->userData) ? static_cast<const char *>(context->userData) : "?";
+    output->brief = QAssertMetaArenaPrintf(context->arena, "motor %s fault %d", motor, id);
+    output->tips = QAssertMetaArenaPrintf(context->arena, "check motor %s\nthen its driver", motor);
+    output->url = nullptr;
+    if ((nullptr == output->brief) || (nullptr == output->tips))
+    {
+        output->brief = "motor fault";
+        output->tips = nullptr;
+    }
+    return true;
+}
+
+bool DescribeStatically(const char * module, int id, QAssertMetaDescription * output)
+{
+    (void)id;
+    output->brief = (0 == strcmp(module, "app_pump")) ? "pump fault" : nullptr;
+    output->tips = nullptr;
+    output->url = nullptr;
+    return nullptr != output->brief;
+}
+
+} // namespace
+
+TEST_GROUP(qassert_meta_arena_tests)
+{
+    char buffer[128];
+    QAssertMetaArena arena;
+
+    void setup() final
+    {
+        QAssertMetaInit();
+        QAssertMetaArenaInit(&arena, buffer, sizeof(buffer));
+    }
+
+    void teardown() final
+    {
+        QAssertMetaInit();
+    }
+};
+
+TEST(qassert_meta_arena_tests, context_callback_generates_strings_in_the_arena)
+{
+    QAssertMetaRegisterUnknownContextCallback(DescribeWithContext);
+    char motor[] = "M2";
+    QAssertMetaLookupContext context = {&arena, motor};
+    QAssertMetaDescription description;
+    CHECK_TRUE(QAssertMetaGetDescriptionWithContext("app_motor", 7, &context, &description));
+    STRCMP_EQUAL("motor M2 fault 7", description.brief);
+    STRCMP_EQUAL("check motor M2\nthen its driver", description.tips);
+    CHECK_TRUE((description.brief >= buffer) && (description.tips < (buffer + sizeof(buffer))));
+    CHECK_EQUAL(strlen(description.brief) + strlen(description.tips) + 2u, arena.used);
+
+    QAssertMetaArenaReset(&arena);
+    CHECK_EQUAL(0u, arena.used);
+}
+
+TEST(qassert_meta_arena_tests, table_hits_leave_the_arena_untouched)
+{
+    QAssertMetaRegisterUnknownContextCallback(DescribeWithContext);
+    QAssertMetaLookupContext context = {&arena, nullptr};
+    QAssertMetaDescription description;
+    CHECK_TRUE(QAssertMetaGetDescriptionWithContext("qf_actq", 190, &context, &description));
+    CHECK_EQUAL(0u, arena.used);
+}
+
+TEST(qassert_meta_arena_tests, full_arena_allocates_nothing_and_the_callback_may_fall_back)
+{
+    QAssertMetaRegisterUnknownContextCallback(DescribeWithContext);
+    QAssertMetaLookupContext context = {&arena, nullptr};
+    CHECK_TRUE(nullptr != QAssertMetaArenaAlloc(&arena, sizeof(buffer) - 10u));
+    CHECK_FALSE(arena.exhausted);
+
+    QAssertMetaDescription description;
+    CHECK_TRUE(QAssertMetaGetDescriptionWithContext("app_motor", 12345, &context, &description));
+    STRCMP_EQUAL("motor fault", description.brief);
+    CHECK_TRUE(arena.exhausted);
+    CHECK_EQUAL(sizeof(buffer) - 10u, arena.used);
+    POINTERS_EQUAL(nullptr, QAssertMetaArenaAlloc(&arena, 11u));
+}
+
+TEST(qassert_meta_arena_tests, lookups_without_context_give_the_callback_no_arena)
+{
+    QAssertMetaRegisterUnknownContextCallback(DescribeWithContext);
+    QAssertMetaDescription description;
+    CHECK_TRUE(QAssertMetaGetDescription("app_motor", 1, &description));
+    STRCMP_EQUAL("motor fault", description.brief);
+    POINTERS_EQUAL(nullptr, QAssertMetaArenaPrintf(nullptr, "%d", 1));
+}
+
+TEST(qassert_meta_arena_tests, context_callback_is_asked_before_the_unknown_callback)
+{
+    QAssertMetaRegisterUnknownContextCallback(DescribeWithContext);
+    QAssertMetaRegisterUnknownCallback(DescribeStatically);
+    QAssertMetaLookupContext context = {&arena, nullptr};
+    QAssertMetaDescription description;
+    CHECK_TRUE(QAssertMetaGetDescriptionWithContext("app_pump", 1, &context, &description));
+    STRCMP_EQUAL("pump fault", description.brief);
+    CHECK_TRUE(QAssertMetaGetDescriptionWithContext("app_motor", 1, &context, &description));
+    STRCMP_EQUAL("motor ? fault 1", description.brief);
+    CHECK_FALSE(QAssertMetaGetDescriptionWithContext("app_valve", 1, &context, &description));
+}
+
+TEST(qassert_meta_arena_tests, concurrent_context_lookups_each_generate_into_their_own_arena)
+{
+    QAssertMetaRegisterUnknownContextCallback(
+        [](const char * module, int id, QAssertMetaLookupContext * context, QAssertMetaDescription * output) {
+            output->brief = QAssertMetaArenaPrintf(context->arena, "%s %d of %p", module, id, context->userData);
+            output->tips = nullptr;
+            output->url = nullptr;
+            return nullptr != output->brief;
+        });
+    std::vector<size_t> failures(CONTEXT_THREADS, 0);
+    std::vector<std::thread> threads;
+
+    for (size_t t = 0; t < CONTEXT_THREADS; ++t)
+    {
+        threads.emplace_back([&failures, t]() {
+            char buffer[256];
+            char expected[64];
+            QAssertMetaArena arena;
+            QAssertMetaArenaInit(&arena, buffer, sizeof(buffer));
+            QAssertMetaLookupContext context = {&arena, &failures[t]};
+            QAssertMetaDescription description;
+            for (int id = 0; id < 2000; ++id)
+            {
+                QAssertMetaArenaReset(&arena);
+                (void)snprintf(expected, sizeof(expected), "gobble %d of %p", id, static_cast<void *>(&failures[t]));
+                if (!QAssertMetaGetDescriptionWithContext("gobble", id, &context, &description) ||
+                    (0 != strcmp(expected, description.brief)) || (description.brief != buffer))
+                {
+                    ++failures[t];
+                }
+            }
+        });
+    }
+    for (std::thread & thread : threads)
+    {
+        thread.join();
+    }
+
+    for (size_t count : failures)
+    {
+        CHECK_EQUAL(0u, count);
+    }
+}
@@ -0,0 +1,253 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CppUTest/TestHarness.h"
+#include "qassert-meta-async.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <poll.h>
+#include <string>
+#include <thread>
+
+namespace {
+
+std::atomic<int> m_resolverCalls{0};
+std::atomic<bool> m_release{false};
+
+//a slow resolver, held until released
+bool SlowResolver(const char * module, int id, QAssertMetaDescription * output)
+{
+    m_resolverCalls++;
+    while (!m_release)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if ((0 != strcmp(module, "app_slow")) || (id < 0))
+    {
+        return false;
+    }
+    output->brief = "slowly resolved";
+    output->tips = nullptr;
+    output->url = nullptr;
+    return true;
+}
+
+bool WaitReadable(int fd)
+{
+    struct pollfd ready = {fd, POLLIN, 0};
+    return 1 == poll(&ready, 1, 5000);
+}
+
+std::atomic<int> m_delivered{0};
+std::atomic<uintptr_t> m_deliveredData{0};
+
+void CountCompletion(const QAssertMetaAsyncCompletion * completion, void * context)
+{
+    (void)context;
+    m_deliveredData += reinterpret_cast<uintptr_t>(completion->userData);
+    m_delivered++;
+}
+
+} // namespace
+
+TEST_GROUP(qassert_meta_async_tests)
+{
+    QAssertMetaAsync * async = nullptr;
+
+    void setup() final
+    {
+        QAssertMetaInit();
+        m_resolverCalls = 0;
+        m_release = false;
+        m_delivered = 0;
+        m_deliveredData = 0;
+    }
+
+    void teardown() final
+    {
+        m_release = true;
+        QAssertMetaAsyncDestroy(async);
+        QAssertMetaInit();
+    }
+};
+
+TEST(qassert_meta_async_tests, table_hits_and_misses_without_a_resolver_complete_inline)
+{
+    async = QAssertMetaAsyncCreate(nullptr);
+    CHECK_TRUE(nullptr != async);
+
+    QAssertMetaDescription expected;
+    QAssertMetaDescription description = {nullptr, nullptr, nullptr};
+    CHECK_TRUE(QAssertMetaGetDescription("qf_actq", 190, &expected));
+    CHECK_EQUAL(QASSERT_META_ASYNC_FOUND, QAssertMetaAsyncSubmit(async, "qf_actq", 190, &description, nullptr));
+    POINTERS_EQUAL(expected.brief, description.brief);
+    CHECK_EQUAL(QASSERT_META_ASYNC_NOT_FOUND, QAssertMetaAsyncSubmit(async, "app_slow", 1, &description, nullptr));
+
+    QAssertMetaAsyncCompletion completion;
+    CHECK_EQUAL(0u, QAssertMetaAsyncPoll(async, &completion, 1));
+    QAssertMetaAsyncStats stats;
+    QAssertMetaAsyncGetStats(async, &stats);
+    CHECK_EQUAL(2u, stats.completedInline);
+    CHECK_EQUAL(0u, stats.resolverCalls);
+}
+
+TEST(qassert_meta_async_tests, repeated_keys_share_one_resolver_call_and_complete_via_the_fd)
+{
+    QAssertMetaRegisterUnknownCallback(SlowResolver);
+    async = QAssertMetaAsyncCreate(nullptr);
+    QAssertMetaDescription description;
+    for (uintptr_t i = 0; i < 5u; ++i)
+    {
+        CHECK_EQUAL(QASSERT_META_ASYNC_PENDING,
+                    QAssertMetaAsyncSubmit(async, "app_slow", 7, &description, reinterpret_cast<void *>(i)));
+    }
+    CHECK_EQUAL(QASSERT_META_ASYNC_PENDING, QAssertMetaAsyncSubmit(async, "app_slow", -1, &description, nullptr));
+
+    struct pollfd ready = {QAssertMetaAsyncFd(async), POLLIN, 0};
+    CHECK_EQUAL(0, poll(&ready, 1, 0));
+    m_release = true;
+
+    QAssertMetaAsyncCompletion completions[8];
+    size_t count = 0;
+    while ((count < 6u) && WaitReadable(QAssertMetaAsyncFd(async)))
+    {
+        count += QAssertMetaAsyncPoll(async, &completions[count], 8u - count);
+    }
+    CHECK_EQUAL(6u, count);
+    CHECK_EQUAL(0, poll(&ready, 1, 0)); //drained
+
+    uintptr_t found = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (completions[i].id == 7)
+        {
+            CHECK_TRUE(completions[i].found);
+            STRCMP_EQUAL("app_slow", completions[i].module);
+            STRCMP_EQUAL("slowly resolved", completions[i].description.brief);
+            found += 1u << reinterpret_cast<uintptr_t>(completions[i].userData);
+        }
+        else
+        {
+            CHECK_FALSE(completions[i].found);
+        }
+    }
+    CHECK_EQUAL(0x1Fu, found); //each submission completed once
+
+    QAssertMetaAsyncStats stats;
+    QAssertMetaAsyncGetStats(async, &stats);
+    CHECK_EQUAL(2u, stats.resolverCalls);
+    CHECK_EQUAL(4u, stats.deduplicated);
+    CHECK_EQUAL(2, m_resolverCalls.load());
+}
+
+TEST(qassert_meta_async_tests, completions_may_be_delivered_to_a_callback)
+{
+    QAssertMetaRegisterUnknownCallback(SlowResolver);
+    QAssertMetaAsyncConfig config = {4, 0, 0, CountCompletion, nullptr, 0};
+    async = QAssertMetaAsyncCreate(&config);
+    m_release = true;
+
+    QAssertMetaDescription description;
+    uintptr_t expected = 0;
+    for (int id = 0; id < 100; ++id)
+    {
+        CHECK_EQUAL(QASSERT_META_ASYNC_PENDING, QAssertMetaAsyncSubmit(async, "app_slow", id, &description,
+                                                                       reinterpret_cast<void *>(uintptr_t(id))));
+        expected += static_cast<uintptr_t>(id);
+        while (m_delivered < (id - 32)) //stay within the default bounds
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while ((m_delivered < 100) && (std::chrono::steady_clock::now() < deadline))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK_EQUAL(100, m_delivered.load());
+    CHECK_EQUAL(expected, m_deliveredData.load());
+}
+
+TEST(qassert_meta_async_tests, submissions_beyond_the_bounds_are_refused)
+{
+    QAssertMetaRegisterUnknownCallback(SlowResolver);
+    QAssertMetaAsyncConfig config = {1, 2, 3, nullptr, nullptr, 0};
+    async = QAssertMetaAsyncCreate(&config);
+
+    QAssertMetaDescription description;
+    CHECK_EQUAL(QASSERT_META_ASYNC_PENDING, QAssertMetaAsyncSubmit(async, "app_slow", 1, &description, nullptr));
+    CHECK_EQUAL(QASSERT_META_ASYNC_PENDING, QAssertMetaAsyncSubmit(async, "app_slow", 2, &description, nullptr));
+    CHECK_EQUAL(QASSERT_META_ASYNC_FULL, QAssertMetaAsyncSubmit(async, "app_slow", 3, &description, nullptr));
+    CHECK_EQUAL(QASSERT_META_ASYNC_PENDING, QAssertMetaAsyncSubmit(async, "app_slow", 2, &description, nullptr));
+    CHECK_EQUAL(QASSERT_META_ASYNC_FULL, QAssertMetaAsyncSubmit(async, "app_slow", 2, &description, nullptr));
+
+    QAssertMetaAsyncStats stats;
+    QAssertMetaAsyncGetStats(async, &stats);
+    CHECK_EQUAL(2u, stats.refused);
+}
+
+TEST(qassert_meta_async_tests, context_callbacks_generate_into_worker_arenas_and_each_waiter_gets_a_copy)
+{
+    QAssertMetaRegisterUnknownContextCallback(
+        [](const char * module, int id, QAssertMetaLookupContext * context, QAssertMetaDescription * output) {
+            while (!m_release)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            output->brief = QAssertMetaArenaPrintf(context->arena, "%s generated %d", module, id);
+            output->tips = "static tips";
+            output->url = nullptr;
+            return nullptr != output->brief;
+        });
+    QAssertMetaAsyncConfig config = {2, 0, 0, nullptr, nullptr, 64};
+    async = QAssertMetaAsyncCreate(&config);
+
+    QAssertMetaDescription description;
+    for (int i = 0; i < 3; ++i)
+    {
+        CHECK_EQUAL(QASSERT_META_ASYNC_PENDING, QAssertMetaAsyncSubmit(async, "app_gen", 5, &description, nullptr));
+    }
+    CHECK_EQUAL(QASSERT_META_ASYNC_PENDING, QAssertMetaAsyncSubmit(async, "app_gen", 6, &description, nullptr));
+    m_release = true;
+
+    QAssertMetaAsyncCompletion completions[4];
+    size_t count = 0;
+    while ((count < 4u) && WaitReadable(QAssertMetaAsyncFd(async)))
+    {
+        count += QAssertMetaAsyncPoll(async, &completions[count], 4u - count);
+    }
+    CHECK_EQUAL(4u, count);
+
+    //the workers have since generated other strings, the copies are intact
+    for (size_t i = 0; i < count; ++i)
+    {
+        CHECK_TRUE(completions[i].found);
+        std::string expected = std::string("app_gen generated ") + std::to_string(completions[i].id);
+        STRCMP_EQUAL(expected.c_str(), completions[i].description.brief);
+        STRCMP_EQUAL("static tips", completions[i].description.tips);
+        for (size_t j = 0; j < i; ++j)
+        {
+            CHECK_TRUE(completions[i].description.brief != completions[j].description.brief);
+        }
+    }
+}
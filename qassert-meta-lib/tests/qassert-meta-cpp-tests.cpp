@@ -0,0 +1,100 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CppUTest/TestHarness.h"
+#include "qassert-meta.hpp"
+#include "qassert-meta.h"
+#include "qassert-meta-generated.h"
+#include <string>
+
+static_assert(qassert_meta::contains("qf_actq", 190), "qf_actq:190 must be described");
+static_assert(!qassert_meta::contains("qf_actq", 191), "qf_actq:191 is not a QP assert");
+static_assert(!qassert_meta::contains(nullptr, 190), "NULL module is never found");
+static_assert(qassert_meta::describe("qf_actq", 190).brief != nullptr, "described at compile time");
+static_assert(qassert_meta::describe("qf_actq", 190).brief[0] == 'Q', "brief readable at compile time");
+static_assert(qassert_meta::describe("no_such_module", 1).brief == nullptr, "unknown has no brief");
+static_assert(qassert_meta::item_count() == QASSERT_META_BUILTIN_ITEM_COUNT, "same table as the C library");
+
+constexpr qassert_meta::Key REQUIRED_COVERAGE[] = {
+    {"qf_actq", 102},
+    {"qf_actq", 190},
+};
+static_assert(qassert_meta::contains_all(REQUIRED_COVERAGE), "coverage of asserts used by the application");
+
+TEST_GROUP(qassert_meta_cpp_tests) {
+    void setup() final
+    {
+        QAssertMetaInit();
+    }
+
+    void teardown() final
+    {
+    }
+};
+
+TEST(qassert_meta_cpp_tests, runtime_describe_matches_c_lookup_for_every_item)
+{
+    for (size_t i = 0; i < qassert_meta::item_count(); ++i)
+    {
+        const QAssertMetaItem & item = qassert_meta::detail::BuiltinItem(i);
+        std::string module(item.module); //not a constant
+        QAssertMetaDescription expected = {nullptr, nullptr, nullptr};
+        CHECK_TRUE(QAssertMetaGetDescription(module.c_str(), item.id, &expected));
+
+        QAssertMetaDescription actual = qassert_meta::describe(module.c_str(), item.id);
+        STRCMP_EQUAL(expected.brief, actual.brief);
+        CHECK_TRUE((expected.tips == nullptr) == (actual.tips == nullptr));
+        CHECK_TRUE((expected.url == nullptr) == (actual.url == nullptr));
+        if (expected.tips != nullptr)
+        {
+            STRCMP_EQUAL(expected.tips, actual.tips);
+        }
+        if (expected.url != nullptr)
+        {
+            STRCMP_EQUAL(expected.url, actual.url);
+        }
+    }
+}
+
+TEST(qassert_meta_cpp_tests, runtime_misses_match_c_lookup)
+{
+    const qassert_meta::Key misses[] = {
+        {"qf_actq", -1}, {"qf_act", 190}, {"qf_actqq", 190}, {"QF_ACTQ", 190}, {"", 0}, {nullptr, 190}
+    };
+    for (const qassert_meta::Key & key : misses)
+    {
+        QAssertMetaDescription output;
+        CHECK_FALSE(QAssertMetaGetDescription(key.module, key.id, &output));
+        CHECK_TRUE(nullptr == qassert_meta::find(key.module, key.id));
+        CHECK_TRUE(nullptr == qassert_meta::describe(key.module, key.id).brief);
+    }
+}
+
+TEST(qassert_meta_cpp_tests, sorted_index_is_ordered)
+{
+    for (size_t i = 1; i < qassert_meta::item_count(); ++i)
+    {
+        const QAssertMetaItem & previous = qassert_meta::detail::SortedBuiltinItem(i - 1);
+        const QAssertMetaItem & current = qassert_meta::detail::SortedBuiltinItem(i);
+        CHECK_TRUE(qassert_meta::detail::Compare(previous.module, previous.id, current) <= 0);
+    }
+}
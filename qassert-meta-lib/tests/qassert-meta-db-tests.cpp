@@ -0,0 +1,153 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CppUTest/TestHarness.h"
+#include "qassert-meta.h"
+#include "qassert-meta-db.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <unistd.h>
+#include <vector>
+
+static const QAssertMetaItem TEST_APP_TABLE[] = {
+    {"app_module", 1, {"app brief", "app tips", nullptr}},
+    {"app_module", 2, {"app brief", nullptr, "https://example.com"}},
+    {"qf_actq", 102, {"duplicate, internal table wins", nullptr, nullptr}},
+    {nullptr, 0, {nullptr, nullptr, nullptr}}
+};
+
+TEST_GROUP(qassert_meta_db_tests) {
+    std::vector<char> image;
+
+    void setup() final
+    {
+        QAssertMetaInit();
+        CHECK_TRUE(QAssertMetaRegisterTable(TEST_APP_TABLE));
+        WriteImage();
+    }
+
+    void teardown() final
+    {
+        QAssertMetaDbInstall(nullptr);
+    }
+
+    void WriteImage()
+    {
+        FILE * file = tmpfile();
+        CHECK_TRUE(file != nullptr);
+        CHECK_TRUE(QAssertMetaDbWrite(file));
+        long size = ftell(file);
+        CHECK_TRUE(size > 0);
+        image.resize(size);
+        rewind(file);
+        CHECK_EQUAL(1u, fread(image.data(), image.size(), 1, file));
+        fclose(file);
+    }
+};
+
+TEST(qassert_meta_db_tests, database_contains_internal_and_registered_entries)
+{
+    QAssertMetaDb db;
+    CHECK_TRUE(QAssertMetaDbAttach(&db, image.data(), image.size()));
+
+    QAssertMetaDescription expected;
+    QAssertMetaDescription actual;
+    CHECK_TRUE(QAssertMetaGetDescription("qf_actq", 190, &expected));
+    CHECK_TRUE(QAssertMetaDbLookup(&db, "qf_actq", 190, &actual));
+    STRCMP_EQUAL(expected.brief, actual.brief);
+    STRCMP_EQUAL(expected.tips, actual.tips);
+    STRCMP_EQUAL(expected.url, actual.url);
+
+    CHECK_TRUE(QAssertMetaDbLookup(&db, "app_module", 2, &actual));
+    STRCMP_EQUAL("app brief", actual.brief);
+    CHECK_EQUAL(nullptr, actual.tips);
+    STRCMP_EQUAL("https://example.com", actual.url);
+
+    CHECK_TRUE(QAssertMetaDbLookup(&db, "qf_actq", 102, &actual));
+    STRCMP_CONTAINS("QActive post", actual.brief);
+
+    CHECK_FALSE(QAssertMetaDbLookup(&db, "app_module", 3, &actual));
+    CHECK_FALSE(QAssertMetaDbLookup(&db, "gobble", 1, &actual));
+    CHECK_FALSE(QAssertMetaDbLookup(&db, nullptr, 1, &actual));
+}
+
+TEST(qassert_meta_db_tests, attach_rejects_invalid_images)
+{
+    QAssertMetaDb db;
+    CHECK_FALSE(QAssertMetaDbAttach(&db, image.data(), 8));
+
+    std::vector<char> truncated(image.begin(), image.end() - 4);
+    CHECK_FALSE(QAssertMetaDbAttach(&db, truncated.data(), truncated.size()));
+
+    std::vector<char> badMagic = image;
+    badMagic[0] ^= 0x55;
+    CHECK_FALSE(QAssertMetaDbAttach(&db, badMagic.data(), badMagic.size()));
+}
+
+TEST(qassert_meta_db_tests, lookup_misses_terminate_on_images_without_an_empty_bucket)
+{
+    //a crafted image: every bucket refers to the first entry
+    std::vector<char> full = image;
+    auto field = [&full](size_t offset) {
+        const unsigned char * p = reinterpret_cast<const unsigned char *>(&full[offset]);
+        return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+    };
+    uint32_t bucketCount = field(offsetof(QAssertMetaDbHeader, bucketCount));
+    uint32_t bucketsOffset = field(offsetof(QAssertMetaDbHeader, bucketsOffset));
+    for (uint32_t i = 0; i < bucketCount; ++i)
+    {
+        char one[4] = {1, 0, 0, 0};
+        std::copy(one, one + 4, &full[bucketsOffset + (i * 4u)]);
+    }
+
+    QAssertMetaDb db;
+    CHECK_TRUE(QAssertMetaDbAttach(&db, full.data(), full.size()));
+    QAssertMetaDbInstall(&db);
+    QAssertMetaDescription description;
+    CHECK_FALSE(QAssertMetaDbLookup(&db, "gobble", 1, &description));
+    CHECK_FALSE(QAssertMetaGetDescription("gobble", 1, &description));
+}
+
+TEST(qassert_meta_db_tests, exported_file_can_be_mapped_and_installed_as_unknown_callback)
+{
+    char path[] = "/tmp/qassert-meta-db-XXXXXX";
+    int fd = mkstemp(path);
+    CHECK_TRUE(fd >= 0);
+    close(fd);
+    CHECK_TRUE(QAssertMetaDbExport(path));
+
+    QAssertMetaDb db;
+    CHECK_TRUE(QAssertMetaDbOpen(&db, path));
+
+    //without the tables linked in, the db answers via the unknown callback
+    QAssertMetaInit();
+    QAssertMetaDescription description;
+    CHECK_FALSE(QAssertMetaGetDescription("app_module", 1, &description));
+    QAssertMetaDbInstall(&db);
+    CHECK_TRUE(QAssertMetaGetDescription("app_module", 1, &description));
+    STRCMP_EQUAL("app tips", description.tips);
+
+    QAssertMetaDbClose(&db);
+    CHECK_FALSE(QAssertMetaGetDescription("app_module", 1, &description));
+    remove(path);
+}
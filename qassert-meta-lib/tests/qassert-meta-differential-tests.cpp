@@ -0,0 +1,439 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CppUTest/TestHarness.h"
+#include "qassert-meta.h"
+#include "qassert-meta.hpp"
+#include "qassert-meta-async.h"
+#include "qassert-meta-db.h"
+#include "qassert-meta-enumerate.h"
+#include "qassert-meta-synthetic.h"
+extern "C" {
+#include "qassert-meta-private.h"
+}
+#include <climits>
+#include <cstdlib>
+#include <poll.h>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Differential tests: random and adversarial queries are run against each
+ * lookup engine and compared with the reference engine (the plain linear
+ * scan). Set QASSERT_META_DIFF_QUERIES to change the number of queries per
+ * configuration (for example millions), and QASSERT_META_DIFF_SEED to
+ * replay a reported divergence.
+ */
+
+using namespace qassert_meta;
+
+namespace {
+
+constexpr unsigned long DEFAULT_QUERIES = 50000;
+constexpr unsigned long DEFAULT_SEED = 1;
+
+unsigned long EnvOr(const char * name, unsigned long fallback)
+{
+    const char * value = getenv(name);
+    return (nullptr == value) ? fallback : strtoul(value, nullptr, 0);
+}
+
+struct Query {
+    bool nullModule;
+    std::string module;
+    int id;
+
+    const char * Module() const { return nullModule ? nullptr : module.c_str(); }
+};
+
+class QueryGenerator {
+public:
+    QueryGenerator(uint64_t seed, std::vector<const QAssertMetaItem *> keys) :
+        m_random(seed), m_keys(std::move(keys))
+    {
+    }
+
+    Query Next()
+    {
+        const QAssertMetaItem & key = *m_keys[m_random() % m_keys.size()];
+        Query query = {false, key.module, key.id};
+        switch (m_random() % 8)
+        {
+            case 0: //exact
+            case 1:
+                break;
+            case 2:
+                query.id = AdversarialId(key.id);
+                break;
+            case 3:
+                query.module = NearMiss(query.module);
+                break;
+            case 4:
+                query.module = NearMiss(query.module);
+                query.id = AdversarialId(key.id);
+                break;
+            case 5:
+                query.nullModule = true;
+                break;
+            case 6:
+                query.module = query.module.substr(0, m_random() % (query.module.size() + 1));
+                break;
+            default: //random text
+                query.module.clear();
+                for (size_t length = m_random() % 12; length > 0; --length)
+                {
+                    query.module += static_cast<char>('_' + (m_random() % 28));
+                }
+                query.id = static_cast<int>(m_random());
+                break;
+        }
+        return query;
+    }
+
+private:
+    int AdversarialId(int id)
+    {
+        switch (m_random() % 7)
+        {
+            case 0: return INT_MIN;
+            case 1: return INT_MAX;
+            case 2: return 0;
+            case 3: return -1;
+            case 4: return (id == INT_MAX) ? id : (id + 1);
+            case 5: return (id == INT_MIN) ? id : (id - 1);
+            default: return static_cast<int>(static_cast<unsigned>(id) ^ (1u << (m_random() % 32)));
+        }
+    }
+
+    std::string NearMiss(std::string module)
+    {
+        size_t position = module.empty() ? 0 : (m_random() % module.size());
+        switch (m_random() % 4)
+        {
+            case 0:
+                if (!module.empty())
+                {
+                    module.pop_back();
+                }
+                break;
+            case 1:
+                module += static_cast<char>('a' + (m_random() % 26));
+                break;
+            case 2:
+                if (!module.empty())
+                {
+                    module[position] = static_cast<char>(module[position] ^ (1 << (m_random() % 7)));
+                    module[position] = (module[position] == '\0') ? 'x' : module[position];
+                }
+                break;
+            default:
+                if (!module.empty() && (module[position] >= 'a') && (module[position] <= 'z'))
+                {
+                    module[position] = static_cast<char>(module[position] - 'a' + 'A');
+                }
+                break;
+        }
+        return module;
+    }
+
+    std::mt19937_64 m_random;
+    std::vector<const QAssertMetaItem *> m_keys;
+};
+
+std::string Describe(const Query & query)
+{
+    return std::string("module ") + (query.nullModule ? "NULL" : ("\"" + query.module + "\"")) +
+           " id " + std::to_string(query.id);
+}
+
+bool SameText(const char * lhs, const char * rhs)
+{
+    return (lhs == rhs) || ((lhs != nullptr) && (rhs != nullptr) && (0 == strcmp(lhs, rhs)));
+}
+
+typedef bool (*Engine)(const char * module, int id, QAssertMetaDescription * output, const void * context);
+
+bool LookupEngine(const char * module, int id, QAssertMetaDescription * output, const void *)
+{
+    return QAssertMetaGetDescription(module, id, output);
+}
+
+bool DbEngine(const char * module, int id, QAssertMetaDescription * output, const void * context)
+{
+    return QAssertMetaDbLookup(static_cast<const QAssertMetaDb *>(context), module, id, output);
+}
+
+//the constexpr index of qassert-meta.hpp, which covers the internal table only
+bool HppEngine(const char * module, int id, QAssertMetaDescription * output, const void *)
+{
+    const QAssertMetaItem * item = qassert_meta::find(module, id);
+    if (nullptr == item)
+    {
+        return false;
+    }
+    *output = item->description;
+    return true;
+}
+
+/**
+ * The first entry of a walk of module/id, which is the one looked up. The
+ * unknown callback is not enumerated, and a NULL module walks all modules,
+ * so it is not a lookup.
+ */
+bool EnumerateEngine(const char * module, int id, QAssertMetaDescription * output, const void *)
+{
+    if (nullptr == module)
+    {
+        return false;
+    }
+
+    QAssertMetaIterator iterator;
+    QAssertMetaEntry entry;
+    QAssertMetaIteratorInit(&iterator, module, id, id);
+    if (!QAssertMetaIteratorNext(&iterator, &entry))
+    {
+        return false;
+    }
+    *output = entry.item->description;
+    return true;
+}
+
+/**
+ * Submits to a polled QAssertMetaAsync: table hits complete inline, others
+ * are waited for, one at a time.
+ */
+bool AsyncEngine(const char * module, int id, QAssertMetaDescription * output, const void * context)
+{
+    QAssertMetaAsync * async = static_cast<QAssertMetaAsync *>(const_cast<void *>(context));
+    switch (QAssertMetaAsyncSubmit(async, module, id, output, nullptr))
+    {
+        case QASSERT_META_ASYNC_FOUND:
+            return true;
+        case QASSERT_META_ASYNC_PENDING:
+            break;
+        default:
+            return false;
+    }
+
+    struct pollfd ready = {QAssertMetaAsyncFd(async), POLLIN, 0};
+    QAssertMetaAsyncCompletion completion;
+    while (0u == QAssertMetaAsyncPoll(async, &completion, 1))
+    {
+        if (1 != poll(&ready, 1, 5000))
+        {
+            return false;
+        }
+    }
+    *output = completion.description;
+    return completion.found;
+}
+
+/**
+ * Copies the module into the middle of a larger buffer, as found in a log
+ * record, so the slice is not terminated.
+ */
+const char * Slice(const char * module, std::string & buffer)
+{
+    if (nullptr == module)
+    {
+        return nullptr;
+    }
+    buffer = std::string("log:") + module + "\xffnot part of the module";
+    return buffer.c_str() + 4;
+}
+
+bool SliceEngine(const char * module, int id, QAssertMetaDescription * output, const void *)
+{
+    std::string buffer;
+    return QAssertMetaGetDescriptionN(Slice(module, buffer), (nullptr != module) ? strlen(module) : 0, id, output);
+}
+
+bool DbSliceEngine(const char * module, int id, QAssertMetaDescription * output, const void * context)
+{
+    std::string buffer;
+    return QAssertMetaDbLookupN(static_cast<const QAssertMetaDb *>(context), Slice(module, buffer),
+                                (nullptr != module) ? strlen(module) : 0, id, output);
+}
+
+/**
+ * Runs the queries against the engine and the reference, failing with a
+ * replayable description on the first divergence.
+ */
+void RunDifferential(const char * configuration, const char * engineName, Engine engine, const void * context,
+                     std::vector<const QAssertMetaItem *> keys, uint64_t seed, bool sameStrings)
+{
+    const unsigned long queries = EnvOr("QASSERT_META_DIFF_QUERIES", DEFAULT_QUERIES);
+    QueryGenerator generator(seed, std::move(keys));
+    for (unsigned long i = 0; i < queries; ++i)
+    {
+        Query query = generator.Next();
+        QAssertMetaDescription expected = {nullptr, nullptr, nullptr};
+        QAssertMetaDescription actual = {nullptr, nullptr, nullptr};
+        bool expectedFound = QAssertMetaPrivateReferenceGetDescription(query.Module(), query.id, &expected);
+        bool actualFound = engine(query.Module(), query.id, &actual, context);
+
+        bool same = (expectedFound == actualFound);
+        if (same && expectedFound)
+        {
+            same = sameStrings ?
+                   (SameText(expected.brief, actual.brief) && SameText(expected.tips, actual.tips) &&
+                    SameText(expected.url, actual.url)) :
+                   ((expected.brief == actual.brief) && (expected.tips == actual.tips) &&
+                    (expected.url == actual.url));
+        }
+
+        if (!same)
+        {
+            FAIL((std::string("divergence: configuration ") + configuration + ", engine " + engineName +
+                  ", seed " + std::to_string(seed) + ", query " + std::to_string(i) + ": " + Describe(query) +
+                  ", reference found " + std::to_string(expectedFound) +
+                  ", engine found " + std::to_string(actualFound)).c_str());
+        }
+    }
+}
+
+std::vector<const QAssertMetaItem *> Keys(std::initializer_list<const QAssertMetaItem *> tables)
+{
+    std::vector<const QAssertMetaItem *> keys;
+    for (const QAssertMetaItem * table : tables)
+    {
+        for (const QAssertMetaItem * item = table; item->module != nullptr; ++item)
+        {
+            keys.push_back(item);
+        }
+    }
+    return keys;
+}
+
+SyntheticTableConfig DifferentialConfig(uint32_t seed)
+{
+    SyntheticTableConfig config;
+    config.itemCount = 2000;
+    config.moduleCount = 200;
+    config.sharedPrefixModules = 100;
+    config.sharedPrefix = "qf_";
+    config.ids = SyntheticIdDistribution::QpFamilies;
+    config.briefLength = 16;
+    config.tipsLength = 16;
+    config.seed = seed;
+    return config;
+}
+
+//overlaps the internal table and itself, so first occurrence rules are exercised
+const QAssertMetaItem OVERLAPPING_TABLE[] = {
+    {"qf_actq", 190, {"overlap internal", nullptr, nullptr}},
+    {"qf_", 100, {"overlap first", nullptr, nullptr}},
+    {"qf_", 100, {"overlap second", nullptr, nullptr}},
+    {"", 0, {"empty module", nullptr, nullptr}},
+    {"qf_actq", INT_MIN, {"min id", nullptr, nullptr}},
+    {"qf_actq", INT_MAX, {"max id", nullptr, nullptr}},
+    {nullptr, 0, {nullptr, nullptr, nullptr}}
+};
+
+const char * const CALLBACK_BRIEF = "from callback";
+
+bool EvenIdCallback(const char *, int id, QAssertMetaDescription * output)
+{
+    if ((id % 2) != 0)
+    {
+        return false;
+    }
+    output->brief = CALLBACK_BRIEF;
+    output->tips = nullptr;
+    output->url = nullptr;
+    return true;
+}
+
+} // namespace
+
+TEST_GROUP(qassert_meta_differential_tests) {
+    uint64_t seed = EnvOr("QASSERT_META_DIFF_SEED", DEFAULT_SEED);
+    QAssertMetaAsync * async = nullptr;
+
+    void setup() final
+    {
+        QAssertMetaInit();
+        QAssertMetaAsyncConfig config = {1, 0, 0, nullptr, nullptr, 0};
+        async = QAssertMetaAsyncCreate(&config);
+        CHECK_TRUE(nullptr != async);
+    }
+
+    void teardown() final
+    {
+        QAssertMetaAsyncDestroy(async);
+        QAssertMetaInit();
+    }
+};
+
+TEST(qassert_meta_differential_tests, internal_table_only)
+{
+    RunDifferential("internal", "lookup", LookupEngine, nullptr, Keys({m_qassert_meta_items}), seed, false);
+    RunDifferential("internal", "slice", SliceEngine, nullptr, Keys({m_qassert_meta_items}), seed, false);
+    RunDifferential("internal", "hpp", HppEngine, nullptr, Keys({m_qassert_meta_items}), seed, true);
+    RunDifferential("internal", "enumerate", EnumerateEngine, nullptr, Keys({m_qassert_meta_items}), seed, false);
+    RunDifferential("internal", "async", AsyncEngine, async, Keys({m_qassert_meta_items}), seed, false);
+}
+
+TEST(qassert_meta_differential_tests, scanned_and_indexed_registered_tables_with_overlaps)
+{
+    SyntheticTable scanned(DifferentialConfig(static_cast<uint32_t>(seed)));
+    SyntheticTable indexed(DifferentialConfig(static_cast<uint32_t>(seed + 1)));
+    std::vector<uint32_t> index(QAssertMetaIndexStorageSize(indexed.Items()) / sizeof(uint32_t));
+    std::vector<uint32_t> overlapIndex(QAssertMetaIndexStorageSize(OVERLAPPING_TABLE) / sizeof(uint32_t));
+
+    CHECK_TRUE(QAssertMetaRegisterIndexedTable(OVERLAPPING_TABLE, overlapIndex.data(),
+                                               overlapIndex.size() * sizeof(uint32_t)));
+    CHECK_TRUE(QAssertMetaRegisterTable(scanned.Items()));
+    CHECK_TRUE(QAssertMetaRegisterIndexedTable(indexed.Items(), index.data(), index.size() * sizeof(uint32_t)));
+
+    auto keys = Keys({m_qassert_meta_items, OVERLAPPING_TABLE, scanned.Items(), indexed.Items()});
+    RunDifferential("registered", "lookup", LookupEngine, nullptr, keys, seed, false);
+    RunDifferential("registered", "slice", SliceEngine, nullptr, keys, seed + 1, false);
+    RunDifferential("registered", "enumerate", EnumerateEngine, nullptr, keys, seed + 2, false);
+    RunDifferential("registered", "async", AsyncEngine, async, keys, seed + 3, false);
+
+    QAssertMetaRegisterUnknownCallback(EvenIdCallback);
+    RunDifferential("registered+callback", "lookup", LookupEngine, nullptr, keys, seed + 2, false);
+    RunDifferential("registered+callback", "async", AsyncEngine, async, keys, seed + 3, false);
+}
+
+TEST(qassert_meta_differential_tests, binary_database)
+{
+    SyntheticTable indexed(DifferentialConfig(static_cast<uint32_t>(seed)));
+    std::vector<uint32_t> index(QAssertMetaIndexStorageSize(indexed.Items()) / sizeof(uint32_t));
+    CHECK_TRUE(QAssertMetaRegisterTable(OVERLAPPING_TABLE));
+    CHECK_TRUE(QAssertMetaRegisterIndexedTable(indexed.Items(), index.data(), index.size() * sizeof(uint32_t)));
+
+    FILE * file = tmpfile();
+    CHECK_TRUE(QAssertMetaDbWrite(file));
+    std::vector<uint32_t> image((static_cast<size_t>(ftell(file)) + 3) / 4);
+    rewind(file);
+    CHECK_EQUAL(1u, fread(image.data(), image.size() * 4, 1, file));
+    fclose(file);
+
+    QAssertMetaDb db;
+    CHECK_TRUE(QAssertMetaDbAttach(&db, image.data(), image.size() * 4));
+    auto keys = Keys({m_qassert_meta_items, OVERLAPPING_TABLE, indexed.Items()});
+    RunDifferential("registered", "db", DbEngine, &db, keys, seed, true);
+    RunDifferential("registered", "db slice", DbSliceEngine, &db, keys, seed + 1, true);
+}
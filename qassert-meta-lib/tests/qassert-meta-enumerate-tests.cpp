@@ -0,0 +1,181 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CppUTest/TestHarness.h"
+#include "qassert-meta-enumerate.h"
+extern "C" {
+#include "qassert-meta-private.h"
+}
+#include <climits>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<QAssertMetaEntry> Walk(const char * module, int minId, int maxId)
+{
+    std::vector<QAssertMetaEntry> entries;
+    QAssertMetaIterator iterator;
+    QAssertMetaIteratorInit(&iterator, module, minId, maxId);
+    QAssertMetaEntry entry;
+    while (QAssertMetaIteratorNext(&iterator, &entry))
+    {
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
+//the unfiltered walk less the entries filtered out
+std::vector<QAssertMetaEntry> Filter(const std::vector<QAssertMetaEntry> & all, const char * module, int minId,
+                                     int maxId)
+{
+    std::vector<QAssertMetaEntry> entries;
+    for (const QAssertMetaEntry & entry : all)
+    {
+        if ((entry.item->id >= minId) && (entry.item->id <= maxId) &&
+            ((nullptr == module) || (0 == strcmp(module, entry.item->module))))
+        {
+            entries.push_back(entry);
+        }
+    }
+    return entries;
+}
+
+void CheckSame(const std::vector<QAssertMetaEntry> & expected, const std::vector<QAssertMetaEntry> & actual)
+{
+    CHECK_EQUAL(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        POINTERS_EQUAL(expected[i].item, actual[i].item);
+        CHECK_EQUAL(expected[i].source, actual[i].source);
+        CHECK_EQUAL(expected[i].table, actual[i].table);
+    }
+}
+
+size_t BuiltinCount()
+{
+    size_t count = 0;
+    while (nullptr != m_qassert_meta_items[count].module)
+    {
+        ++count;
+    }
+    return count;
+}
+
+const QAssertMetaItem m_registered[] = {
+    {"app_pump", 9, {"pump 9", nullptr, nullptr}},
+    {"app_valve", 1, {"valve 1", nullptr, nullptr}},
+    {"app_pump", 3, {"pump 3", nullptr, nullptr}},
+    {nullptr, -1, {nullptr, nullptr, nullptr}}
+};
+
+} // namespace
+
+TEST_GROUP(qassert_meta_enumerate_tests)
+{
+    void setup() final
+    {
+        QAssertMetaInit();
+    }
+
+    void teardown() final
+    {
+        QAssertMetaInit();
+    }
+};
+
+TEST(qassert_meta_enumerate_tests, walks_the_internal_table_in_module_id_order_then_registered_tables)
+{
+    CHECK_TRUE(QAssertMetaRegisterTable(m_registered));
+    std::vector<QAssertMetaEntry> all = Walk(nullptr, INT_MIN, INT_MAX);
+    const size_t builtin = BuiltinCount();
+    CHECK_EQUAL(builtin + 3u, all.size());
+
+    std::vector<bool> seen(builtin, false);
+    for (size_t i = 0; i < builtin; ++i)
+    {
+        CHECK_EQUAL(QASSERT_META_SOURCE_BUILTIN, all[i].source);
+        size_t index = static_cast<size_t>(all[i].item - m_qassert_meta_items);
+        CHECK_TRUE(index < builtin);
+        CHECK_FALSE(seen[index]);
+        seen[index] = true;
+        if (i > 0)
+        {
+            int order = strcmp(all[i - 1].item->module, all[i].item->module);
+            CHECK_TRUE((order < 0) || ((order == 0) && (all[i - 1].item->id <= all[i].item->id)));
+        }
+    }
+
+    for (size_t i = 0; i < 3u; ++i)
+    {
+        POINTERS_EQUAL(&m_registered[i], all[builtin + i].item);
+        CHECK_EQUAL(QASSERT_META_SOURCE_REGISTERED, all[builtin + i].source);
+        CHECK_EQUAL(0u, all[builtin + i].table);
+    }
+}
+
+TEST(qassert_meta_enumerate_tests, filtered_walks_keep_the_order_of_the_unfiltered_walk)
+{
+    CHECK_TRUE(QAssertMetaRegisterTable(m_registered));
+    std::vector<QAssertMetaEntry> all = Walk(nullptr, INT_MIN, INT_MAX);
+
+    const struct {
+        const char * module;
+        int minId;
+        int maxId;
+    } filters[] = {{"qf_actq", INT_MIN, INT_MAX}, {"qf_actq", 100, 199}, {"qf_act", INT_MIN, INT_MAX},
+                   {nullptr, 190, 190}, {nullptr, 200, 299}, {"app_pump", 0, 100}, {"app_pump", 9, 9},
+                   {"no_such_module", INT_MIN, INT_MAX}, {"qf_actq", 0, -1}};
+    for (const auto & filter : filters)
+    {
+        CheckSame(Filter(all, filter.module, filter.minId, filter.maxId),
+                  Walk(filter.module, filter.minId, filter.maxId));
+    }
+    CHECK_TRUE(Walk("qf_actq", INT_MIN, INT_MAX).size() > 1u);
+    CHECK_EQUAL(2u, Walk("app_pump", INT_MIN, INT_MAX).size());
+    CHECK_EQUAL(0u, Walk("qf_actq", 0, -1).size());
+}
+
+TEST(qassert_meta_enumerate_tests, narrow_id_ranges_of_indexed_tables_probe_the_index)
+{
+    std::vector<QAssertMetaItem> items;
+    std::vector<std::string> modules = {"app_a", "app_b"};
+    for (int id = 0; id < 1000; ++id)
+    {
+        items.push_back({modules[static_cast<size_t>(id) % 2u].c_str(), id, {"synthetic", nullptr, nullptr}});
+    }
+    items.push_back({nullptr, -1, {nullptr, nullptr, nullptr}});
+    std::vector<uint32_t> index(QAssertMetaIndexStorageSize(items.data()) / sizeof(uint32_t));
+    CHECK_TRUE(QAssertMetaRegisterIndexedTable(items.data(), index.data(), index.size() * sizeof(uint32_t)));
+    CHECK_TRUE(QAssertMetaRegisterTable(items.data())); //the same items, scanned
+
+    std::vector<QAssertMetaEntry> entries = Walk("app_b", 500, 519);
+    CHECK_EQUAL(20u, entries.size());
+    for (size_t i = 0; i < 10u; ++i)
+    {
+        POINTERS_EQUAL(&items[501u + 2u * i], entries[i].item);
+        CHECK_EQUAL(0u, entries[i].table);
+        POINTERS_EQUAL(&items[501u + 2u * i], entries[10u + i].item);
+        CHECK_EQUAL(1u, entries[10u + i].table);
+    }
+}
@@ -0,0 +1,7 @@
+# Runs a generator built with a table it must reject, checking its message.
+# cmake -DGENERATOR=<generator> -DOUTPUT=<directory> -DEXPECTED=<regex> -P qassert-meta-expect-gen-failure.cmake
+file(MAKE_DIRECTORY ${OUTPUT})
+execute_process(COMMAND ${GENERATOR} ${OUTPUT} RESULT_VARIABLE result ERROR_VARIABLE error)
+if ((result EQUAL 0) OR (NOT error MATCHES "${EXPECTED}"))
+    message(FATAL_ERROR "${GENERATOR} should have failed with \"${EXPECTED}\", exit code ${result}: ${error}")
+endif ()
@@ -0,0 +1,464 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CppUTest/TestHarness.h"
+#include "qassert-meta-extractor.h"
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace qassert_meta;
+
+namespace {
+
+constexpr size_t TREE_FILES = 400;
+constexpr size_t FUNCTIONS_PER_FILE = 100; //~25KB per file, a full QP tree in total
+
+const char QPC_SOURCE[] =
+    "#include \"qp_port.h\"\n"
+    "/* Q_ASSERT_ID(999, comment) */\n"
+    "#define CHECK(x_) Q_ASSERT_ID(x_, 1); \\\n"
+    "    Q_ASSERT_ID(998, 0)\n"
+    "\n"
+    "Q_DEFINE_THIS_MODULE(\"qf_actq\")\n"
+    "\n"
+    "bool QActive_post_(QActive * const me, QEvt const * const e,\n"
+    "                   uint_fast16_t const margin)\n"
+    "{\n"
+    "    char const * s = \"Q_REQUIRE_ID(997, x)\";\n"
+    "    Q_REQUIRE_ID(102, e != (QEvt *)0);\n"
+    "    if (margin == QF_NO_MARGIN) {\n"
+    "        Q_ERROR_ID(190);\n"
+    "    }\n"
+    "    Q_ASSERT_ID(id_, 1); //not a literal\n"
+    "    return true;\n"
+    "}\n"
+    "\n"
+    "void QActive_postLIFO_(QActive * const me, QEvt const * const e) {\n"
+    "    Q_ASSERT_INCRIT(0x12, e);\n"
+    "    Q_ENSURE_ID(  (300U) , 1);\n"
+    "}\n";
+
+const char QPCPP_SOURCE[] =
+    "namespace { Q_DEFINE_THIS_MODULE(\"qf_act\") }\n"
+    "namespace QP {\n"
+    "class X : public Y {\n"
+    "    void inl() noexcept { Q_INVARIANT_ID(5, true); }\n"
+    "};\n"
+    "QActive::QActive(QStateHandler const initial) noexcept\n"
+    "  : QHsm(initial),\n"
+    "    m_prio(0U)\n"
+    "{\n"
+    "    Q_REQUIRE_ID(1'0, 1);\n"
+    "}\n"
+    "bool QActive::post_(QEvt const * const e) const noexcept {\n"
+    "    auto f = []() { Q_ASSERT_ID(101, 1); };\n"
+    "}\n"
+    "} // namespace QP\n"
+    "extern \"C\" {\n"
+    "void cfunc(void) { Q_ERROR_ID(7); }\n"
+    "}\n"
+    "Q_ERROR_ID(8);\n";
+
+std::vector<AssertSite> Scan(const char * source)
+{
+    std::vector<AssertSite> sites;
+    ScanSource(source, strlen(source), "test.c", sites);
+    return sites;
+}
+
+void CheckSite(const AssertSite & site, const char * module, int id, const char * macro, unsigned line,
+               const char * function)
+{
+    STRCMP_EQUAL(module, site.module.c_str());
+    CHECK_EQUAL(id, site.id);
+    STRCMP_EQUAL(macro, site.macro.c_str());
+    CHECK_EQUAL(line, site.line);
+    STRCMP_EQUAL(function, site.function.c_str());
+}
+
+/**
+ * A temporary source tree, removed on destruction.
+ */
+struct SourceTree {
+    SourceTree()
+    {
+        char pattern[] = "/tmp/qassert-meta-extract-XXXXXX";
+        CHECK_TRUE(nullptr != mkdtemp(pattern));
+        root = pattern;
+    }
+
+    ~SourceTree()
+    {
+        for (auto it = paths.rbegin(); it != paths.rend(); ++it)
+        {
+            (void)remove(it->c_str());
+        }
+        (void)rmdir(root.c_str());
+    }
+
+    void AddDirectory(const std::string & name)
+    {
+        std::string path = root + "/" + name;
+        CHECK_EQUAL(0, mkdir(path.c_str(), 0700));
+        paths.push_back(path);
+    }
+
+    void AddFile(const std::string & name, const std::string & content)
+    {
+        std::string path = root + "/" + name;
+        WriteFile(path, content);
+        paths.push_back(path);
+    }
+
+    static void WriteFile(const std::string & path, const std::string & content)
+    {
+        FILE * file = fopen(path.c_str(), "w");
+        CHECK_TRUE(nullptr != file);
+        fwrite(content.data(), 1, content.size(), file);
+        fclose(file);
+    }
+
+    //as if written long before a scan, so never racy
+    static void SetModified(const std::string & path, time_t secondsAgo)
+    {
+        struct timespec times[2];
+        times[0].tv_sec = time(nullptr) - secondsAgo;
+        times[0].tv_nsec = 0;
+        times[1] = times[0];
+        CHECK_EQUAL(0, utimensat(AT_FDCWD, path.c_str(), times, 0));
+    }
+
+    std::string root;
+    std::vector<std::string> paths;
+};
+
+std::string SyntheticSource(size_t file)
+{
+    std::string source = "Q_DEFINE_THIS_MODULE(\"mod_" + std::to_string(file) + "\")\n";
+    for (size_t f = 0; f < FUNCTIONS_PER_FILE; ++f)
+    {
+        source += "/* Describe the function, parameters and return value of this function in some detail,\n"
+                  " * as QP sources do. */\n"
+                  "void Function_" + std::to_string(f) + "(QActive * const me, QEvt const * const e) {\n"
+                  "    QF_CRIT_STAT\n"
+                  "    QF_CRIT_ENTRY();\n"
+                  "    Q_REQUIRE_INCRIT(" + std::to_string(f) + ", e != (QEvt *)0);\n"
+                  "    QF_CRIT_EXIT();\n"
+                  "}\n";
+    }
+    return source;
+}
+
+} // namespace
+
+TEST_GROUP(qassert_meta_extractor_tests) {
+    void setup() final
+    {
+    }
+
+    void teardown() final
+    {
+    }
+};
+
+TEST(qassert_meta_extractor_tests, finds_qpc_asserts_with_module_line_and_function)
+{
+    std::vector<AssertSite> sites = Scan(QPC_SOURCE);
+
+    CHECK_EQUAL(4u, sites.size());
+    CheckSite(sites[0], "qf_actq", 102, "Q_REQUIRE_ID", 12, "QActive_post_");
+    CheckSite(sites[1], "qf_actq", 190, "Q_ERROR_ID", 14, "QActive_post_");
+    CheckSite(sites[2], "qf_actq", 0x12, "Q_ASSERT_INCRIT", 21, "QActive_postLIFO_");
+    CheckSite(sites[3], "qf_actq", 300, "Q_ENSURE_ID", 22, "QActive_postLIFO_");
+}
+
+TEST(qassert_meta_extractor_tests, finds_qpcpp_asserts_in_namespaces_classes_and_constructors)
+{
+    std::vector<AssertSite> sites = Scan(QPCPP_SOURCE);
+
+    CHECK_EQUAL(5u, sites.size());
+    CheckSite(sites[0], "qf_act", 5, "Q_INVARIANT_ID", 4, "inl");
+    CheckSite(sites[1], "qf_act", 10, "Q_REQUIRE_ID", 10, "QActive::QActive");
+    CheckSite(sites[2], "qf_act", 101, "Q_ASSERT_ID", 13, "QActive::post_");
+    CheckSite(sites[3], "qf_act", 7, "Q_ERROR_ID", 17, "cfunc");
+    CheckSite(sites[4], "qf_act", 8, "Q_ERROR_ID", 19, "");
+}
+
+TEST(qassert_meta_extractor_tests, define_this_file_uses_the_file_name_as_module)
+{
+    std::vector<AssertSite> sites;
+    const char source[] = "Q_DEFINE_THIS_FILE\nvoid f(void) { Q_ASSERT_ID(1, 0); }\n";
+    ScanSource(source, strlen(source), "src/qf/qf_time.c", sites);
+
+    CHECK_EQUAL(1u, sites.size());
+    CheckSite(sites[0], "qf_time.c", 1, "Q_ASSERT_ID", 2, "f");
+}
+
+TEST(qassert_meta_extractor_tests, parallel_extraction_matches_serial_and_flags_stale_table_ids)
+{
+    SourceTree tree;
+    tree.AddDirectory("src");
+    tree.AddDirectory("src/.git");
+    tree.AddFile("src/qf_actq.c", QPC_SOURCE);
+    tree.AddFile("src/qf_act.cpp", QPCPP_SOURCE);
+    tree.AddFile("src/README.md", "Q_ASSERT_ID(1, 0)");
+    tree.AddFile("src/.git/qf_hidden.c", "Q_DEFINE_THIS_MODULE(\"hidden\")\nQ_ASSERT_ID(1, 0)");
+
+    std::vector<std::string> files;
+    CHECK_TRUE(ListSourceFiles(tree.root, files));
+    CHECK_EQUAL(2u, files.size());
+
+    std::vector<FileScan> serial = ExtractAsserts(files, 1);
+    std::vector<FileScan> parallel = ExtractAsserts(files, 4);
+    CHECK_EQUAL(serial.size(), parallel.size());
+    for (size_t i = 0; i < serial.size(); ++i)
+    {
+        CHECK_TRUE(parallel[i].ok);
+        CHECK_EQUAL(serial[i].sites.size(), parallel[i].sites.size());
+        for (size_t s = 0; s < serial[i].sites.size(); ++s)
+        {
+            CHECK_EQUAL(serial[i].sites[s].id, parallel[i].sites[s].id);
+            CHECK_EQUAL(serial[i].sites[s].line, parallel[i].sites[s].line);
+        }
+    }
+
+    static const QAssertMetaItem table[] = {
+        {"qf_actq", 102, {"present", nullptr, nullptr}},
+        {"qf_actq", 110, {"renumbered", nullptr, nullptr}},
+        {"qf_mem", 100, {"not scanned", nullptr, nullptr}},
+        {nullptr, 0, {nullptr, nullptr, nullptr}}
+    };
+    std::vector<StaleItem> stale = FindStaleItems(table, parallel);
+    CHECK_EQUAL(2u, stale.size());
+    CHECK_EQUAL(110, stale[0].item->id);
+    CHECK_TRUE(stale[0].moduleFound);
+    STRCMP_EQUAL("qf_mem", stale[1].item->module);
+    CHECK_FALSE(stale[1].moduleFound);
+
+    std::vector<const AssertSite *> undocumented = FindUndocumentedSites(table, parallel);
+    CHECK_EQUAL(8u, undocumented.size());
+}
+
+TEST(qassert_meta_extractor_tests, extracted_table_keeps_known_descriptions)
+{
+    std::vector<FileScan> scans(1);
+    ScanSource(QPC_SOURCE, strlen(QPC_SOURCE), "qf_actq.c", scans[0].sites);
+    static const QAssertMetaItem known[] = {
+        {"qf_actq", 190, {"queue full", "tip \"quoted\" ?\?=\t\xc3\xa9", nullptr}},
+        {nullptr, 0, {nullptr, nullptr, nullptr}}
+    };
+
+    char * buffer = nullptr;
+    size_t size = 0;
+    FILE * file = open_memstream(&buffer, &size);
+    CHECK_TRUE(WriteExtractedTableSource(file, scans, known, "app_items"));
+    fclose(file);
+    std::string source(buffer, size);
+    free(buffer);
+
+    STRCMP_CONTAINS("const QAssertMetaItem app_items[] = {", source.c_str());
+    STRCMP_CONTAINS("// qf_actq.c:14 Q_ERROR_ID in QActive_post_\n"
+                    "    {\"qf_actq\", 190, {\"queue full\", \"tip \\\"quoted\\\" \\?\\?=\\011\\303\\251\", NULL}},",
+                    source.c_str());
+    STRCMP_CONTAINS("{\"qf_actq\", 18, {\"Undocumented Q_ASSERT_INCRIT in QActive_postLIFO_()\", NULL, NULL}},",
+                    source.c_str());
+    STRCMP_CONTAINS("{NULL, -1, {NULL, NULL, NULL}}", source.c_str());
+}
+
+TEST(qassert_meta_extractor_tests, extracted_locations_are_relative_to_the_root)
+{
+    std::vector<FileScan> scans(1);
+    ScanSource(QPC_SOURCE, strlen(QPC_SOURCE), "/qpc/src/qf/qf_actq.c", scans[0].sites);
+
+    char * buffer = nullptr;
+    size_t size = 0;
+    FILE * file = open_memstream(&buffer, &size);
+    CHECK_TRUE(WriteExtractedLocationsSource(file, scans, "/qpc/"));
+    fclose(file);
+    std::string source(buffer, size);
+    free(buffer);
+
+    STRCMP_CONTAINS("const QAssertMetaLocationItem m_qassert_meta_location_items[] = {", source.c_str());
+    STRCMP_CONTAINS("    {\"qf_actq\", 190, {\"src/qf/qf_actq.c\", 14, \"QActive_post_\"}},", source.c_str());
+    STRCMP_CONTAINS("{NULL, -1, {NULL, 0, NULL}}", source.c_str());
+}
+
+//the scan time is reported by qassert-meta-extract, not asserted here
+TEST(qassert_meta_extractor_tests, scans_a_qp_sized_tree)
+{
+    SourceTree tree;
+    for (size_t i = 0; i < TREE_FILES; ++i)
+    {
+        tree.AddFile("qf_" + std::to_string(i) + ".c", SyntheticSource(i));
+    }
+
+    std::vector<std::string> files;
+    CHECK_TRUE(ListSourceFiles(tree.root, files));
+    std::vector<FileScan> scans = ExtractAsserts(files, std::thread::hardware_concurrency());
+
+    size_t sites = 0;
+    for (const FileScan & scan : scans)
+    {
+        sites += scan.sites.size();
+    }
+    CHECK_EQUAL(TREE_FILES * FUNCTIONS_PER_FILE, sites);
+}
+
+TEST(qassert_meta_extractor_tests, cache_reuses_unchanged_files_and_rescans_changed_ones)
+{
+    SourceTree tree;
+    tree.AddFile("qf_actq.c", QPC_SOURCE);
+    tree.AddFile("qf_act.cpp", QPCPP_SOURCE);
+    tree.AddFile("qf_time.c", "Q_DEFINE_THIS_MODULE(\"qf_time\")\nvoid f(void) { Q_ASSERT_ID(1, 0); }\n");
+    std::vector<std::string> files;
+    CHECK_TRUE(ListSourceFiles(tree.root, files));
+    for (const std::string & file : files)
+    {
+        SourceTree::SetModified(file, 3600);
+    }
+    std::string cachePath = tree.root + "/extract.cache";
+    tree.paths.push_back(cachePath);
+
+    ExtractCacheStats stats;
+    {
+        ExtractCache cold;
+        CHECK_TRUE(cold.Update(files, 2, &stats));
+        CHECK_EQUAL(3u, stats.rescanned);
+        CHECK_TRUE(cold.Save(cachePath));
+    }
+
+    ExtractCache cache;
+    CHECK_TRUE(cache.Load(cachePath));
+    CHECK_FALSE(cache.Update(files, 2, &stats));
+    CHECK_EQUAL(3u, stats.reused);
+    std::vector<FileScan> cached = cache.Scans();
+    std::vector<FileScan> direct = ExtractAsserts(files, 1);
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        CHECK_EQUAL(direct[i].sites.size(), cached[i].sites.size());
+        for (size_t s = 0; s < direct[i].sites.size(); ++s)
+        {
+            STRCMP_EQUAL(direct[i].sites[s].module.c_str(), cached[i].sites[s].module.c_str());
+            CHECK_EQUAL(direct[i].sites[s].id, cached[i].sites[s].id);
+            STRCMP_EQUAL(direct[i].sites[s].function.c_str(), cached[i].sites[s].function.c_str());
+            STRCMP_EQUAL(direct[i].sites[s].file.c_str(), cached[i].sites[s].file.c_str());
+            CHECK_EQUAL(direct[i].sites[s].line, cached[i].sites[s].line);
+        }
+    }
+
+    //same content, new modification time: read and hashed, not rescanned
+    SourceTree::SetModified(files[0], 1800);
+    CHECK_FALSE(cache.Update(files, 2, &stats));
+    CHECK_EQUAL(1u, stats.rehashed);
+    CHECK_EQUAL(0u, stats.rescanned);
+
+    //changed content
+    SourceTree::WriteFile(files[1], std::string(QPC_SOURCE) + "void g(void) { Q_ERROR_ID(500); }\n");
+    SourceTree::SetModified(files[1], 1800);
+    CHECK_TRUE(cache.Update(files, 2, &stats));
+    CHECK_EQUAL(1u, stats.rescanned);
+    CHECK_EQUAL(500, cache.Scans()[1].sites.back().id);
+
+    //removed from the tree
+    files.pop_back();
+    CHECK_TRUE(cache.Update(files, 2, &stats));
+    CHECK_EQUAL(1u, stats.removed);
+    CHECK_EQUAL(2u, cache.Size());
+}
+
+TEST(qassert_meta_extractor_tests, recently_modified_files_are_rehashed_by_the_next_scan)
+{
+    SourceTree tree;
+    tree.AddFile("qf_actq.c", QPC_SOURCE);
+    std::vector<std::string> files;
+    CHECK_TRUE(ListSourceFiles(tree.root, files));
+
+    ExtractCache cache;
+    ExtractCacheStats stats;
+    CHECK_TRUE(cache.Update(files, 1, &stats));
+    CHECK_FALSE(cache.Update(files, 1, &stats));
+    CHECK_EQUAL(0u, stats.reused);
+    CHECK_EQUAL(1u, stats.rehashed);
+}
+
+TEST(qassert_meta_extractor_tests, invalid_cache_files_are_rejected)
+{
+    SourceTree tree;
+    tree.AddFile("qf_actq.c", QPC_SOURCE);
+    std::vector<std::string> files;
+    CHECK_TRUE(ListSourceFiles(tree.root, files));
+    std::string cachePath = tree.root + "/extract.cache";
+    tree.paths.push_back(cachePath);
+
+    ExtractCache cache;
+    CHECK_FALSE(cache.Load(cachePath));
+    CHECK_TRUE(cache.Update(files, 1));
+    CHECK_TRUE(cache.Save(cachePath));
+
+    FILE * file = fopen(cachePath.c_str(), "rb");
+    std::string data(4096, '\0');
+    data.resize(fread(&data[0], 1, data.size(), file));
+    fclose(file);
+
+    SourceTree::WriteFile(cachePath, data.substr(0, data.size() - 1));
+    CHECK_FALSE(cache.Load(cachePath));
+    CHECK_EQUAL(0u, cache.Size());
+
+    data[0] = 'X';
+    SourceTree::WriteFile(cachePath, data);
+    CHECK_FALSE(cache.Load(cachePath));
+    CHECK_EQUAL(0u, cache.Size());
+}
+
+//the cold and warm timings are reported by qassert-meta-extract, not asserted here
+TEST(qassert_meta_extractor_tests, warm_cache_scan_reuses_every_file_without_rescanning)
+{
+    SourceTree tree;
+    for (size_t i = 0; i < TREE_FILES; ++i)
+    {
+        tree.AddFile("qf_" + std::to_string(i) + ".c", SyntheticSource(i));
+        SourceTree::SetModified(tree.paths.back(), 3600);
+    }
+    std::string cachePath = tree.root + "/extract.cache";
+    tree.paths.push_back(cachePath);
+    std::vector<std::string> files;
+    CHECK_TRUE(ListSourceFiles(tree.root, files));
+
+    {
+        ExtractCache cold;
+        CHECK_TRUE(cold.Update(files, std::thread::hardware_concurrency()));
+        CHECK_TRUE(cold.Save(cachePath));
+    }
+
+    ExtractCache warm;
+    ExtractCacheStats stats;
+    CHECK_TRUE(warm.Load(cachePath));
+    CHECK_FALSE(warm.Update(files, std::thread::hardware_concurrency(), &stats));
+    CHECK_EQUAL(TREE_FILES, stats.reused);
+}
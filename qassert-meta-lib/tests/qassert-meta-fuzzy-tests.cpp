@@ -0,0 +1,92 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CppUTest/TestHarness.h"
+#include "qassert-meta-fuzzy.h"
+
+TEST_GROUP(qassert_meta_fuzzy_tests) {
+    QAssertMetaFuzzyMatch matches[4];
+
+    void setup() final
+    {
+    }
+
+    void teardown() final
+    {
+    }
+};
+
+TEST(qassert_meta_fuzzy_tests, exact_module_and_id_is_best_match_with_full_confidence)
+{
+    CHECK_TRUE(QAssertMetaFuzzyLookup("qf_actq", 190, matches, 4) > 0);
+    STRCMP_EQUAL("qf_actq", matches[0].item->module);
+    CHECK_EQUAL(190, matches[0].item->id);
+    CHECK_EQUAL(100u, matches[0].confidence);
+}
+
+TEST(qassert_meta_fuzzy_tests, truncated_module_resolves_with_reduced_confidence)
+{
+    CHECK_TRUE(QAssertMetaFuzzyLookup("qf_ac", 190, matches, 4) > 0);
+    STRCMP_EQUAL("qf_actq", matches[0].item->module);
+    CHECK_EQUAL(190, matches[0].item->id);
+    CHECK_TRUE(matches[0].confidence < 100u);
+    CHECK_TRUE(matches[0].confidence > 80u);
+
+    CHECK_TRUE(QAssertMetaFuzzyLookup("qep_hs", 220, matches, 4) > 0);
+    STRCMP_EQUAL("qep_hsm", matches[0].item->module);
+    CHECK_EQUAL(220, matches[0].item->id);
+}
+
+TEST(qassert_meta_fuzzy_tests, corrupted_module_character_resolves_by_edit_distance)
+{
+    CHECK_TRUE(QAssertMetaFuzzyLookup("qf_dxn", 500, matches, 4) > 0);
+    STRCMP_EQUAL("qf_dyn", matches[0].item->module);
+    CHECK_EQUAL(500, matches[0].item->id);
+}
+
+TEST(qassert_meta_fuzzy_tests, bit_flipped_id_resolves_to_nearest_id)
+{
+    //190 with bit 10 flipped
+    CHECK_TRUE(QAssertMetaFuzzyLookup("qf_actq", 190 ^ 0x400, matches, 4) > 0);
+    STRCMP_EQUAL("qf_actq", matches[0].item->module);
+    CHECK_EQUAL(190, matches[0].item->id);
+    CHECK_EQUAL(80u, matches[0].confidence);
+}
+
+TEST(qassert_meta_fuzzy_tests, matches_are_ordered_by_confidence_and_limited_to_capacity)
+{
+    size_t count = QAssertMetaFuzzyLookup("qf_time", 150, matches, 4);
+    CHECK_EQUAL(4u, count);
+    for (size_t i = 1; i < count; ++i)
+    {
+        CHECK_TRUE(matches[i - 1].confidence >= matches[i].confidence);
+    }
+}
+
+TEST(qassert_meta_fuzzy_tests, unrelated_or_invalid_input_has_no_matches)
+{
+    CHECK_EQUAL(0u, QAssertMetaFuzzyLookup("zzzzzzzz", 190, matches, 4));
+    CHECK_EQUAL(0u, QAssertMetaFuzzyLookup(nullptr, 190, matches, 4));
+    CHECK_EQUAL(0u, QAssertMetaFuzzyLookup("", 190, matches, 4));
+    CHECK_EQUAL(0u, QAssertMetaFuzzyLookup("qf_actq", 190, nullptr, 4));
+    CHECK_EQUAL(0u, QAssertMetaFuzzyLookup("qf_actq", 190, matches, 0));
+}
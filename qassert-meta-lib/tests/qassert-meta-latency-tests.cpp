@@ -0,0 +1,94 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CppUTest/TestHarness.h"
+#include "qassert-meta.h"
+#include "qassert-meta-latency.h"
+#include <string>
+#include <vector>
+
+TEST_GROUP(qassert_meta_latency_tests) {
+    QAssertMetaLatencyHistogram histogram;
+
+    void setup() final
+    {
+        QAssertMetaInit();
+        QAssertMetaLatencyReset();
+    }
+
+    void teardown() final
+    {
+    }
+
+    uint32_t Total(QAssertMetaLatencyCategory category)
+    {
+        uint32_t total = 0;
+        for (uint32_t count : histogram.buckets[category])
+        {
+            total += count;
+        }
+        return total;
+    }
+};
+
+#if QASSERT_META_ENABLE_LATENCY_HISTOGRAM
+
+TEST(qassert_meta_latency_tests, each_lookup_is_recorded_in_its_outcome_histogram)
+{
+    QAssertMetaDescription description;
+    QAssertMetaGetDescription("qf_actq", 190, &description);
+    QAssertMetaGetDescription("qf_actq", 102, &description);
+    QAssertMetaGetDescription("gobble", 1, &description);
+    QAssertMetaRegisterUnknownCallback([](const char *, int, QAssertMetaDescription *) { return true; });
+    QAssertMetaGetDescription("gobble", 1, &description);
+
+    CHECK_TRUE(QAssertMetaLatencyGetHistogram(&histogram));
+    CHECK_EQUAL(2u, Total(QASSERT_META_LATENCY_BUILTIN_HIT));
+    CHECK_EQUAL(0u, Total(QASSERT_META_LATENCY_REGISTERED_HIT));
+    CHECK_EQUAL(1u, Total(QASSERT_META_LATENCY_CALLBACK_HIT));
+    CHECK_EQUAL(1u, Total(QASSERT_META_LATENCY_MISS));
+}
+
+TEST(qassert_meta_latency_tests, dump_writes_a_line_per_non_empty_bucket)
+{
+    QAssertMetaDescription description;
+    QAssertMetaGetDescription("qf_actq", 190, &description);
+
+    std::vector<std::string> lines;
+    CHECK_TRUE(QAssertMetaLatencyDump([](const char * line, void * context) {
+        static_cast<std::vector<std::string> *>(context)->push_back(line);
+    }, &lines));
+
+    CHECK_EQUAL(1u, lines.size());
+    STRCMP_CONTAINS("builtin_hit [", lines[0].c_str());
+    STRCMP_CONTAINS(QAssertMetaLatencyUnit(), lines[0].c_str());
+}
+
+#else
+
+TEST(qassert_meta_latency_tests, histogram_is_unavailable_when_disabled)
+{
+    CHECK_FALSE(QAssertMetaLatencyGetHistogram(&histogram));
+    CHECK_FALSE(QAssertMetaLatencyDump([](const char *, void *) {}, nullptr));
+}
+
+#endif
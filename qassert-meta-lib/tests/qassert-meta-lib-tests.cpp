@@ -22,6 +22,8 @@
 
 #include "CppUTest/TestHarness.h"
 #include "qassert-meta.h"
+#include <cstring>
+#include <string>
 
 TEST_GROUP(qassert_meta_lib_tests) {
     void setup() final
@@ -49,6 +51,53 @@ TEST(qassert_meta_lib_tests, description_returns_false_if_output_param_is_null)
     CHECK_FALSE(QAssertMetaGetDescription("qf_actq", 102, nullptr));
 }
 
+TEST(qassert_meta_lib_tests, location_is_unavailable_when_built_without_locations)
+{
+    QAssertMetaLocation location;
+    CHECK_FALSE(QAssertMetaGetLocation("qf_actq", 102, &location));
+    CHECK_FALSE(QAssertMetaGetLocation("qf_actq", 102, nullptr));
+    CHECK_FALSE(QAssertMetaGetLocation(nullptr, 102, &location));
+}
+
+TEST(qassert_meta_lib_tests, module_slice_of_a_larger_buffer_is_looked_up_in_place)
+{
+    static const char RECORD[] = "ASSERT qf_actq:190 qf_actqueue";
+    QAssertMetaDescription expected;
+    QAssertMetaDescription description;
+    CHECK_TRUE(QAssertMetaGetDescription("qf_actq", 190, &expected));
+
+    CHECK_TRUE(QAssertMetaGetDescriptionN(RECORD + 7, 7, 190, &description));
+    POINTERS_EQUAL(expected.brief, description.brief);
+    CHECK_TRUE(QAssertMetaGetDescriptionN(RECORD + 19, 7, 190, &description));
+    CHECK_FALSE(QAssertMetaGetDescriptionN(RECORD + 7, 6, 190, &description));
+    CHECK_FALSE(QAssertMetaGetDescriptionN(RECORD + 19, 11, 190, &description));
+    CHECK_FALSE(QAssertMetaGetDescriptionN("qf_actq\0x", 9, 190, &description));
+    CHECK_FALSE(QAssertMetaGetDescriptionN(nullptr, 7, 190, &description));
+    CHECK_FALSE(QAssertMetaGetDescriptionN(RECORD + 7, 7, 190, nullptr));
+}
+
+TEST(qassert_meta_lib_tests, unknown_callback_receives_a_terminated_copy_of_a_short_slice)
+{
+    static std::string callbackModule;
+    static int calls = 0;
+    calls = 0;
+    QAssertMetaRegisterUnknownCallback([](const char * module, int, QAssertMetaDescription*) {
+        callbackModule = module;
+        ++calls;
+        return false;
+    });
+
+    static const char RECORD[] = "app_motorXYZ";
+    QAssertMetaDescription description;
+    CHECK_FALSE(QAssertMetaGetDescriptionN(RECORD, 9, 1, &description));
+    CHECK_EQUAL(1, calls);
+    STRCMP_EQUAL("app_motor", callbackModule.c_str());
+
+    std::string longModule(QASSERT_META_CALLBACK_MODULE_SIZE, 'm');
+    CHECK_FALSE(QAssertMetaGetDescriptionN(longModule.c_str(), longModule.size(), 1, &description));
+    CHECK_EQUAL(1, calls);
+}
+
 TEST(qassert_meta_lib_tests, can_register_callback_for_unknown_asserts)
 {
     constexpr const char * TEST_UNKNOWN_MODULE = "gobble";
@@ -98,6 +147,106 @@ TEST(qassert_meta_lib_tests, unknown_callback_if_true_then_returns_true_and_outp
     CHECK_EQUAL(nullptr, description.url);
 }
 
+TEST(qassert_meta_lib_tests, registered_table_is_searched_after_internal_table)
+{
+    static const QAssertMetaItem appTable[] = {
+        {"app_module", 1, {"app brief", "app tips", nullptr}},
+        {"qf_actq", 102, {"override attempt", nullptr, nullptr}},
+        {nullptr, 0, {nullptr, nullptr, nullptr}}
+    };
+    QAssertMetaDescription description = {nullptr, nullptr, nullptr};
+
+    CHECK_FALSE(QAssertMetaGetDescription("app_module", 1, &description));
+    CHECK_TRUE(QAssertMetaRegisterTable(appTable));
+    CHECK_TRUE(QAssertMetaGetDescription("app_module", 1, &description));
+    STRCMP_EQUAL("app brief", description.brief);
+
+    CHECK_TRUE(QAssertMetaGetDescription("qf_actq", 102, &description));
+    STRCMP_CONTAINS("QActive post", description.brief);
+}
+
+TEST(qassert_meta_lib_tests, register_table_rejects_null_and_too_many_tables)
+{
+    static const QAssertMetaItem emptyTable[] = {
+        {nullptr, 0, {nullptr, nullptr, nullptr}}
+    };
+
+    CHECK_FALSE(QAssertMetaRegisterTable(nullptr));
+    for (int i = 0; i < QASSERT_META_MAX_REGISTERED_TABLES; ++i)
+    {
+        CHECK_TRUE(QAssertMetaRegisterTable(emptyTable));
+    }
+    CHECK_FALSE(QAssertMetaRegisterTable(emptyTable));
+
+    QAssertMetaInit();
+    CHECK_TRUE(QAssertMetaRegisterTable(emptyTable));
+}
+
+TEST(qassert_meta_lib_tests, indexed_table_is_searched_and_first_duplicate_wins)
+{
+    static const QAssertMetaItem appTable[] = {
+        {"app_module", 1, {"first", nullptr, nullptr}},
+        {"app_module", 2, {"second", nullptr, nullptr}},
+        {"app_module", 1, {"duplicate", nullptr, nullptr}},
+        {nullptr, 0, {nullptr, nullptr, nullptr}}
+    };
+    uint32_t index[64];
+    QAssertMetaDescription description = {nullptr, nullptr, nullptr};
+
+    CHECK_TRUE(QAssertMetaIndexStorageSize(appTable) <= sizeof(index));
+    CHECK_TRUE(QAssertMetaRegisterIndexedTable(appTable, index, sizeof(index)));
+    CHECK_TRUE(QAssertMetaGetDescription("app_module", 1, &description));
+    STRCMP_EQUAL("first", description.brief);
+    CHECK_TRUE(QAssertMetaGetDescription("app_module", 2, &description));
+    STRCMP_EQUAL("second", description.brief);
+    CHECK_FALSE(QAssertMetaGetDescription("app_module", 3, &description));
+    CHECK_FALSE(QAssertMetaGetDescription("app_modul", 1, &description));
+}
+
+TEST(qassert_meta_lib_tests, index_is_built_by_the_first_lookup_reaching_the_table)
+{
+    static const QAssertMetaItem appTable[] = {
+        {"app_module", 1, {"first", nullptr, nullptr}},
+        {nullptr, 0, {nullptr, nullptr, nullptr}}
+    };
+    uint32_t index[64];
+    memset(index, 0xA5, sizeof(index));
+    QAssertMetaDescription description = {nullptr, nullptr, nullptr};
+
+    CHECK_TRUE(QAssertMetaRegisterIndexedTable(appTable, index, sizeof(index)));
+    CHECK_EQUAL(0xA5A5A5A5u, index[0]);
+
+    //resolved by the internal table, never reaching the registered table
+    CHECK_TRUE(QAssertMetaGetDescription("qf_actq", 190, &description));
+    CHECK_EQUAL(0xA5A5A5A5u, index[0]);
+
+    CHECK_TRUE(QAssertMetaGetDescription("app_module", 1, &description));
+    STRCMP_EQUAL("first", description.brief);
+    CHECK_TRUE(0xA5A5A5A5u != index[0]);
+}
+
+TEST(qassert_meta_lib_tests, indexed_table_registration_rejects_insufficient_or_misaligned_storage)
+{
+    static const QAssertMetaItem appTable[] = {
+        {"app_module", 1, {"first", nullptr, nullptr}},
+        {nullptr, 0, {nullptr, nullptr, nullptr}}
+    };
+    uint32_t index[64];
+    size_t required = QAssertMetaIndexStorageSize(appTable);
+
+    CHECK_FALSE(QAssertMetaRegisterIndexedTable(appTable, index, required - 1));
+    CHECK_FALSE(QAssertMetaRegisterIndexedTable(appTable, reinterpret_cast<char *>(index) + 1, required));
+    CHECK_FALSE(QAssertMetaRegisterIndexedTable(nullptr, index, sizeof(index)));
+    CHECK_FALSE(QAssertMetaRegisterIndexedTable(appTable, nullptr, sizeof(index)));
+    CHECK_TRUE(QAssertMetaRegisterIndexedTable(appTable, index, required));
+
+    QAssertMetaFootprint footprint;
+    QAssertMetaGetFootprint(&footprint);
+    CHECK_EQUAL(1u, footprint.registeredTables);
+    CHECK_EQUAL(1u, footprint.registeredItems);
+    CHECK_EQUAL(required, footprint.indexBytes);
+}
+
 TEST(qassert_meta_lib_tests, if_qassert_is_known_returns_true_and_description_is_filled)
 {
     QAssertMetaDescription description = {nullptr, nullptr, nullptr};
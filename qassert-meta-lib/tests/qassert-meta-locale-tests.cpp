@@ -0,0 +1,172 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CppUTest/TestHarness.h"
+#include "qassert-meta.h"
+#include "qassert-meta-locale.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+static const QAssertMetaTranslation GERMAN[] = {
+    {"qf_actq", 190, "Ereigniswarteschlange voll", "Warteschlange vergrößern"},
+    {"qf_actq", 102, "nur kurz", nullptr},
+    {"qf_actq", 190, "Duplikat", nullptr},
+    {"no_such_module", 1, "nicht in der Tabelle", nullptr}
+};
+
+static const QAssertMetaTranslation JAPANESE[] = {
+    {"qf_actq", 190, "イベントキューが満杯", nullptr}
+};
+
+static const QAssertMetaItem TEST_APP_TABLE[] = {
+    {"app_module", 1, {"app brief", "app tips", nullptr}},
+    {nullptr, 0, {nullptr, nullptr, nullptr}}
+};
+
+TEST_GROUP(qassert_meta_locale_tests) {
+    std::vector<std::string> paths;
+
+    void setup() final
+    {
+        QAssertMetaInit();
+        QAssertMetaLocaleReset();
+    }
+
+    void teardown() final
+    {
+        QAssertMetaLocaleReset();
+        for (const std::string & path : paths)
+        {
+            unlink(path.c_str());
+        }
+    }
+
+    std::string WritePack(const char * locale, const QAssertMetaTranslation * translations, size_t count,
+                          size_t * unmatched = nullptr)
+    {
+        char path[] = "/tmp/qassert-meta-locale-XXXXXX";
+        int fd = mkstemp(path);
+        CHECK_TRUE(fd >= 0);
+        FILE * file = fdopen(fd, "wb");
+        CHECK_TRUE(QAssertMetaLocaleWritePack(file, locale, translations, count, unmatched));
+        CHECK_EQUAL(0, fclose(file));
+        paths.push_back(path);
+        return path;
+    }
+};
+
+TEST(qassert_meta_locale_tests, translated_fields_replace_english_and_missing_fields_fall_back)
+{
+    size_t unmatched = 0;
+    CHECK_TRUE(QAssertMetaLocaleRegister("de", WritePack("de", GERMAN, 4, &unmatched).c_str()));
+    CHECK_EQUAL(1u, unmatched);
+
+    QAssertMetaDescription english;
+    QAssertMetaDescription german;
+    CHECK_TRUE(QAssertMetaGetDescription("qf_actq", 190, &english));
+    CHECK_TRUE(QAssertMetaGetLocalizedDescription("de", "qf_actq", 190, &german));
+    STRCMP_EQUAL("Ereigniswarteschlange voll", german.brief);
+    STRCMP_EQUAL("Warteschlange vergrößern", german.tips);
+    POINTERS_EQUAL(english.url, german.url);
+
+    CHECK_TRUE(QAssertMetaGetDescription("qf_actq", 102, &english));
+    CHECK_TRUE(QAssertMetaGetLocalizedDescription("de", "qf_actq", 102, &german));
+    STRCMP_EQUAL("nur kurz", german.brief);
+    POINTERS_EQUAL(english.tips, german.tips);
+
+    CHECK_TRUE(QAssertMetaGetDescription("qf_actq", 201, &english));
+    CHECK_TRUE(QAssertMetaGetLocalizedDescription("de", "qf_actq", 201, &german));
+    POINTERS_EQUAL(english.brief, german.brief);
+}
+
+TEST(qassert_meta_locale_tests, pack_is_mapped_by_the_first_lookup_with_its_locale)
+{
+    CHECK_TRUE(QAssertMetaLocaleRegister("de", WritePack("de", GERMAN, 4).c_str()));
+    CHECK_TRUE(QAssertMetaLocaleRegister("ja", WritePack("ja", JAPANESE, 1).c_str()));
+    CHECK_FALSE(QAssertMetaLocaleIsLoaded("de"));
+
+    QAssertMetaDescription description;
+    CHECK_TRUE(QAssertMetaGetLocalizedDescription(nullptr, "qf_actq", 190, &description));
+    CHECK_TRUE(QAssertMetaGetLocalizedDescription("en", "qf_actq", 190, &description));
+    CHECK_FALSE(QAssertMetaLocaleIsLoaded("de"));
+
+    CHECK_TRUE(QAssertMetaGetLocalizedDescription("ja", "qf_actq", 190, &description));
+    STRCMP_EQUAL("イベントキューが満杯", description.brief);
+    CHECK_TRUE(QAssertMetaLocaleIsLoaded("ja"));
+    CHECK_FALSE(QAssertMetaLocaleIsLoaded("de"));
+}
+
+TEST(qassert_meta_locale_tests, regional_locale_uses_the_language_pack)
+{
+    CHECK_TRUE(QAssertMetaLocaleRegister("de", WritePack("de", GERMAN, 4).c_str()));
+
+    QAssertMetaDescription description;
+    CHECK_TRUE(QAssertMetaGetLocalizedDescription("de_AT", "qf_actq", 190, &description));
+    STRCMP_EQUAL("Ereigniswarteschlange voll", description.brief);
+    CHECK_TRUE(QAssertMetaGetLocalizedDescription("de-CH", "qf_actq", 190, &description));
+    STRCMP_EQUAL("Ereigniswarteschlange voll", description.brief);
+}
+
+TEST(qassert_meta_locale_tests, entries_of_other_tables_and_unknown_asserts_are_english)
+{
+    CHECK_TRUE(QAssertMetaRegisterTable(TEST_APP_TABLE));
+    CHECK_TRUE(QAssertMetaLocaleRegister("de", WritePack("de", GERMAN, 4).c_str()));
+
+    QAssertMetaDescription description;
+    CHECK_TRUE(QAssertMetaGetLocalizedDescription("de", "app_module", 1, &description));
+    STRCMP_EQUAL("app brief", description.brief);
+    CHECK_FALSE(QAssertMetaGetLocalizedDescription("de", "no_such_module", 1, &description));
+    CHECK_FALSE(QAssertMetaGetLocalizedDescription("de", "qf_actq", 190, nullptr));
+}
+
+TEST(qassert_meta_locale_tests, missing_or_invalid_packs_fall_back_to_english)
+{
+    std::string path = WritePack("xx", GERMAN, 4);
+    FILE * file = fopen(path.c_str(), "r+b");
+    fseek(file, static_cast<long>(offsetof(QAssertMetaLocaleHeader, keyFingerprint)), SEEK_SET);
+    fputc(0x5A, file);
+    fclose(file);
+    CHECK_TRUE(QAssertMetaLocaleRegister("xx", path.c_str()));
+    CHECK_TRUE(QAssertMetaLocaleRegister("yy", "/nonexistent/qassert-meta.qaml"));
+
+    QAssertMetaDescription english;
+    QAssertMetaDescription description;
+    CHECK_TRUE(QAssertMetaGetDescription("qf_actq", 190, &english));
+    CHECK_TRUE(QAssertMetaGetLocalizedDescription("xx", "qf_actq", 190, &description));
+    POINTERS_EQUAL(english.brief, description.brief);
+    CHECK_FALSE(QAssertMetaLocaleIsLoaded("xx"));
+    CHECK_TRUE(QAssertMetaGetLocalizedDescription("yy", "qf_actq", 190, &description));
+    POINTERS_EQUAL(english.brief, description.brief);
+}
+
+TEST(qassert_meta_locale_tests, registration_rejects_invalid_and_duplicate_locales)
+{
+    CHECK_FALSE(QAssertMetaLocaleRegister(nullptr, "path"));
+    CHECK_FALSE(QAssertMetaLocaleRegister("de", nullptr));
+    CHECK_FALSE(QAssertMetaLocaleRegister("", "path"));
+    CHECK_FALSE(QAssertMetaLocaleRegister("a_locale_name_too_long", "path"));
+    CHECK_TRUE(QAssertMetaLocaleRegister("de", "path"));
+    CHECK_FALSE(QAssertMetaLocaleRegister("de", "other path"));
+}
@@ -0,0 +1,81 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CppUTest/TestHarness.h"
+#include "qassert-meta.h"
+#include <cstring>
+
+TEST_GROUP(qassert_meta_location_tests) {
+    void setup() final
+    {
+        QAssertMetaInit();
+    }
+
+    void teardown() final
+    {
+    }
+};
+
+TEST(qassert_meta_location_tests, located_assert_provides_file_line_and_function)
+{
+    QAssertMetaLocation location;
+    CHECK_TRUE(QAssertMetaGetLocation("qf_actq", 202, &location));
+    STRCMP_EQUAL("src/qf/qf_actq.c", location.file);
+    CHECK_EQUAL(305u, location.line);
+    STRCMP_EQUAL("QActive_post_", location.function);
+}
+
+TEST(qassert_meta_location_tests, first_location_of_a_pair_wins)
+{
+    QAssertMetaLocation location;
+    CHECK_TRUE(QAssertMetaGetLocation("qf_actq", 102, &location));
+    STRCMP_EQUAL("src/qf/qf_actq.c", location.file);
+    CHECK_EQUAL(120u, location.line);
+}
+
+TEST(qassert_meta_location_tests, file_and_function_strings_are_pooled)
+{
+    QAssertMetaLocation first;
+    QAssertMetaLocation second;
+    CHECK_TRUE(QAssertMetaGetLocation("qf_actq", 102, &first));
+    CHECK_TRUE(QAssertMetaGetLocation("qf_actq", 202, &second));
+    POINTERS_EQUAL(first.file, second.file);
+    POINTERS_EQUAL(first.function, second.function);
+}
+
+TEST(qassert_meta_location_tests, missing_function_is_null)
+{
+    QAssertMetaLocation location;
+    CHECK_TRUE(QAssertMetaGetLocation("qf_actq", 190, &location));
+    CHECK_EQUAL(210u, location.line);
+    POINTERS_EQUAL(nullptr, location.function);
+}
+
+TEST(qassert_meta_location_tests, unlocated_or_unknown_asserts_have_no_location)
+{
+    QAssertMetaLocation location;
+    QAssertMetaDescription description;
+    CHECK_TRUE(QAssertMetaGetDescription("qf_actq", 201, &description));
+    CHECK_FALSE(QAssertMetaGetLocation("qf_actq", 201, &location));
+    CHECK_FALSE(QAssertMetaGetLocation("not_in_table", 1, &location));
+    CHECK_FALSE(QAssertMetaGetLocation("qf_actq", 1, &location));
+}
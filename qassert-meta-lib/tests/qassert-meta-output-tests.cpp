@@ -0,0 +1,229 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CppUTest/TestHarness.h"
+#include "qassert-meta-output.h"
+#include "qassert-meta.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> m_lines;
+uint32_t m_nowMs = 0;
+
+void CaptureLine(const char * line, void * context)
+{
+    (void)context;
+    m_lines.emplace_back(line);
+}
+
+uint32_t FakeClockMs()
+{
+    return m_nowMs;
+}
+
+QAssertMetaOutputPolicy Policy(QAssertMetaOutputMode mode)
+{
+    QAssertMetaOutputPolicy policy = {mode, 0, 0, FakeClockMs, CaptureLine, nullptr};
+    return policy;
+}
+
+} // namespace
+
+TEST_GROUP(qassert_meta_output_tests)
+{
+    void setup() final
+    {
+        QAssertMetaInit();
+        m_lines.clear();
+        m_nowMs = 0;
+    }
+
+    void teardown() final
+    {
+        QAssertMetaOutputSetPolicy(nullptr);
+    }
+};
+
+TEST(qassert_meta_output_tests, every_time_writes_the_full_description_each_time)
+{
+    QAssertMetaOutputPolicy policy = Policy(QASSERT_META_OUTPUT_EVERY_TIME);
+    QAssertMetaOutputSetPolicy(&policy);
+    QAssertMetaDescription expected;
+    CHECK_TRUE(QAssertMetaGetDescription("qf_actq", 190, &expected));
+
+    CHECK_TRUE(QAssertMetaOutputAssert("qf_actq", 190));
+    size_t linesPerAssert = m_lines.size();
+    CHECK_TRUE(linesPerAssert > 2u); //brief, multi line tips and url
+    const std::string brief = std::string("QAssert: qf_actq:190 ") + expected.brief;
+    const std::string url = std::string("    url: ") + expected.url;
+    STRCMP_EQUAL(brief.c_str(), m_lines[0].c_str());
+    STRCMP_EQUAL(url.c_str(), m_lines.back().c_str());
+
+    CHECK_TRUE(QAssertMetaOutputAssert("qf_actq", 190));
+    CHECK_EQUAL(2u * linesPerAssert, m_lines.size());
+}
+
+TEST(qassert_meta_output_tests, once_writes_each_assert_a_single_time)
+{
+    QAssertMetaOutputPolicy policy = Policy(QASSERT_META_OUTPUT_ONCE);
+    QAssertMetaOutputSetPolicy(&policy);
+    CHECK_TRUE(QAssertMetaOutputAssert("qf_actq", 190));
+    size_t lines = m_lines.size();
+    for (int i = 0; i < 1000; ++i)
+    {
+        CHECK_FALSE(QAssertMetaOutputAssert("qf_actq", 190));
+    }
+    CHECK_EQUAL(lines, m_lines.size());
+    CHECK_TRUE(QAssertMetaOutputAssert("gobble", 1));
+    STRCMP_EQUAL("QAssert: gobble:1 (no description)", m_lines.back().c_str());
+
+    QAssertMetaOutputCounters counters;
+    QAssertMetaOutputGetCounters(&counters);
+    CHECK_EQUAL(1002u, counters.asserts);
+    CHECK_EQUAL(1000u, counters.repeatsSuppressed);
+    CHECK_EQUAL(2u, counters.printedFull);
+    CHECK_EQUAL(2u, counters.distinct);
+}
+
+TEST(qassert_meta_output_tests, brief_after_first_writes_one_line_for_repeats)
+{
+    QAssertMetaOutputPolicy policy = Policy(QASSERT_META_OUTPUT_BRIEF_AFTER_FIRST);
+    QAssertMetaOutputSetPolicy(&policy);
+    QAssertMetaDescription expected;
+    CHECK_TRUE(QAssertMetaGetDescription("qf_actq", 190, &expected));
+
+    CHECK_TRUE(QAssertMetaOutputAssert("qf_actq", 190));
+    size_t lines = m_lines.size();
+    CHECK_TRUE(QAssertMetaOutputAssert("qf_actq", 190));
+    CHECK_EQUAL(lines + 1u, m_lines.size());
+    const std::string repeat = std::string("QAssert: qf_actq:190 (x2) ") + expected.brief;
+    STRCMP_EQUAL(repeat.c_str(), m_lines.back().c_str());
+}
+
+TEST(qassert_meta_output_tests, token_bucket_limits_the_rate_of_written_asserts)
+{
+    QAssertMetaOutputPolicy policy = Policy(QASSERT_META_OUTPUT_BRIEF_AFTER_FIRST);
+    policy.burst = 3;
+    policy.perSecond = 2;
+    QAssertMetaOutputSetPolicy(&policy);
+
+    unsigned written = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        written += QAssertMetaOutputAssert("gobble", i) ? 1u : 0u;
+    }
+    CHECK_EQUAL(3u, written);
+
+    m_nowMs = 1000; //two tokens
+    CHECK_TRUE(QAssertMetaOutputAssert("gobble", 0));
+    STRCMP_EQUAL("QAssert: 7 assert(s) not shown, rate limited", m_lines[3].c_str());
+    CHECK_TRUE(QAssertMetaOutputAssert("gobble", 0));
+    CHECK_FALSE(QAssertMetaOutputAssert("gobble", 0));
+
+    QAssertMetaOutputCounters counters;
+    QAssertMetaOutputGetCounters(&counters);
+    CHECK_EQUAL(8u, counters.rateLimited);
+}
+
+TEST(qassert_meta_output_tests, summary_lists_counts_most_frequent_first)
+{
+    QAssertMetaOutputPolicy policy = Policy(QASSERT_META_OUTPUT_ONCE);
+    QAssertMetaOutputSetPolicy(&policy);
+    for (int i = 0; i < 5; ++i)
+    {
+        (void)QAssertMetaOutputAssert("qf_actq", 190);
+    }
+    (void)QAssertMetaOutputAssert("gobble", 1);
+    (void)QAssertMetaOutputAssert("gobble", 2);
+    (void)QAssertMetaOutputAssert("gobble", 2);
+
+    m_lines.clear();
+    QAssertMetaOutputSummary();
+    CHECK_EQUAL(4u, m_lines.size());
+    STRCMP_EQUAL("QAssert summary: 8 assert(s), 3 distinct, 5 not shown (5 repeats, 0 rate limited)",
+                 m_lines[0].c_str());
+    CHECK_TRUE(m_lines[1].find("5 qf_actq:190 ") != std::string::npos);
+    STRCMP_EQUAL("         2 gobble:2 (no description)", m_lines[2].c_str());
+    STRCMP_EQUAL("         1 gobble:1 (no description)", m_lines[3].c_str());
+}
+
+TEST(qassert_meta_output_tests, seen_set_overflow_prints_as_if_first_seen)
+{
+    QAssertMetaOutputPolicy policy = Policy(QASSERT_META_OUTPUT_ONCE);
+    QAssertMetaOutputSetPolicy(&policy);
+    for (int i = 0; i < QASSERT_META_OUTPUT_MAX_KEYS; ++i)
+    {
+        CHECK_TRUE(QAssertMetaOutputAssert("gobble", i));
+    }
+    CHECK_TRUE(QAssertMetaOutputAssert("gobble", -1));
+    CHECK_TRUE(QAssertMetaOutputAssert("gobble", -1));
+
+    QAssertMetaOutputCounters counters;
+    QAssertMetaOutputGetCounters(&counters);
+    CHECK_EQUAL(2u, counters.untracked);
+    CHECK_EQUAL(static_cast<uint32_t>(QASSERT_META_OUTPUT_MAX_KEYS), counters.distinct);
+}
+
+TEST(qassert_meta_output_tests, long_module_names_are_kept_apart)
+{
+    QAssertMetaOutputPolicy policy = Policy(QASSERT_META_OUTPUT_ONCE);
+    QAssertMetaOutputSetPolicy(&policy);
+    std::string first(40, 'm');
+    std::string second = first + "2";
+    CHECK_TRUE(QAssertMetaOutputAssert(first.c_str(), 1));
+    CHECK_TRUE(QAssertMetaOutputAssert(second.c_str(), 1));
+    CHECK_FALSE(QAssertMetaOutputAssert(second.c_str(), 1));
+}
+
+TEST(qassert_meta_output_tests, summary_describes_long_module_names)
+{
+    static const char LONG_MODULE[] = "application_motor_controller_supervisor";
+    static const char OTHER_MODULE[] = "application_motor_controller_supervisor_2";
+    static const QAssertMetaItem table[] = {
+        {LONG_MODULE, 1, {"long module", nullptr, nullptr}},
+        {OTHER_MODULE, 1, {"other long module", nullptr, nullptr}},
+        {nullptr, -1, {nullptr, nullptr, nullptr}}
+    };
+    CHECK_TRUE(sizeof(LONG_MODULE) > QASSERT_META_OUTPUT_MODULE_SIZE);
+    CHECK_TRUE(QAssertMetaRegisterTable(table));
+
+    QAssertMetaOutputPolicy policy = Policy(QASSERT_META_OUTPUT_ONCE);
+    QAssertMetaOutputSetPolicy(&policy);
+    (void)QAssertMetaOutputAssert(OTHER_MODULE, 1);
+    (void)QAssertMetaOutputAssert(LONG_MODULE, 1);
+    (void)QAssertMetaOutputAssert(LONG_MODULE, 1);
+
+    m_lines.clear();
+    QAssertMetaOutputSummary();
+    CHECK_EQUAL(3u, m_lines.size());
+    STRCMP_EQUAL("         2 application_motor_controller_supervisor:1 long module", m_lines[1].c_str());
+    STRCMP_EQUAL("         1 application_motor_controller_supervisor_2:1 other long module", m_lines[2].c_str());
+}
+
+TEST(qassert_meta_output_tests, no_policy_writes_nothing)
+{
+    CHECK_FALSE(QAssertMetaOutputAssert("qf_actq", 190));
+    QAssertMetaOutputSummary();
+    CHECK_TRUE(m_lines.empty());
+}
@@ -0,0 +1,366 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CppUTest/TestHarness.h"
+#include "qassert-meta.h"
+#include "qassert-meta-overrides.h"
+#include "qassert-meta-enumerate.h"
+#include "qassert-meta-serialize.h"
+#include "qassert-meta-search.h"
+#include "qassert-meta-fuzzy.h"
+#include "qassert-meta.hpp"
+#if defined(QASSERT_META_TEST_HOST_SUPPORT)
+#include "qassert-meta-db.h"
+#include "qassert-meta-locale.h"
+#include <unistd.h>
+#include <cstdio>
+#include <random>
+#include <vector>
+#endif
+extern "C" {
+#include "qassert-meta-private.h"
+}
+#include <cstring>
+#include <string>
+
+// Linked with qassert-meta-test-overrides.c, replacing the weak
+// defaults of the library. Tables defined here test C++ linkage.
+
+QASSERT_META_MODULE_OVERRIDE(qf_actq) = {
+    {"qf_actq", 190, {"overridden queue full", "application tips", "https://example.com/190"}},
+    {"qf_actq", 12345, {"not in the internal table", nullptr, nullptr}},
+    {"qf_actq", 190, {"duplicate", nullptr, nullptr}},
+    {nullptr, -1, {nullptr, nullptr, nullptr}}
+};
+
+static const QAssertMetaItem m_application_items[] = {
+    {"app_motor", 1, {"motor stalled", nullptr, nullptr}},
+    {"app_motor", 2, {"motor overheated", nullptr, nullptr}},
+    {"app_motor", 1, {"duplicate", nullptr, nullptr}},
+    {"qf_actq", 12345, {"application item of a QP module", nullptr, nullptr}},
+    {"", 7, {"application item of an empty module", nullptr, nullptr}},
+    {nullptr, -1, {nullptr, nullptr, nullptr}}
+};
+
+QASSERT_META_APPLICATION_TABLE(m_application_items);
+
+TEST_GROUP(qassert_meta_override_tests) {
+    void setup() final
+    {
+        QAssertMetaInit();
+    }
+
+    void teardown() final
+    {
+        QAssertMetaInit();
+    }
+};
+
+TEST(qassert_meta_override_tests, module_override_replaces_internal_description)
+{
+    QAssertMetaDescription description;
+    CHECK_TRUE(QAssertMetaGetDescription("qf_actq", 190, &description));
+    STRCMP_EQUAL("overridden queue full", description.brief);
+    STRCMP_EQUAL("application tips", description.tips);
+    STRCMP_EQUAL("https://example.com/190", description.url);
+}
+
+TEST(qassert_meta_override_tests, module_override_defined_in_c_replaces_internal_description)
+{
+    QAssertMetaDescription description;
+    CHECK_TRUE(QAssertMetaGetDescription("qf_mem", 110, &description));
+    STRCMP_EQUAL("overridden from C", description.brief);
+}
+
+TEST(qassert_meta_override_tests, ids_not_overridden_keep_internal_descriptions)
+{
+    QAssertMetaDescription description;
+    const QAssertMetaItem * internal = m_qassert_meta_items;
+    while ((0 != strcmp(internal->module, "qf_actq")) || (internal->id != 102))
+    {
+        ++internal;
+    }
+
+    CHECK_TRUE(QAssertMetaGetDescription("qf_actq", 102, &description));
+    POINTERS_EQUAL(internal->description.brief, description.brief);
+    CHECK_TRUE(QAssertMetaGetDescription("qf_mem", 100, &description));
+    CHECK_TRUE(0 != strcmp("overridden from C", description.brief));
+}
+
+TEST(qassert_meta_override_tests, application_table_adds_modules_without_registration)
+{
+    QAssertMetaDescription description;
+    CHECK_TRUE(QAssertMetaGetDescription("app_motor", 2, &description));
+    STRCMP_EQUAL("motor overheated", description.brief);
+    CHECK_TRUE(QAssertMetaGetDescription("app_motor", 1, &description));
+    STRCMP_EQUAL("motor stalled", description.brief);
+    CHECK_FALSE(QAssertMetaGetDescription("app_motor", 3, &description));
+}
+
+TEST(qassert_meta_override_tests, overrides_only_apply_to_internal_ids_other_ids_come_from_the_application_table)
+{
+    QAssertMetaDescription description;
+    CHECK_TRUE(QAssertMetaGetDescription("qf_actq", 12345, &description));
+    STRCMP_EQUAL("application item of a QP module", description.brief);
+}
+
+TEST(qassert_meta_override_tests, application_table_is_searched_before_registered_tables)
+{
+    static const QAssertMetaItem registered[] = {
+        {"app_motor", 2, {"registered", nullptr, nullptr}},
+        {"app_pump", 7, {"registered pump", nullptr, nullptr}},
+        {nullptr, -1, {nullptr, nullptr, nullptr}}
+    };
+    CHECK_TRUE(QAssertMetaRegisterTable(registered));
+
+    QAssertMetaDescription description;
+    CHECK_TRUE(QAssertMetaGetDescription("app_motor", 2, &description));
+    STRCMP_EQUAL("motor overheated", description.brief);
+    CHECK_TRUE(QAssertMetaGetDescription("app_pump", 7, &description));
+    STRCMP_EQUAL("registered pump", description.brief);
+}
+
+TEST(qassert_meta_override_tests, reference_engine_agrees_with_the_lookup)
+{
+    const struct {
+        const char * module;
+        int id;
+    } keys[] = {{"qf_actq", 190}, {"qf_actq", 102}, {"qf_mem", 110}, {"qf_actq", 12345},
+                {"app_motor", 1}, {"app_motor", 3}, {"no_such_module", 1}};
+
+    for (const auto & key : keys)
+    {
+        QAssertMetaDescription expected = {nullptr, nullptr, nullptr};
+        QAssertMetaDescription actual = {nullptr, nullptr, nullptr};
+        CHECK_EQUAL(QAssertMetaPrivateReferenceGetDescription(key.module, key.id, &expected),
+                    QAssertMetaGetDescription(key.module, key.id, &actual));
+        POINTERS_EQUAL(expected.brief, actual.brief);
+    }
+}
+
+TEST(qassert_meta_override_tests, serialized_entries_are_those_looked_up)
+{
+    std::string output;
+    uint8_t buffer[256];
+    QAssertMetaSerializer serializer;
+    QAssertMetaSerializerInit(&serializer, QASSERT_META_SERIALIZE_JSON, buffer, sizeof(buffer),
+                              [](const uint8_t * data, size_t size, void * context) {
+                                  static_cast<std::string *>(context)->append(reinterpret_cast<const char *>(data), size);
+                                  return true;
+                              }, &output);
+    CHECK_TRUE(QAssertMetaSerializeAll(&serializer));
+    CHECK_TRUE(QAssertMetaSerializeFinish(&serializer));
+
+    CHECK_TRUE(std::string::npos != output.find("{\"module\":\"qf_actq\",\"id\":190,\"brief\":\"overridden queue full\","
+                                                "\"tips\":\"application tips\",\"url\":\"https://example.com/190\"}\n"));
+    CHECK_TRUE(std::string::npos != output.find("{\"module\":\"qf_mem\",\"id\":110,\"brief\":\"overridden from C\"}\n"));
+    CHECK_TRUE(std::string::npos != output.find("{\"module\":\"app_motor\",\"id\":2,\"brief\":\"motor overheated\"}\n"));
+}
+
+TEST(qassert_meta_override_tests, enumerated_entries_are_those_looked_up)
+{
+    QAssertMetaIterator iterator;
+    QAssertMetaEntry entry;
+    QAssertMetaIteratorInit(&iterator, "qf_actq", 190, 190);
+    CHECK_TRUE(QAssertMetaIteratorNext(&iterator, &entry));
+    STRCMP_EQUAL("overridden queue full", entry.item->description.brief);
+    CHECK_EQUAL(QASSERT_META_SOURCE_BUILTIN, entry.source);
+    CHECK_FALSE(QAssertMetaIteratorNext(&iterator, &entry));
+
+    QAssertMetaIteratorInit(&iterator, "app_motor", INT_MIN, INT_MAX);
+    for (size_t i = 0; i < 3u; ++i)
+    {
+        CHECK_TRUE(QAssertMetaIteratorNext(&iterator, &entry));
+        POINTERS_EQUAL(&m_application_items[i], entry.item);
+        CHECK_EQUAL(QASSERT_META_SOURCE_APPLICATION, entry.source);
+    }
+    CHECK_FALSE(QAssertMetaIteratorNext(&iterator, &entry));
+}
+
+TEST(qassert_meta_override_tests, search_finds_override_and_application_text)
+{
+    QAssertMetaSearchResult results[4];
+    CHECK_TRUE(QAssertMetaSearch("overridden queue", results, 4) > 0u);
+    STRCMP_EQUAL("overridden queue full", results[0].item->description.brief);
+    CHECK_EQUAL(2u, results[0].matchedTerms);
+
+    CHECK_EQUAL(1u, QAssertMetaSearch("overheated", results, 4));
+    POINTERS_EQUAL(&m_application_items[1], results[0].item);
+
+    //the overridden built-in text is no longer found
+    size_t count = QAssertMetaSearch("QF_NO_MARGIN", results, 4);
+    for (size_t i = 0; i < count; ++i)
+    {
+        CHECK_FALSE((0 == strcmp("qf_actq", results[i].item->module)) && (190 == results[i].item->id));
+    }
+}
+
+TEST(qassert_meta_override_tests, fuzzy_matches_are_those_looked_up)
+{
+    QAssertMetaFuzzyMatch matches[4];
+    CHECK_TRUE(QAssertMetaFuzzyLookup("qf_act", 190, matches, 4) > 0u);
+    STRCMP_EQUAL("overridden queue full", matches[0].item->description.brief);
+
+    CHECK_TRUE(QAssertMetaFuzzyLookup("app_moto", 2, matches, 4) > 0u);
+    POINTERS_EQUAL(&m_application_items[1], matches[0].item);
+}
+
+TEST(qassert_meta_override_tests, fuzzy_treats_empty_modules_as_no_match)
+{
+    QAssertMetaFuzzyMatch matches[4];
+    CHECK_EQUAL(0u, QAssertMetaFuzzyLookup("", 2, matches, 4));
+    CHECK_EQUAL(0u, QAssertMetaFuzzyLookup("", 7, matches, 4));
+
+    //the empty application module is scored, but shares nothing with the query
+    size_t count = QAssertMetaFuzzyLookup("app_motor", 7, matches, 4);
+    for (size_t i = 0; i < count; ++i)
+    {
+        STRCMP_EQUAL("app_motor", matches[i].item->module);
+    }
+}
+
+TEST(qassert_meta_override_tests, cpp_describe_linked_applies_overrides)
+{
+    static_assert(qassert_meta::contains("qf_actq", 190), "internal item");
+    CHECK_TRUE(0 != strcmp("overridden queue full", qassert_meta::describe("qf_actq", 190).brief));
+    STRCMP_EQUAL("overridden queue full", qassert_meta::describe_linked("qf_actq", 190).brief);
+    STRCMP_EQUAL("overridden from C", qassert_meta::describe_linked("qf_mem", 110).brief);
+    CHECK_TRUE(nullptr == qassert_meta::describe_linked("app_motor", 1).brief);
+}
+
+#if defined(QASSERT_META_TEST_HOST_SUPPORT)
+TEST(qassert_meta_override_tests, database_entries_are_those_looked_up)
+{
+    FILE * file = tmpfile();
+    CHECK_TRUE(file != nullptr);
+    CHECK_TRUE(QAssertMetaDbWrite(file));
+    std::vector<char> image(static_cast<size_t>(ftell(file)));
+    rewind(file);
+    CHECK_EQUAL(1u, fread(image.data(), image.size(), 1, file));
+    fclose(file);
+
+    QAssertMetaDb db;
+    CHECK_TRUE(QAssertMetaDbAttach(&db, image.data(), image.size()));
+    QAssertMetaDescription description;
+    CHECK_TRUE(QAssertMetaDbLookup(&db, "qf_actq", 190, &description));
+    STRCMP_EQUAL("overridden queue full", description.brief);
+    STRCMP_EQUAL("application tips", description.tips);
+    CHECK_TRUE(QAssertMetaDbLookup(&db, "qf_mem", 110, &description));
+    STRCMP_EQUAL("overridden from C", description.brief);
+    CHECK_TRUE(QAssertMetaDbLookup(&db, "app_motor", 1, &description));
+    STRCMP_EQUAL("motor stalled", description.brief);
+    CHECK_TRUE(QAssertMetaDbLookup(&db, "qf_actq", 12345, &description));
+    STRCMP_EQUAL("application item of a QP module", description.brief);
+}
+
+static bool SameText(const char * lhs, const char * rhs)
+{
+    return (lhs == rhs) || ((lhs != nullptr) && (rhs != nullptr) && (0 == strcmp(lhs, rhs)));
+}
+
+TEST(qassert_meta_override_tests, database_agrees_with_the_reference_engine_for_random_queries)
+{
+    static const QAssertMetaItem registered[] = {
+        {"qf_actq", 190, {"registered, behind the override", nullptr, nullptr}},
+        {"app_motor", 2, {"registered, behind the application table", nullptr, nullptr}},
+        {"app_pump", 7, {"registered only", nullptr, nullptr}},
+        {nullptr, 0, {nullptr, nullptr, nullptr}}
+    };
+    CHECK_TRUE(QAssertMetaRegisterTable(registered));
+
+    const QAssertMetaItem * const tables[] = {m_qassert_meta_items, m_application_items, registered};
+    std::vector<const QAssertMetaItem *> keys;
+    for (const QAssertMetaItem * table : tables)
+    {
+        for (const QAssertMetaItem * item = table; item->module != nullptr; ++item)
+        {
+            keys.push_back(item);
+        }
+    }
+
+    FILE * file = tmpfile();
+    CHECK_TRUE(file != nullptr);
+    CHECK_TRUE(QAssertMetaDbWrite(file));
+    std::vector<char> image(static_cast<size_t>(ftell(file)));
+    rewind(file);
+    CHECK_EQUAL(1u, fread(image.data(), image.size(), 1, file));
+    fclose(file);
+    QAssertMetaDb db;
+    CHECK_TRUE(QAssertMetaDbAttach(&db, image.data(), image.size()));
+
+    std::mt19937_64 random(1);
+    for (int i = 0; i < 20000; ++i)
+    {
+        const QAssertMetaItem & key = *keys[random() % keys.size()];
+        std::string module = key.module;
+        int id = key.id;
+        switch (random() % 4)
+        {
+            case 0: //exact
+                break;
+            case 1:
+                id += ((random() % 2) == 0) ? 1 : -1;
+                break;
+            case 2:
+                module.resize(random() % (module.size() + 1));
+                break;
+            default:
+                module += static_cast<char>('a' + (random() % 26));
+                break;
+        }
+
+        QAssertMetaDescription expected = {nullptr, nullptr, nullptr};
+        QAssertMetaDescription actual = {nullptr, nullptr, nullptr};
+        bool expectedFound = QAssertMetaPrivateReferenceGetDescription(module.c_str(), id, &expected);
+        bool actualFound = QAssertMetaDbLookup(&db, module.c_str(), id, &actual);
+        std::string query = module + " " + std::to_string(id);
+        CHECK_EQUAL_TEXT(expectedFound, actualFound, query.c_str());
+        CHECK_TEXT(SameText(expected.brief, actual.brief) && SameText(expected.tips, actual.tips) &&
+                   SameText(expected.url, actual.url), query.c_str());
+    }
+}
+
+TEST(qassert_meta_override_tests, localization_keeps_override_text)
+{
+    const QAssertMetaTranslation german[] = {
+        {"qf_actq", 190, "Ereigniswarteschlange voll", "Warteschlange vergrößern"},
+        {"qf_actq", 102, "nur kurz", nullptr}
+    };
+    char path[] = "/tmp/qassert-meta-override-locale-XXXXXX";
+    int fd = mkstemp(path);
+    CHECK_TRUE(fd >= 0);
+    FILE * file = fdopen(fd, "wb");
+    CHECK_TRUE(QAssertMetaLocaleWritePack(file, "de", german, 2, nullptr));
+    CHECK_EQUAL(0, fclose(file));
+    CHECK_TRUE(QAssertMetaLocaleRegister("de", path));
+
+    QAssertMetaDescription description;
+    CHECK_TRUE(QAssertMetaGetLocalizedDescription("de", "qf_actq", 190, &description));
+    STRCMP_EQUAL("overridden queue full", description.brief);
+    STRCMP_EQUAL("application tips", description.tips);
+    CHECK_TRUE(QAssertMetaGetLocalizedDescription("de", "qf_actq", 102, &description));
+    STRCMP_EQUAL("nur kurz", description.brief);
+
+    QAssertMetaLocaleReset();
+    unlink(path);
+}
+#endif
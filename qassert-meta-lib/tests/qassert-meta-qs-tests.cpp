@@ -0,0 +1,243 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CppUTest/TestHarness.h"
+#include "qassert-meta-qs.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace qassert_meta;
+
+namespace {
+
+struct RecordingListener : public QsListener {
+    std::vector<QsFrame> frames;
+    std::vector<std::vector<uint8_t>> payloads;
+    std::vector<QsAssertRecord> asserts;
+    std::vector<std::string> modules;
+
+    void OnFrame(const QsFrame & frame) override
+    {
+        frames.push_back(frame);
+        payloads.emplace_back(frame.payload, frame.payload + frame.size);
+    }
+
+    void OnAssert(const QsAssertRecord & record) override
+    {
+        asserts.push_back(record);
+        modules.emplace_back(record.module, record.moduleLength);
+    }
+};
+
+void AddFrame(std::vector<uint8_t> & stream, uint8_t sequence, QsRecordType record,
+              const std::vector<uint8_t> & payload)
+{
+    QsEncodeFrame(stream, sequence, static_cast<uint8_t>(record), payload.data(), payload.size());
+}
+
+void AddAssert(std::vector<uint8_t> & stream, uint8_t sequence, uint64_t time, unsigned id, const char * module,
+               const QsFormat & format = QsFormat())
+{
+    std::vector<uint8_t> payload;
+    QsEncodeAssertPayload(payload, format, time, id, module);
+    AddFrame(stream, sequence, QsRecordType::AssertFail, payload);
+}
+
+std::vector<uint8_t> Named(std::vector<uint8_t> fixed, const char * name)
+{
+    fixed.insert(fixed.end(), name, name + strlen(name) + 1);
+    return fixed;
+}
+
+} // namespace
+
+TEST_GROUP(qassert_meta_qs_tests)
+{
+    RecordingListener listener;
+
+    void setup() final
+    {
+        QAssertMetaInit();
+    }
+
+    void teardown() final
+    {
+    }
+};
+
+TEST(qassert_meta_qs_tests, escaped_bytes_round_trip_through_a_frame)
+{
+    const std::vector<uint8_t> payload = {0x7E, 0x7D, 0x00, 0x5E, 0x5D, 0xFF};
+    std::vector<uint8_t> stream;
+    QsEncodeFrame(stream, 0x7E, 0x7D, payload.data(), payload.size());
+    CHECK_EQUAL(1u, std::count(stream.begin(), stream.end(), QS_FRAME_FLAG));
+
+    QsDecoder decoder(listener);
+    decoder.Feed(stream.data(), stream.size());
+    CHECK_EQUAL(1u, listener.frames.size());
+    CHECK_EQUAL(0x7Eu, listener.frames[0].sequence);
+    CHECK_EQUAL(0x7Du, listener.frames[0].record);
+    CHECK_TRUE(payload == listener.payloads[0]);
+    CHECK_EQUAL(0u, decoder.Stats().checksumErrors);
+}
+
+TEST(qassert_meta_qs_tests, assert_record_is_annotated_with_its_description)
+{
+    std::vector<uint8_t> stream;
+    AddAssert(stream, 1, 123456, 190, "qf_actq");
+    AddAssert(stream, 2, 123457, 9999, "qf_actq");
+
+    QsDecoder decoder(listener);
+    decoder.Feed(stream.data(), stream.size());
+
+    QAssertMetaDescription expected;
+    CHECK_TRUE(QAssertMetaGetDescription("qf_actq", 190, &expected));
+    CHECK_EQUAL(2u, listener.asserts.size());
+    CHECK_EQUAL(123456u, listener.asserts[0].time);
+    CHECK_EQUAL(190u, listener.asserts[0].id);
+    STRCMP_EQUAL("qf_actq", listener.modules[0].c_str());
+    CHECK_TRUE(listener.asserts[0].described);
+    STRCMP_EQUAL(expected.brief, listener.asserts[0].description.brief);
+
+    CHECK_FALSE(listener.asserts[1].described);
+    POINTERS_EQUAL(nullptr, listener.asserts[1].description.brief);
+    CHECK_EQUAL(2u, decoder.Stats().asserts);
+    CHECK_EQUAL(1u, decoder.Stats().describedAsserts);
+}
+
+TEST(qassert_meta_qs_tests, corrupt_frame_is_dropped_and_decoding_resynchronizes)
+{
+    std::vector<uint8_t> stream = {0x12, 0x34}; //tail of a frame before the capture started
+    stream.push_back(QS_FRAME_FLAG);
+    AddAssert(stream, 1, 1, 190, "qf_actq");
+    stream[stream.size() - 4] ^= 0x01u; //damage the module string
+    AddAssert(stream, 2, 2, 190, "qf_actq");
+
+    QsDecoder decoder(listener);
+    decoder.Feed(stream.data(), stream.size());
+    CHECK_EQUAL(1u, listener.asserts.size());
+    CHECK_EQUAL(2u, listener.asserts[0].time);
+    CHECK_EQUAL(1u, decoder.Stats().checksumErrors);
+    CHECK_EQUAL(1u, decoder.Stats().malformedRecords); //the two byte tail
+}
+
+TEST(qassert_meta_qs_tests, frames_may_be_fed_a_byte_at_a_time)
+{
+    std::vector<uint8_t> stream;
+    for (unsigned i = 0; i < 20; ++i)
+    {
+        AddAssert(stream, static_cast<uint8_t>(i), i, 190, "qf_actq");
+    }
+
+    QsDecoder decoder(listener);
+    for (uint8_t byte : stream)
+    {
+        decoder.Feed(&byte, 1);
+    }
+    CHECK_EQUAL(20u, listener.asserts.size());
+    CHECK_EQUAL(19u, listener.asserts[19].time);
+    CHECK_EQUAL(stream.size(), decoder.Stats().bytes);
+    CHECK_EQUAL(0u, decoder.Stats().lostRecords);
+}
+
+TEST(qassert_meta_qs_tests, sequence_gaps_count_lost_records)
+{
+    std::vector<uint8_t> stream;
+    AddAssert(stream, 254, 1, 190, "qf_actq");
+    AddAssert(stream, 1, 2, 190, "qf_actq"); //255 and 0 lost, wrapping
+
+    QsDecoder decoder(listener);
+    decoder.Feed(stream.data(), stream.size());
+    CHECK_EQUAL(2u, decoder.Stats().lostRecords);
+}
+
+TEST(qassert_meta_qs_tests, target_info_sets_the_format)
+{
+    std::vector<uint8_t> stream;
+    //reset, version, signal size 1, counters, pointers 2, time 2
+    AddFrame(stream, 1, QsRecordType::TargetInfo, {0xFF, 0x2C, 0x01, 0x21, 0x22, 0x22, 0x22, 0x02, 0x00});
+    QsFormat format;
+    format.timeSize = 2;
+    AddAssert(stream, 2, 0xBEEF, 190, "qf_actq", format);
+
+    QsDecoder decoder(listener);
+    decoder.Feed(stream.data(), stream.size());
+    CHECK_EQUAL(2u, decoder.Format().timeSize);
+    CHECK_EQUAL(2u, decoder.Format().objectPointerSize);
+    CHECK_EQUAL(2u, decoder.Format().functionPointerSize);
+    CHECK_EQUAL(1u, decoder.Format().signalSize);
+    CHECK_EQUAL(1u, listener.asserts.size());
+    CHECK_EQUAL(0xBEEFu, listener.asserts[0].time);
+    CHECK_TRUE(listener.asserts[0].described);
+}
+
+TEST(qassert_meta_qs_tests, dictionaries_name_objects_functions_signals_and_records)
+{
+    std::vector<uint8_t> stream;
+    AddFrame(stream, 1, QsRecordType::ObjDict, Named({0x00, 0x10, 0x00, 0x20}, "AO_Blinky"));
+    AddFrame(stream, 2, QsRecordType::FunDict, Named({0x44, 0x33, 0x22, 0x11}, "Blinky_on"));
+    AddFrame(stream, 3, QsRecordType::SigDict, Named({0x05, 0x00, 0x00, 0x00, 0x00, 0x00}, "TIMEOUT_SIG"));
+    AddFrame(stream, 4, QsRecordType::UsrDict, Named({100}, "MY_RECORD"));
+
+    QsDecoder decoder(listener);
+    decoder.Feed(stream.data(), stream.size());
+    STRCMP_EQUAL("AO_Blinky", decoder.ObjectName(0x20001000u));
+    STRCMP_EQUAL("Blinky_on", decoder.FunctionName(0x11223344u));
+    STRCMP_EQUAL("TIMEOUT_SIG", decoder.SignalName(5, 0x20001000u)); //global signal
+    STRCMP_EQUAL("MY_RECORD", decoder.UserRecordName(100));
+    POINTERS_EQUAL(nullptr, decoder.ObjectName(0x20001004u));
+    CHECK_EQUAL(4u, decoder.Stats().dictionaryEntries);
+
+    //a target reset forgets the dictionaries
+    std::vector<uint8_t> reset;
+    AddFrame(reset, 0, QsRecordType::TargetInfo, {0xFF, 0x2C, 0x01, 0x22, 0x22, 0x22, 0x44, 0x04, 0x00});
+    decoder.Feed(reset.data(), reset.size());
+    POINTERS_EQUAL(nullptr, decoder.ObjectName(0x20001000u));
+}
+
+TEST(qassert_meta_qs_tests, memory_limits_drop_frames_and_names)
+{
+    QsLimits limits;
+    limits.maxFrameSize = 32;
+    limits.maxDictionaryEntries = 2;
+    limits.maxDictionaryBytes = 1024;
+
+    std::vector<uint8_t> stream;
+    for (uint8_t i = 0; i < 4; ++i)
+    {
+        AddFrame(stream, i, QsRecordType::ObjDict, Named({i, 0, 0, 0}, "object"));
+    }
+    AddAssert(stream, 4, 1, 190, std::string(40, 'x').c_str());
+    AddAssert(stream, 5, 2, 190, "qf_actq");
+
+    QsDecoder decoder(listener, limits);
+    decoder.Feed(stream.data(), stream.size());
+    CHECK_EQUAL(2u, decoder.Stats().dictionaryEntries);
+    CHECK_EQUAL(2u, decoder.Stats().dictionaryDrops);
+    STRCMP_EQUAL("object", decoder.ObjectName(1));
+    POINTERS_EQUAL(nullptr, decoder.ObjectName(2));
+    CHECK_EQUAL(1u, decoder.Stats().oversizedFrames);
+    CHECK_EQUAL(1u, listener.asserts.size());
+    CHECK_EQUAL(2u, listener.asserts[0].time);
+}
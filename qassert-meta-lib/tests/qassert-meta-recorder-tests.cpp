@@ -0,0 +1,183 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CppUTest/TestHarness.h"
+#include "qassert-meta-recorder.h"
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr size_t CAPACITY = 4;
+
+//compiles, placed in .noinit
+QASSERT_META_RECORDER_STORAGE(m_noinit_records, CAPACITY);
+
+const QAssertMetaItem APPLICATION_ITEMS[] = {
+    {"app_sensor", 3, {"Sensor timed out", nullptr, nullptr}},
+    {nullptr, -1, {nullptr, nullptr, nullptr}}
+};
+
+} // namespace
+
+TEST_GROUP(qassert_meta_recorder_tests)
+{
+    //the RAM image retained across simulated resets
+    uint32_t image[QASSERT_META_RECORDER_SIZE(CAPACITY) / sizeof(uint32_t)];
+
+    void setup() final
+    {
+        QAssertMetaInit();
+        memset(image, 0xA5, sizeof(image)); //power up noise
+    }
+
+    void teardown() final
+    {
+        (void)QAssertMetaRecorderInit(nullptr, 0);
+    }
+
+    //the records, after a reset
+    std::vector<QAssertMetaRecord> Reboot(size_t expectedKept)
+    {
+        CHECK_EQUAL(expectedKept, QAssertMetaRecorderInit(image, sizeof(image)));
+        std::vector<QAssertMetaRecord> records(CAPACITY);
+        records.resize(QAssertMetaRecorderRead(records.data(), records.size()));
+        return records;
+    }
+};
+
+TEST(qassert_meta_recorder_tests, power_up_noise_is_cleared)
+{
+    CHECK_TRUE(Reboot(0).empty());
+    CHECK_TRUE(Reboot(0).empty());
+    CHECK_EQUAL(0u, QAssertMetaRecorderInit(m_noinit_records, sizeof(m_noinit_records)));
+}
+
+TEST(qassert_meta_recorder_tests, records_survive_a_reset_and_are_described)
+{
+    (void)QAssertMetaRecorderInit(image, sizeof(image));
+    QAssertMetaRecordAssert("qf_actq", 190, 1000, 0x08001234u, 0x08005679u);
+
+    std::vector<QAssertMetaRecord> records = Reboot(1);
+    CHECK_EQUAL(1u, records.size());
+    CHECK_EQUAL(190, records[0].id);
+    CHECK_EQUAL(1000u, records[0].timestamp);
+    CHECK_EQUAL(0x08001234u, records[0].pc);
+    CHECK_EQUAL(0x08005679u, records[0].lr);
+
+    const char * module = nullptr;
+    QAssertMetaDescription description;
+    QAssertMetaDescription expected;
+    CHECK_TRUE(QAssertMetaRecorderDescribe(&records[0], &module, &description));
+    STRCMP_EQUAL("qf_actq", module);
+    CHECK_TRUE(QAssertMetaGetDescription("qf_actq", 190, &expected));
+    STRCMP_EQUAL(expected.brief, description.brief);
+
+    QAssertMetaRecorderClear();
+    CHECK_TRUE(Reboot(0).empty());
+}
+
+TEST(qassert_meta_recorder_tests, ring_keeps_the_latest_records_oldest_first)
+{
+    (void)QAssertMetaRecorderInit(image, sizeof(image));
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        QAssertMetaRecordAssert("qf_actq", 190, i, 0, 0);
+    }
+
+    std::vector<QAssertMetaRecord> records = Reboot(CAPACITY);
+    CHECK_EQUAL(CAPACITY, records.size());
+    for (size_t i = 0; i < CAPACITY; ++i)
+    {
+        CHECK_EQUAL(6u + i, records[i].timestamp);
+        CHECK_EQUAL(6u + i, records[i].sequence);
+    }
+
+    //recording continues after the reset
+    QAssertMetaRecordAssert("qf_mem", 110, 10, 0, 0);
+    records = Reboot(CAPACITY);
+    CHECK_EQUAL(7u, records[0].timestamp);
+    CHECK_EQUAL(10u, records[CAPACITY - 1].timestamp);
+}
+
+TEST(qassert_meta_recorder_tests, records_torn_by_a_reset_are_skipped)
+{
+    (void)QAssertMetaRecorderInit(image, sizeof(image));
+    QAssertMetaRecordAssert("qf_actq", 190, 1, 0, 0);
+    QAssertMetaRecordAssert("qf_actq", 190, 2, 0, 0);
+    QAssertMetaRecordAssert("qf_actq", 190, 3, 0, 0);
+
+    //reset while writing the second record
+    QAssertMetaRecorderHeader * header = reinterpret_cast<QAssertMetaRecorderHeader *>(image);
+    QAssertMetaRecord * slots = reinterpret_cast<QAssertMetaRecord *>(header + 1);
+    slots[1].timestamp = 0xDEAD;
+
+    std::vector<QAssertMetaRecord> records = Reboot(2);
+    CHECK_EQUAL(2u, records.size());
+    CHECK_EQUAL(1u, records[0].timestamp);
+    CHECK_EQUAL(3u, records[1].timestamp);
+}
+
+TEST(qassert_meta_recorder_tests, record_written_but_not_counted_is_recovered)
+{
+    (void)QAssertMetaRecorderInit(image, sizeof(image));
+    QAssertMetaRecordAssert("qf_actq", 190, 1, 0, 0);
+    QAssertMetaRecorderHeader * header = reinterpret_cast<QAssertMetaRecorderHeader *>(image);
+    --header->next; //reset just before the count was stored
+
+    std::vector<QAssertMetaRecord> records = Reboot(1);
+    CHECK_EQUAL(1u, records.size());
+    CHECK_EQUAL(1u, records[0].timestamp);
+}
+
+TEST(qassert_meta_recorder_tests, buffer_of_another_size_is_cleared)
+{
+    (void)QAssertMetaRecorderInit(image, sizeof(image));
+    QAssertMetaRecordAssert("qf_actq", 190, 1, 0, 0);
+    CHECK_EQUAL(0u, QAssertMetaRecorderInit(image, QASSERT_META_RECORDER_SIZE(CAPACITY - 1)));
+    CHECK_EQUAL(0u, QAssertMetaRecorderInit(image, QASSERT_META_RECORDER_SIZE(0)));
+}
+
+TEST(qassert_meta_recorder_tests, registered_modules_resolve_and_unknown_modules_do_not)
+{
+    CHECK_TRUE(QAssertMetaRegisterTable(APPLICATION_ITEMS));
+    (void)QAssertMetaRecorderInit(image, sizeof(image));
+    QAssertMetaRecordAssert("app_sensor", 3, 1, 0, 0);
+    QAssertMetaRecordAssert("app_sensor", 4, 2, 0, 0);
+
+    std::vector<QAssertMetaRecord> records = Reboot(2);
+    const char * module = nullptr;
+    QAssertMetaDescription description;
+    CHECK_TRUE(QAssertMetaRecorderDescribe(&records[0], &module, &description));
+    STRCMP_EQUAL("app_sensor", module);
+    STRCMP_EQUAL("Sensor timed out", description.brief);
+    CHECK_FALSE(QAssertMetaRecorderDescribe(&records[1], &module, &description));
+    POINTERS_EQUAL(nullptr, module);
+}
+
+TEST(qassert_meta_recorder_tests, recording_without_storage_does_nothing)
+{
+    QAssertMetaRecordAssert("qf_actq", 190, 1, 0, 0);
+    QAssertMetaRecord record;
+    CHECK_EQUAL(0u, QAssertMetaRecorderRead(&record, 1));
+    QAssertMetaRecorderClear();
+}
@@ -0,0 +1,182 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CppUTest/TestHarness.h"
+#include "qassert-meta.h"
+#include "qassert-meta-synthetic.h"
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace qassert_meta;
+
+namespace {
+
+constexpr size_t SMALL_TABLE = 1000;
+constexpr size_t LARGE_TABLE = 200000;
+constexpr size_t LOOKUP_THREADS = 8;
+
+constexpr uint32_t GUARD = 0xA5A5A5A5u;
+constexpr size_t GUARD_WORDS = 16;
+
+SyntheticTableConfig ScalingConfig(size_t itemCount)
+{
+    SyntheticTableConfig config;
+    config.itemCount = itemCount;
+    config.moduleCount = itemCount / 20;
+    config.sharedPrefixModules = config.moduleCount / 2;
+    config.ids = SyntheticIdDistribution::Random;
+    config.briefLength = 48;
+    config.tipsLength = 96;
+    return config;
+}
+
+/**
+ * Registers a synthetic table with an index, the index storage
+ * followed by guard words to detect writes beyond the reported size.
+ */
+struct IndexedTable {
+    explicit IndexedTable(size_t itemCount) :
+        table(ScalingConfig(itemCount)),
+        storageBytes(QAssertMetaIndexStorageSize(table.Items())),
+        storage((storageBytes / sizeof(uint32_t)) + GUARD_WORDS, GUARD)
+    {
+        CHECK_TRUE(QAssertMetaRegisterIndexedTable(table.Items(), storage.data(), storageBytes));
+    }
+
+    bool GuardIntact() const
+    {
+        for (size_t i = storageBytes / sizeof(uint32_t); i < storage.size(); ++i)
+        {
+            if (storage[i] != GUARD)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    SyntheticTable table;
+    size_t storageBytes;
+    std::vector<uint32_t> storage;
+};
+
+} // namespace
+
+TEST_GROUP(qassert_meta_scaling_tests) {
+    void setup() final
+    {
+        QAssertMetaInit();
+    }
+
+    void teardown() final
+    {
+        QAssertMetaInit();
+    }
+};
+
+TEST(qassert_meta_scaling_tests, synthetic_table_has_requested_shape_and_unique_keys)
+{
+    SyntheticTableConfig config = ScalingConfig(SMALL_TABLE);
+    SyntheticTable table(config);
+
+    CHECK_EQUAL(SMALL_TABLE, table.Size());
+    CHECK_EQUAL(nullptr, table.Items()[SMALL_TABLE].module);
+    size_t sharedPrefix = 0;
+    for (size_t i = 0; i < table.Size(); ++i)
+    {
+        CHECK_EQUAL(config.briefLength, strlen(table[i].description.brief));
+        sharedPrefix += (0 == strncmp(table[i].module, config.sharedPrefix.c_str(), config.sharedPrefix.size())) ? 1 : 0;
+        for (size_t j = i + 1; (j < table.Size()) && (table[j].module == table[i].module); ++j)
+        {
+            CHECK_TRUE(table[i].id != table[j].id);
+        }
+    }
+    CHECK_EQUAL(SMALL_TABLE / 2, sharedPrefix);
+}
+
+TEST(qassert_meta_scaling_tests, every_entry_of_a_large_indexed_table_resolves_to_itself)
+{
+    IndexedTable large(LARGE_TABLE);
+    QAssertMetaDescription description;
+
+    for (size_t i = 0; i < large.table.Size(); ++i)
+    {
+        CHECK_TRUE(QAssertMetaGetDescription(large.table[i].module, large.table[i].id, &description));
+        POINTERS_EQUAL(large.table[i].description.brief, description.brief);
+    }
+    CHECK_FALSE(QAssertMetaGetDescription(large.table[0].module, -1, &description));
+}
+
+//the footprint reports the storage given at registration, the guard words check builds stay within it
+TEST(qassert_meta_scaling_tests, footprint_counts_registered_index_storage_and_builds_stay_within_it)
+{
+    std::unique_ptr<IndexedTable> small(new IndexedTable(SMALL_TABLE));
+    std::unique_ptr<IndexedTable> large(new IndexedTable(LARGE_TABLE));
+
+    QAssertMetaFootprint footprint;
+    QAssertMetaGetFootprint(&footprint);
+    CHECK_EQUAL(2u, footprint.registeredTables);
+    CHECK_EQUAL(SMALL_TABLE + LARGE_TABLE, footprint.registeredItems);
+    CHECK_EQUAL(small->storageBytes + large->storageBytes, footprint.indexBytes);
+
+    QAssertMetaDescription description;
+    CHECK_FALSE(QAssertMetaGetDescription("no_such_module", 1, &description)); //builds both indexes
+    CHECK_TRUE(small->GuardIntact());
+    CHECK_TRUE(large->GuardIntact());
+
+    //index memory grows linearly, at most 4 slots (32 bytes) per item
+    CHECK_TRUE(large->storageBytes <= (LARGE_TABLE * 32u));
+}
+
+TEST(qassert_meta_scaling_tests, concurrent_first_lookups_all_resolve_and_stay_within_index_storage)
+{
+    IndexedTable large(LARGE_TABLE);
+    std::vector<size_t> failures(LOOKUP_THREADS, 0);
+    std::vector<std::thread> threads;
+
+    for (size_t t = 0; t < LOOKUP_THREADS; ++t)
+    {
+        threads.emplace_back([&large, &failures, t]() {
+            QAssertMetaDescription description;
+            for (size_t i = t; i < large.table.Size(); i += 97)
+            {
+                if (!QAssertMetaGetDescription(large.table[i].module, large.table[i].id, &description) ||
+                    (description.brief != large.table[i].description.brief))
+                {
+                    ++failures[t];
+                }
+            }
+        });
+    }
+    for (std::thread & thread : threads)
+    {
+        thread.join();
+    }
+
+    for (size_t count : failures)
+    {
+        CHECK_EQUAL(0u, count);
+    }
+    CHECK_TRUE(large.GuardIntact());
+}
@@ -0,0 +1,80 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CppUTest/TestHarness.h"
+#include "qassert-meta-search.h"
+
+TEST_GROUP(qassert_meta_search_tests) {
+    QAssertMetaSearchResult results[8];
+
+    void setup() final
+    {
+    }
+
+    void teardown() final
+    {
+    }
+};
+
+TEST(qassert_meta_search_tests, search_for_symptom_ranks_matching_entries_first)
+{
+    size_t count = QAssertMetaSearch("Queue FULL", results, 8);
+
+    CHECK_TRUE(count > 0);
+    CHECK_EQUAL(2u, results[0].matchedTerms);
+    STRCMP_EQUAL("qf_actq", results[0].item->module);
+    CHECK_EQUAL(190, results[0].item->id);
+    for (size_t i = 1; i < count; ++i)
+    {
+        CHECK_TRUE(results[i - 1].matchedTerms >= results[i].matchedTerms);
+    }
+}
+
+TEST(qassert_meta_search_tests, query_terms_match_longer_words_with_same_prefix)
+{
+    size_t count = QAssertMetaSearch("corrupt", results, 8);
+
+    CHECK_TRUE(count > 0);
+    bool foundCorruption = false;
+    for (size_t i = 0; i < count; ++i)
+    {
+        CHECK_EQUAL(1u, results[i].matchedTerms);
+        const char * tips = results[i].item->description.tips;
+        foundCorruption = foundCorruption || ((nullptr != tips) && (nullptr != strstr(tips, "corruption")));
+    }
+    CHECK_TRUE(foundCorruption);
+}
+
+TEST(qassert_meta_search_tests, results_are_limited_to_capacity)
+{
+    CHECK_EQUAL(1u, QAssertMetaSearch("event pool", results, 1));
+    CHECK_EQUAL(0u, QAssertMetaSearch("event pool", results, 0));
+}
+
+TEST(qassert_meta_search_tests, unmatched_stop_word_or_invalid_query_returns_no_results)
+{
+    CHECK_EQUAL(0u, QAssertMetaSearch("zzzyzzx", results, 8));
+    CHECK_EQUAL(0u, QAssertMetaSearch("the of is", results, 8));
+    CHECK_EQUAL(0u, QAssertMetaSearch("", results, 8));
+    CHECK_EQUAL(0u, QAssertMetaSearch(nullptr, results, 8));
+    CHECK_EQUAL(0u, QAssertMetaSearch("queue", nullptr, 8));
+}
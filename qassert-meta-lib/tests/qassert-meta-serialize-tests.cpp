@@ -0,0 +1,228 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CppUTest/TestHarness.h"
+#include "qassert-meta-serialize.h"
+extern "C" {
+#include "qassert-meta-private.h"
+}
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+const QAssertMetaItem m_items[] = {
+    {"app_motor", 1, {"motor \"M1\" stalled", "check the\nwiring\tharness\x01", nullptr}},
+    {"app_motor", -2, {"negative id", nullptr, "https://example.com/2"}},
+    {nullptr, -1, {nullptr, nullptr, nullptr}}
+};
+
+const char * const MOTOR_1_JSON =
+    "{\"module\":\"app_motor\",\"id\":1,\"brief\":\"motor \\\"M1\\\" stalled\","
+    "\"tips\":\"check the\\nwiring\\tharness\\u0001\"}";
+const char * const MOTOR_2_JSON =
+    "{\"module\":\"app_motor\",\"id\":-2,\"brief\":\"negative id\",\"url\":\"https://example.com/2\"}";
+
+bool AppendOutput(const uint8_t * data, size_t size, void * context)
+{
+    static_cast<std::string *>(context)->append(reinterpret_cast<const char *>(data), size);
+    return true;
+}
+
+//serialize through a tiny buffer, so every entry crosses flushes
+std::string Serialize(QAssertMetaSerializeFormat format, bool (*write)(QAssertMetaSerializer *))
+{
+    std::string output;
+    uint8_t buffer[7];
+    QAssertMetaSerializer serializer;
+    QAssertMetaSerializerInit(&serializer, format, buffer, sizeof(buffer), AppendOutput, &output);
+    CHECK_TRUE(write(&serializer));
+    CHECK_TRUE(QAssertMetaSerializeFinish(&serializer));
+    CHECK_EQUAL(output.size(), QAssertMetaSerializedBytes(&serializer));
+    return output;
+}
+
+} // namespace
+
+TEST_GROUP(qassert_meta_serialize_tests)
+{
+    void setup() final
+    {
+        QAssertMetaInit();
+    }
+
+    void teardown() final
+    {
+        QAssertMetaInit();
+    }
+};
+
+TEST(qassert_meta_serialize_tests, json_entries_are_escaped_and_written_one_per_line)
+{
+    std::string output = Serialize(QASSERT_META_SERIALIZE_JSON, [](QAssertMetaSerializer * serializer) {
+        return QAssertMetaSerializeItems(serializer, m_items, SIZE_MAX);
+    });
+    const std::string expected = std::string(MOTOR_1_JSON) + "\n" + MOTOR_2_JSON + "\n";
+    STRCMP_EQUAL(expected.c_str(), output.c_str());
+}
+
+TEST(qassert_meta_serialize_tests, json_array_separates_elements)
+{
+    std::string output = Serialize(QASSERT_META_SERIALIZE_JSON, [](QAssertMetaSerializer * serializer) {
+        return QAssertMetaSerializeBeginArray(serializer) &&
+               QAssertMetaSerializeEntry(serializer, m_items[0].module, m_items[0].id, &m_items[0].description) &&
+               QAssertMetaSerializeItems(serializer, &m_items[1], 1) &&
+               QAssertMetaSerializeEndArray(serializer);
+    });
+    const std::string expected = std::string("[") + MOTOR_1_JSON + "," + MOTOR_2_JSON + "]\n";
+    STRCMP_EQUAL(expected.c_str(), output.c_str());
+}
+
+TEST(qassert_meta_serialize_tests, cbor_entries_are_maps_of_text_and_integers)
+{
+    std::string output = Serialize(QASSERT_META_SERIALIZE_CBOR, [](QAssertMetaSerializer * serializer) {
+        return QAssertMetaSerializeBeginArray(serializer) &&
+               QAssertMetaSerializeItems(serializer, &m_items[1], 1) &&
+               QAssertMetaSerializeEndArray(serializer);
+    });
+    const std::string expected = std::string("\x9f\xa4") +
+        "\x66" "module" "\x69" "app_motor" +
+        "\x62" "id" "\x21" +
+        "\x65" "brief" "\x6b" "negative id" +
+        "\x63" "url" "\x75" "https://example.com/2" +
+        "\xff";
+    CHECK_EQUAL(expected.size(), output.size());
+    CHECK_TRUE(expected == output);
+}
+
+TEST(qassert_meta_serialize_tests, cbor_lengths_and_ids_use_wider_arguments)
+{
+    static const std::string brief(300, 'x');
+    std::string output = Serialize(QASSERT_META_SERIALIZE_CBOR, [](QAssertMetaSerializer * serializer) {
+        QAssertMetaDescription description = {brief.c_str(), nullptr, nullptr};
+        return QAssertMetaSerializeEntry(serializer, "m", 70000, &description);
+    });
+    const std::string expected = std::string("\xa3\x66" "module" "\x61" "m" "\x62" "id") +
+        std::string("\x1a\x00\x01\x11\x70", 5) +
+        "\x65" "brief" "\x79\x01\x2c" + brief;
+    CHECK_TRUE(expected == output);
+}
+
+TEST(qassert_meta_serialize_tests, without_flush_entries_that_do_not_fit_are_not_written)
+{
+    char buffer[120];
+    QAssertMetaSerializer serializer;
+    QAssertMetaSerializerInit(&serializer, QASSERT_META_SERIALIZE_JSON, buffer, sizeof(buffer), nullptr, nullptr);
+    CHECK_TRUE(QAssertMetaSerializeItems(&serializer, m_items, 1));
+    const size_t used = QAssertMetaSerializedBytes(&serializer);
+    CHECK_FALSE(QAssertMetaSerializeItems(&serializer, &m_items[1], 1));
+    CHECK_FALSE(QAssertMetaSerializeItems(&serializer, m_items, 1)); //failures are sticky
+    CHECK_FALSE(QAssertMetaSerializeFinish(&serializer));
+
+    CHECK_EQUAL(used, QAssertMetaSerializedBytes(&serializer));
+    const std::string expected = std::string(MOTOR_1_JSON) + "\n";
+    const std::string written(buffer, used);
+    STRCMP_EQUAL(expected.c_str(), written.c_str());
+}
+
+TEST(qassert_meta_serialize_tests, without_flush_an_array_is_ended_after_an_entry_that_does_not_fit)
+{
+    //room for exactly the first element and the end of the array
+    std::vector<char> buffer(1 + strlen(MOTOR_1_JSON) + 2);
+    QAssertMetaSerializer serializer;
+    QAssertMetaSerializerInit(&serializer, QASSERT_META_SERIALIZE_JSON, buffer.data(), buffer.size(), nullptr, nullptr);
+    CHECK_TRUE(QAssertMetaSerializeBeginArray(&serializer));
+    CHECK_TRUE(QAssertMetaSerializeItems(&serializer, m_items, 1));
+    CHECK_FALSE(QAssertMetaSerializeItems(&serializer, &m_items[1], 1));
+    CHECK_TRUE(QAssertMetaSerializeEndArray(&serializer));
+    CHECK_FALSE(QAssertMetaSerializeFinish(&serializer)); //incomplete
+
+    const std::string expected = std::string("[") + MOTOR_1_JSON + "]\n";
+    CHECK_EQUAL(expected.size(), QAssertMetaSerializedBytes(&serializer));
+    const std::string written(buffer.data(), expected.size());
+    STRCMP_EQUAL(expected.c_str(), written.c_str());
+
+    //one byte less, and the first element does not fit either
+    QAssertMetaSerializerInit(&serializer, QASSERT_META_SERIALIZE_JSON, buffer.data(), buffer.size() - 1,
+                              nullptr, nullptr);
+    CHECK_TRUE(QAssertMetaSerializeBeginArray(&serializer));
+    CHECK_FALSE(QAssertMetaSerializeItems(&serializer, m_items, 1));
+    CHECK_TRUE(QAssertMetaSerializeEndArray(&serializer));
+    CHECK_EQUAL(3u, QAssertMetaSerializedBytes(&serializer));
+    const std::string empty(buffer.data(), 3);
+    STRCMP_EQUAL("[]\n", empty.c_str());
+
+    uint8_t cbor[2];
+    QAssertMetaSerializerInit(&serializer, QASSERT_META_SERIALIZE_CBOR, cbor, sizeof(cbor), nullptr, nullptr);
+    CHECK_TRUE(QAssertMetaSerializeBeginArray(&serializer));
+    CHECK_FALSE(QAssertMetaSerializeItems(&serializer, m_items, 1));
+    CHECK_TRUE(QAssertMetaSerializeEndArray(&serializer));
+    CHECK_EQUAL(2u, QAssertMetaSerializedBytes(&serializer));
+    CHECK_EQUAL(0x9Fu, cbor[0]);
+    CHECK_EQUAL(0xFFu, cbor[1]);
+}
+
+TEST(qassert_meta_serialize_tests, all_entries_match_the_runtime_serialization_of_each_lookup)
+{
+    static const QAssertMetaItem registered[] = {
+        {"app_pump", 7, {"registered pump", nullptr, nullptr}},
+        {nullptr, -1, {nullptr, nullptr, nullptr}}
+    };
+    CHECK_TRUE(QAssertMetaRegisterTable(registered));
+
+    //the internal table is copied from its generated JSON, the rest is escaped now
+    std::string all = Serialize(QASSERT_META_SERIALIZE_JSON, [](QAssertMetaSerializer * serializer) {
+        return QAssertMetaSerializeAll(serializer);
+    });
+    std::string expected = Serialize(QASSERT_META_SERIALIZE_JSON, [](QAssertMetaSerializer * serializer) {
+        bool ok = true;
+        for (size_t i = 0; ok && (nullptr != m_qassert_meta_items[i].module); ++i)
+        {
+            const QAssertMetaItem * entry = QAssertMetaPrivateBuiltinEntry(&m_qassert_meta_items[i]);
+            ok = QAssertMetaSerializeEntry(serializer, entry->module, entry->id, &entry->description);
+        }
+        return ok && QAssertMetaSerializeItems(serializer, registered, SIZE_MAX);
+    });
+    CHECK_TRUE(expected.size() > 10000u);
+    CHECK_TRUE(expected == all);
+}
+
+TEST(qassert_meta_serialize_tests, writes_to_a_file_descriptor)
+{
+    FILE * file = tmpfile();
+    CHECK_TRUE(nullptr != file);
+    uint8_t buffer[16];
+    QAssertMetaSerializer serializer;
+    QAssertMetaSerializerInitFd(&serializer, QASSERT_META_SERIALIZE_JSON, buffer, sizeof(buffer), fileno(file));
+    CHECK_TRUE(QAssertMetaSerializeItems(&serializer, m_items, SIZE_MAX));
+    CHECK_TRUE(QAssertMetaSerializeFinish(&serializer));
+
+    char contents[512] = {};
+    rewind(file);
+    size_t read = fread(contents, 1, sizeof(contents) - 1, file);
+    fclose(file);
+    const std::string expected = std::string(MOTOR_1_JSON) + "\n" + MOTOR_2_JSON + "\n";
+    CHECK_EQUAL(expected.size(), read);
+    STRCMP_EQUAL(expected.c_str(), contents);
+}
@@ -0,0 +1,83 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * Startup probe for qassert-meta-startup-tests.cpp and qassert-meta-bench:
+ * a process that registers a large indexed table and exits without any
+ * assert firing, printing its resident anonymous memory in KB (-1 if unknown). The baseline
+ * build (QASSERT_META_STARTUP_BASELINE) does the same work without the
+ * library, so the two may be compared for time and memory.
+ */
+
+#include "qassert-meta.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#define PROBE_ITEMS 32768
+
+static QAssertMetaItem m_items[PROBE_ITEMS + 1];
+static uint32_t m_index[PROBE_ITEMS * 4]; //index storage, 512KB once written
+void * volatile m_sink;
+
+//anonymous memory only: the executable's pages mapped from the page cache
+//vary from run to run, the tables and index storage written do not
+static long AnonResidentKb(void)
+{
+    long anon = -1;
+    char line[128];
+    FILE * status = fopen("/proc/self/status", "r");
+    while ((NULL != status) && (NULL != fgets(line, sizeof(line), status)))
+    {
+        if (1 == sscanf(line, "RssAnon: %ld", &anon))
+        {
+            break;
+        }
+    }
+    if (NULL != status)
+    {
+        fclose(status);
+    }
+    return anon;
+}
+
+int main(void)
+{
+    for (int i = 0; i < PROBE_ITEMS; ++i)
+    {
+        m_items[i].module = "probe";
+        m_items[i].id = i;
+        m_items[i].description.brief = "probe";
+    }
+
+#if QASSERT_META_STARTUP_BASELINE
+    //the tables escape, so the optimizer keeps the work done above
+    m_sink = m_items;
+    m_sink = m_index;
+#else
+    if (!QAssertMetaRegisterIndexedTable(m_items, m_index, sizeof(m_index)))
+    {
+        return 1;
+    }
+#endif
+    printf("%ld\n", AnonResidentKb());
+    return 0;
+}
@@ -0,0 +1,81 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CppUTest/TestHarness.h"
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <string>
+
+/**
+ * Startup cost when no assert fires: the probe (tests/qassert-meta-startup-probe.c)
+ * registers a large indexed table and exits, compared with a baseline build
+ * of it without the library. Building the index at registration would
+ * write 512KB, so would show in the probe's resident anonymous memory. The startup time
+ * of the two is compared by the benchmarks (qassert-meta-bench --compare).
+ */
+
+namespace {
+
+constexpr int RUNS = 5;
+constexpr long MAX_EXTRA_RSS_KB = 64;
+
+//the least resident anonymous memory of the runs, -1 if unknown
+long MinAnonRssKb(const char * path)
+{
+    long minRssKb = LONG_MAX;
+    for (int run = 0; run < RUNS; ++run)
+    {
+        FILE * probe = popen(path, "r");
+        CHECK_TRUE(nullptr != probe);
+        long rssKb = -1;
+        CHECK_EQUAL(1, fscanf(probe, "%ld", &rssKb));
+        CHECK_EQUAL(0, pclose(probe));
+        minRssKb = std::min(minRssKb, rssKb);
+    }
+    return minRssKb;
+}
+
+} // namespace
+
+TEST_GROUP(qassert_meta_startup_tests) {
+    void setup() final
+    {
+    }
+
+    void teardown() final
+    {
+    }
+};
+
+TEST(qassert_meta_startup_tests, memory_unchanged_when_no_assert_fires)
+{
+    long baselineKb = MinAnonRssKb(QASSERT_META_STARTUP_BASELINE);
+    long probeKb = MinAnonRssKb(QASSERT_META_STARTUP_PROBE);
+
+    std::string report = "baseline " + std::to_string(baselineKb) + " KB, with library " +
+                         std::to_string(probeKb) + " KB";
+    if ((baselineKb >= 0) && (probeKb >= 0))
+    {
+        CHECK_TEXT(probeKb <= (baselineKb + MAX_EXTRA_RSS_KB), report);
+    }
+}
@@ -0,0 +1,112 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CppUTest/TestHarness.h"
+#include "qassert-meta-stats.h"
+#include <cstring>
+
+TEST_GROUP(qassert_meta_stats_tests) {
+    QAssertMetaStatsCounters counters;
+
+    void setup() final
+    {
+        QAssertMetaInit();
+        QAssertMetaStatsReset();
+        memset(&counters, 0, sizeof(counters));
+    }
+
+    void teardown() final
+    {
+    }
+};
+
+#if QASSERT_META_ENABLE_STATS
+
+TEST(qassert_meta_stats_tests, lookup_outcomes_are_counted)
+{
+    static const QAssertMetaItem appTable[] = {
+        {"app_module", 1, {"app brief", nullptr, nullptr}},
+        {nullptr, 0, {nullptr, nullptr, nullptr}}
+    };
+    QAssertMetaDescription description;
+    CHECK_TRUE(QAssertMetaRegisterTable(appTable));
+
+    QAssertMetaGetDescription("qf_actq", 190, &description);
+    QAssertMetaGetDescription("qf_actq", 190, &description);
+    QAssertMetaGetDescription("app_module", 1, &description);
+    QAssertMetaGetDescription("gobble", 1, &description);
+    QAssertMetaGetDescription(nullptr, 1, &description);
+    QAssertMetaRegisterUnknownCallback([](const char *, int, QAssertMetaDescription *) { return true; });
+    QAssertMetaGetDescription("gobble", 1, &description);
+
+    CHECK_TRUE(QAssertMetaStatsGetCounters(&counters));
+    CHECK_EQUAL(6u, counters.lookups);
+    CHECK_EQUAL(1u, counters.nullArgumentRejections);
+    CHECK_EQUAL(2u, counters.builtinHits);
+    CHECK_EQUAL(1u, counters.registeredHits);
+    CHECK_EQUAL(1u, counters.registeredTableHits[0]);
+    CHECK_EQUAL(1u, counters.unknownCallbackCalls);
+    CHECK_EQUAL(1u, counters.unknownCallbackHits);
+    CHECK_EQUAL(1u, counters.misses);
+}
+
+TEST(qassert_meta_stats_tests, entries_hit_are_visited_with_counts_and_survive_init)
+{
+    QAssertMetaDescription description;
+    QAssertMetaGetDescription("qf_actq", 190, &description);
+    QAssertMetaInit();
+    QAssertMetaGetDescription("qf_actq", 190, &description);
+    QAssertMetaGetDescription("qep_hsm", 200, &description);
+
+    struct Visited { int count; uint32_t actq190Hits; };
+    Visited visited = {0, 0};
+    auto visitor = [](const QAssertMetaItem * item, uint32_t hits, void * context) {
+        auto * v = static_cast<Visited *>(context);
+        ++v->count;
+        if ((0 == strcmp(item->module, "qf_actq")) && (item->id == 190))
+        {
+            v->actq190Hits = hits;
+        }
+        return true;
+    };
+
+    CHECK_EQUAL(2u, QAssertMetaStatsForEachEntry(visitor, &visited));
+    CHECK_EQUAL(2, visited.count);
+    CHECK_EQUAL(2u, visited.actq190Hits);
+
+    QAssertMetaStatsReset();
+    CHECK_EQUAL(0u, QAssertMetaStatsForEachEntry(visitor, &visited));
+}
+
+#else
+
+TEST(qassert_meta_stats_tests, statistics_are_unavailable_when_disabled)
+{
+    QAssertMetaDescription description;
+    QAssertMetaGetDescription("qf_actq", 190, &description);
+
+    CHECK_FALSE(QAssertMetaStatsGetCounters(&counters));
+    CHECK_EQUAL(0u, QAssertMetaStatsForEachEntry(
+            [](const QAssertMetaItem *, uint32_t, void *) { return true; }, nullptr));
+}
+
+#endif
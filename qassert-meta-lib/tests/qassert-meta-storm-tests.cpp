@@ -0,0 +1,154 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CppUTest/TestHarness.h"
+#include "qassert-meta-storm.h"
+#include <string>
+#include <vector>
+
+using namespace qassert_meta;
+
+namespace {
+
+constexpr uint64_t SECOND = 1000000000ull;
+
+struct RecordingStorms : public StormListener {
+    std::vector<std::string> started;
+    std::vector<StormSummary> ended;
+    std::vector<std::string> endedModules;
+
+    void OnStormStart(const StormSummary & storm) override
+    {
+        started.push_back(std::string(storm.module, storm.moduleLength) + ":" + std::to_string(storm.id));
+    }
+
+    void OnStormEnd(const StormSummary & storm) override
+    {
+        ended.push_back(storm);
+        endedModules.emplace_back(storm.module, storm.moduleLength);
+    }
+};
+
+} // namespace
+
+TEST_GROUP(qassert_meta_storm_tests)
+{
+    RecordingStorms listener;
+    StormConfig config;
+
+    void setup() final
+    {
+        config.window = 10 * SECOND;
+        config.threshold = 10;
+    }
+
+    void teardown() final
+    {
+    }
+};
+
+TEST(qassert_meta_storm_tests, repeats_at_the_threshold_rate_are_collapsed)
+{
+    StormDetector storms(listener, config);
+    unsigned shown = 0;
+    for (uint64_t i = 0; i < 100; ++i)
+    {
+        shown += storms.Observe("qf_actq", 7, 190, i * (SECOND / 10)) ? 1u : 0u;
+        CHECK_TRUE(storms.Observe("qf_mem", 6, 110, i * 2 * SECOND)); //half the threshold rate
+    }
+    CHECK_EQUAL(10u, shown);
+    CHECK_EQUAL(1u, listener.started.size());
+    STRCMP_EQUAL("qf_actq:190", listener.started[0].c_str());
+    CHECK_EQUAL(90u, storms.Stats().collapsed);
+    CHECK_EQUAL(1u, storms.Stats().storms);
+}
+
+TEST(qassert_meta_storm_tests, storm_ends_with_a_summary_when_the_rate_falls)
+{
+    StormDetector storms(listener, config);
+    for (uint64_t i = 0; i < 50; ++i)
+    {
+        (void)storms.Observe("qf_actq", 7, 190, i * (SECOND / 10));
+    }
+    storms.Poll(5 * SECOND);
+    CHECK_EQUAL(0u, listener.ended.size());
+
+    storms.Poll(20 * SECOND); //quiet for a whole window
+    CHECK_EQUAL(1u, listener.ended.size());
+    STRCMP_EQUAL("qf_actq", listener.endedModules[0].c_str());
+    CHECK_EQUAL(190, listener.ended[0].id);
+    CHECK_EQUAL(40u, listener.ended[0].collapsed);
+    CHECK_EQUAL(49 * (SECOND / 10), listener.ended[0].last);
+
+    //shown again, a new storm may start
+    CHECK_TRUE(storms.Observe("qf_actq", 7, 190, 21 * SECOND));
+}
+
+TEST(qassert_meta_storm_tests, finish_ends_the_active_storms)
+{
+    StormDetector storms(listener, config);
+    for (uint64_t i = 0; i < 30; ++i)
+    {
+        (void)storms.Observe("qf_actq", 7, 190, i);
+        (void)storms.Observe("qf_actq", 7, 110, i);
+    }
+    storms.Finish(30);
+    CHECK_EQUAL(2u, listener.ended.size());
+    CHECK_EQUAL(20u, listener.ended[0].collapsed);
+    storms.Finish(31);
+    CHECK_EQUAL(2u, listener.ended.size());
+}
+
+TEST(qassert_meta_storm_tests, idle_pairs_make_room_in_fixed_capacity)
+{
+    config.capacity = 4;
+    StormDetector storms(listener, config);
+    for (int id = 0; id < 4; ++id)
+    {
+        CHECK_TRUE(storms.Observe("app", 3, id, 0));
+    }
+    CHECK_TRUE(storms.Observe("app", 3, 4, 0));
+    CHECK_EQUAL(1u, storms.Stats().untracked);
+
+    //a window later the first pairs are idle and dropped
+    for (uint64_t i = 0; i < 20; ++i)
+    {
+        (void)storms.Observe("qf_actq", 7, 190, (20 * SECOND) + i);
+    }
+    CHECK_EQUAL(1u, storms.Stats().untracked);
+    CHECK_EQUAL(1u, listener.started.size());
+    CHECK_EQUAL(10u, storms.Stats().collapsed);
+}
+
+TEST(qassert_meta_storm_tests, long_module_names_are_distinguished)
+{
+    const std::string first = std::string(40, 'm') + "1";
+    const std::string second = std::string(40, 'm') + "2";
+    StormDetector storms(listener, config);
+    for (uint64_t i = 0; i < 10; ++i)
+    {
+        (void)storms.Observe(first.data(), first.size(), 1, i);
+        CHECK_TRUE(storms.Observe(second.data(), second.size(), 1, i) || (i == 9));
+    }
+    CHECK_EQUAL(2u, listener.started.size());
+    CHECK_EQUAL(StormDetector::MODULE_SIZE - 1u + 2u, listener.started[0].size());
+}
@@ -0,0 +1,38 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * Locations for the qassert-meta-location-tests, in the form written by
+ * qassert-meta-extract --locations.
+ */
+
+#include "qassert-meta-private.h"
+#include <stddef.h>
+
+const QAssertMetaLocationItem m_qassert_meta_location_items[] = {
+    {"not_in_table", 1, {"src/qf/not_in_table.c", 10, "Nothing_func"}},
+    {"qf_actq", 102, {"src/qf/qf_actq.c", 120, "QActive_post_"}},
+    {"qf_actq", 102, {"src/qf/duplicate.c", 1, "Duplicate_func"}},
+    {"qf_actq", 190, {"src/qf/qf_actq.c", 210, NULL}},
+    {"qf_actq", 202, {"src/qf/qf_actq.c", 305, "QActive_post_"}},
+    {NULL, -1, {NULL, 0, NULL}}
+};
@@ -0,0 +1,164 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * Ranks the asserts reported by a set of logs (such as crash reports of a
+ * fleet of devices) by frequency, per firmware version, with descriptions.
+ *
+ * usage: qassert-meta-aggregate [--threads N] [--top N] [--no-version]
+ *                               [--sketch [--width N] [--depth N] [--candidates N]]
+ *                               <log file or directory>...
+ *
+ *  Log lines report asserts as QSPY does ("Mod=qf_actq,Loc=190") or as
+ *  "ASSERT qf_actq:190", and firmware versions by a "version=<value>" token,
+ *  applying to the asserts of that line and those after it in the same file.
+ *
+ *  --no-version: count across versions.
+ *  --sketch:     estimate counts with a count-min sketch of width x depth
+ *                counters per thread, tracking the top candidates keys,
+ *                so memory is bounded however many distinct asserts occur.
+ */
+
+#include "qassert-meta-aggregator.h"
+#include "qassert-meta.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+using namespace qassert_meta;
+
+namespace {
+
+int Usage(const char * program)
+{
+    fprintf(stderr, "usage: %s [--threads N] [--top N] [--no-version] "
+                    "[--sketch [--width N] [--depth N] [--candidates N]] <log file or directory>...\n", program);
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    AggregateConfig config;
+    config.threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t top = 50;
+    std::vector<std::string> roots;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char * value = ((i + 1) < argc) ? argv[i + 1] : nullptr;
+        size_t * number = nullptr;
+        if (0 == strcmp(argv[i], "--top"))
+        {
+            number = &top;
+        }
+        else if (0 == strcmp(argv[i], "--width"))
+        {
+            number = &config.sketchWidth;
+        }
+        else if (0 == strcmp(argv[i], "--depth"))
+        {
+            number = &config.sketchDepth;
+        }
+        else if (0 == strcmp(argv[i], "--candidates"))
+        {
+            number = &config.candidates;
+        }
+
+        if ((nullptr != number) && value)
+        {
+            *number = strtoull(value, nullptr, 10);
+            ++i;
+        }
+        else if ((0 == strcmp(argv[i], "--threads")) && value)
+        {
+            config.threads = static_cast<unsigned>(strtoul(value, nullptr, 10));
+            ++i;
+        }
+        else if (0 == strcmp(argv[i], "--no-version"))
+        {
+            config.byVersion = false;
+        }
+        else if (0 == strcmp(argv[i], "--sketch"))
+        {
+            config.sketch = true;
+        }
+        else if (argv[i][0] != '-')
+        {
+            roots.push_back(argv[i]);
+        }
+        else
+        {
+            return Usage(argv[0]);
+        }
+    }
+    if (roots.empty())
+    {
+        return Usage(argv[0]);
+    }
+
+    std::vector<std::string> files;
+    for (const std::string & root : roots)
+    {
+        std::vector<std::string> listed;
+        if (!ListLogFiles(root, listed))
+        {
+            fprintf(stderr, "unable to read %s\n", root.c_str());
+            return 1;
+        }
+        files.insert(files.end(), listed.begin(), listed.end());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    AggregateStats stats;
+    std::vector<AggregateCount> ranked = AggregateLogs(files, config, &stats);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    printf("%-5s %12s  %-32s %-16s %s\n", "rank", config.sketch ? "~count" : "count", "assert", "version",
+           "description");
+    for (size_t i = 0; i < std::min(top, ranked.size()); ++i)
+    {
+        const AggregateCount & count = ranked[i];
+        QAssertMetaDescription description;
+        bool described = QAssertMetaGetDescriptionN(count.key.module.data(), count.key.module.size(), count.key.id,
+                                                    &description);
+        std::string assert = count.key.module + ":" + std::to_string(count.key.id);
+        printf("%-5zu %12llu  %-32s %-16s %s\n", i + 1, static_cast<unsigned long long>(count.count),
+               assert.c_str(), count.key.version.empty() ? "-" : count.key.version.c_str(),
+               described ? description.brief : "(not described)");
+        if (described && (nullptr != description.url))
+        {
+            printf("%70s %s\n", "", description.url);
+        }
+    }
+
+    fprintf(stderr, "%zu files (%zu unreadable), %.1f MB, %llu lines, %llu asserts, %zu distinct%s, "
+                    "%.3f s (%.0f MB/s) on %u threads\n", stats.files, stats.failedFiles,
+            static_cast<double>(stats.bytes) / 1e6, static_cast<unsigned long long>(stats.lines),
+            static_cast<unsigned long long>(stats.asserts), ranked.size(), config.sketch ? " tracked" : "",
+            elapsed.count(), static_cast<double>(stats.bytes) / 1e6 / elapsed.count(), config.threads);
+    return (stats.failedFiles > 0) ? 1 : 0;
+}
@@ -0,0 +1,421 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "qassert-meta-aggregator.h"
+#include "qassert-meta-host-files.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <sys/stat.h>
+
+namespace qassert_meta {
+
+namespace {
+
+//FNV-1a, 64 bit
+uint64_t HashBytes(uint64_t hash, const char * data, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t KeyHash(const char * module, size_t moduleLength, int id, const char * version, size_t versionLength)
+{
+    uint64_t hash = HashBytes(14695981039346656037ull, module, moduleLength);
+    uint32_t uid = static_cast<uint32_t>(id);
+    char separated[5] = {static_cast<char>(uid), static_cast<char>(uid >> 8u), static_cast<char>(uid >> 16u),
+                         static_cast<char>(uid >> 24u), '\0'};
+    hash = HashBytes(hash, separated, sizeof(separated));
+    return HashBytes(hash, version, versionLength);
+}
+
+uint64_t KeyHash(const AggregateKey & key)
+{
+    return KeyHash(key.module.data(), key.module.size(), key.id, key.version.data(), key.version.size());
+}
+
+const char * Find(const char * data, size_t size, const char * pattern)
+{
+    return static_cast<const char *>(memmem(data, size, pattern, strlen(pattern)));
+}
+
+bool IsSpace(char c)
+{
+    return (c == ' ') || (c == '\t') || (c == '\r');
+}
+
+/**
+ * Parse a decimal int at text, optionally negative.
+ * @return: false if no digits, or out of range.
+ */
+bool ParseId(const char * text, const char * end, int * id)
+{
+    bool negative = (text < end) && (*text == '-');
+    text += negative ? 1 : 0;
+    long long value = 0;
+    const char * digits = text;
+    while ((text < end) && (*text >= '0') && (*text <= '9') && (value <= INT_MAX))
+    {
+        value = (value * 10) + (*text - '0');
+        ++text;
+    }
+    value = negative ? -value : value;
+    if ((text == digits) || (value > INT_MAX) || (value < INT_MIN))
+    {
+        return false;
+    }
+    *id = static_cast<int>(value);
+    return true;
+}
+
+bool RankedBefore(const AggregateCount & a, const AggregateCount & b)
+{
+    if (a.count != b.count)
+    {
+        return a.count > b.count;
+    }
+    if (a.key.module != b.key.module)
+    {
+        return a.key.module < b.key.module;
+    }
+    if (a.key.id != b.key.id)
+    {
+        return a.key.id < b.key.id;
+    }
+    return a.key.version < b.key.version;
+}
+
+} // namespace
+
+bool ParseLogAssert(const char * line, size_t length, LogAssert * output)
+{
+    const char * end = line + length;
+
+    //QSPY: Mod=<module>,Loc=<id>
+    const char * module = Find(line, length, "Mod=");
+    if (nullptr != module)
+    {
+        module += 4;
+        const char * comma = static_cast<const char *>(memchr(module, ',', static_cast<size_t>(end - module)));
+        if ((nullptr != comma) && (comma > module) && ((end - comma) > 5) && (0 == memcmp(comma, ",Loc=", 5)) &&
+            ParseId(comma + 5, end, &output->id))
+        {
+            output->module = module;
+            output->moduleLength = static_cast<size_t>(comma - module);
+            return true;
+        }
+    }
+
+    //plain: ASSERT <module>:<id>
+    for (const char * at = Find(line, length, "ASSERT"); nullptr != at;
+         at = Find(at + 1, static_cast<size_t>(end - at - 1), "ASSERT"))
+    {
+        const char * text = at + 6;
+        if ((text == end) || !IsSpace(*text))
+        {
+            continue;
+        }
+        while ((text < end) && IsSpace(*text))
+        {
+            ++text;
+        }
+        module = text;
+        while ((text < end) && (*text != ':') && !IsSpace(*text))
+        {
+            ++text;
+        }
+        if ((text > module) && (text < end) && (*text == ':') && ParseId(text + 1, end, &output->id))
+        {
+            output->module = module;
+            output->moduleLength = static_cast<size_t>(text - module);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ParseLogVersion(const char * line, size_t length, const char ** version, size_t * versionLength)
+{
+    const char * value = Find(line, length, "version=");
+    if (nullptr == value)
+    {
+        return false;
+    }
+    value += 8;
+    const char * end = value;
+    while ((end < (line + length)) && !IsSpace(*end) && (*end != ',') && (*end != ';'))
+    {
+        ++end;
+    }
+    *version = value;
+    *versionLength = static_cast<size_t>(end - value);
+    return true;
+}
+
+size_t AggregateKeyHash::operator()(const AggregateKey & key) const
+{
+    return static_cast<size_t>(KeyHash(key));
+}
+
+AggregateShard::AggregateShard(const AggregateConfig & config) :
+    m_config(config)
+{
+    if (m_config.sketch)
+    {
+        size_t width = 1;
+        while (width < m_config.sketchWidth)
+        {
+            width <<= 1u;
+        }
+        m_config.sketchWidth = width;
+        m_config.sketchDepth = std::max<size_t>(1, m_config.sketchDepth);
+        m_config.candidates = std::max<size_t>(1, m_config.candidates);
+        m_sketchMask = width - 1u;
+        m_sketch.assign(width * m_config.sketchDepth, 0);
+        m_candidates.reserve(m_config.candidates);
+    }
+}
+
+void AggregateShard::CountLog(const char * text, size_t size)
+{
+    const char * version = "";
+    size_t versionLength = 0;
+    const char * end = text + size;
+    while (text < end)
+    {
+        const char * newline = static_cast<const char *>(memchr(text, '\n', static_cast<size_t>(end - text)));
+        const char * lineEnd = (nullptr == newline) ? end : newline;
+        size_t length = static_cast<size_t>(lineEnd - text);
+        ++m_stats.lines;
+
+        (void)ParseLogVersion(text, length, &version, &versionLength);
+        LogAssert found;
+        if (ParseLogAssert(text, length, &found))
+        {
+            Count(found.module, found.moduleLength, found.id, version, versionLength);
+        }
+        text = lineEnd + 1;
+    }
+}
+
+void AggregateShard::Count(const char * module, size_t moduleLength, int id, const char * version,
+                           size_t versionLength, uint64_t count)
+{
+    ++m_stats.asserts;
+    if (!m_config.byVersion)
+    {
+        versionLength = 0;
+    }
+    m_scratch.module.assign(module, moduleLength);
+    m_scratch.id = id;
+    m_scratch.version.assign(version, versionLength);
+
+    if (!m_config.sketch)
+    {
+        auto found = m_counts.find(m_scratch);
+        if (found != m_counts.end())
+        {
+            found->second += count;
+        }
+        else
+        {
+            m_counts.emplace(m_scratch, count);
+        }
+        return;
+    }
+
+    uint64_t hash = KeyHash(module, moduleLength, id, version, versionLength);
+    uint64_t step = (hash >> 32u) | 1u;
+    for (size_t row = 0; row < m_config.sketchDepth; ++row)
+    {
+        m_sketch[(row * m_config.sketchWidth) + ((hash + (row * step)) & m_sketchMask)] += count;
+    }
+    TrackCandidate(m_scratch, Estimate(hash));
+}
+
+uint64_t AggregateShard::Estimate(uint64_t hash) const
+{
+    uint64_t step = (hash >> 32u) | 1u;
+    uint64_t estimate = UINT64_MAX;
+    for (size_t row = 0; row < m_config.sketchDepth; ++row)
+    {
+        estimate = std::min(estimate, m_sketch[(row * m_config.sketchWidth) + ((hash + (row * step)) & m_sketchMask)]);
+    }
+    return estimate;
+}
+
+void AggregateShard::TrackCandidate(const AggregateKey & key, uint64_t estimate)
+{
+    auto found = m_candidates.find(key);
+    if (found != m_candidates.end())
+    {
+        found->second = estimate;
+        return;
+    }
+    if (m_candidates.size() < m_config.candidates)
+    {
+        m_candidates.emplace(key, estimate);
+        return;
+    }
+    if (estimate <= m_candidateFloor)
+    {
+        return;
+    }
+
+    //the floor stays below every candidate estimate, as estimates only grow
+    auto lowest = m_candidates.begin();
+    for (auto candidate = m_candidates.begin(); candidate != m_candidates.end(); ++candidate)
+    {
+        if (candidate->second < lowest->second)
+        {
+            lowest = candidate;
+        }
+    }
+    m_candidateFloor = lowest->second;
+    if (estimate > lowest->second)
+    {
+        m_candidates.erase(lowest);
+        m_candidates.emplace(key, estimate);
+    }
+}
+
+void AggregateShard::Merge(const AggregateShard & other)
+{
+    m_stats.files += other.m_stats.files;
+    m_stats.failedFiles += other.m_stats.failedFiles;
+    m_stats.bytes += other.m_stats.bytes;
+    m_stats.lines += other.m_stats.lines;
+    m_stats.asserts += other.m_stats.asserts;
+
+    if (!m_config.sketch)
+    {
+        for (const auto & count : other.m_counts)
+        {
+            m_counts[count.first] += count.second;
+        }
+        return;
+    }
+
+    //sketches are linear: the merged sketch is the sum
+    for (size_t i = 0; i < m_sketch.size(); ++i)
+    {
+        m_sketch[i] += other.m_sketch[i];
+    }
+
+    std::vector<AggregateCount> merged;
+    merged.reserve(m_candidates.size() + other.m_candidates.size());
+    for (const auto & candidate : m_candidates)
+    {
+        merged.push_back({candidate.first, Estimate(KeyHash(candidate.first))});
+    }
+    for (const auto & candidate : other.m_candidates)
+    {
+        if (m_candidates.find(candidate.first) == m_candidates.end())
+        {
+            merged.push_back({candidate.first, Estimate(KeyHash(candidate.first))});
+        }
+    }
+    std::sort(merged.begin(), merged.end(), RankedBefore);
+    merged.resize(std::min(merged.size(), m_config.candidates));
+
+    m_candidates.clear();
+    for (const AggregateCount & candidate : merged)
+    {
+        m_candidates.emplace(candidate.key, candidate.count);
+    }
+    m_candidateFloor = merged.empty() ? 0 : merged.back().count;
+}
+
+std::vector<AggregateCount> AggregateShard::Ranked() const
+{
+    std::vector<AggregateCount> ranked;
+    if (!m_config.sketch)
+    {
+        ranked.reserve(m_counts.size());
+        for (const auto & count : m_counts)
+        {
+            ranked.push_back({count.first, count.second});
+        }
+    }
+    else
+    {
+        ranked.reserve(m_candidates.size());
+        for (const auto & candidate : m_candidates)
+        {
+            ranked.push_back({candidate.first, Estimate(KeyHash(candidate.first))});
+        }
+    }
+    std::sort(ranked.begin(), ranked.end(), RankedBefore);
+    return ranked;
+}
+
+std::vector<AggregateCount> AggregateLogs(const std::vector<std::string> & files, const AggregateConfig & config,
+                                          AggregateStats * stats)
+{
+    std::vector<AggregateShard> shards(ParallelWorkerCount(files.size(), config.threads), AggregateShard(config));
+    ParallelWorkers(files.size(), config.threads, [&files, &shards](size_t worker, size_t i) {
+        AggregateShard & shard = shards[worker];
+        MappedFile file;
+        if (!file.Open(files[i]))
+        {
+            ++shard.Stats().failedFiles;
+            return;
+        }
+        ++shard.Stats().files;
+        shard.Stats().bytes += file.Size();
+        shard.CountLog(file.Data(), file.Size());
+    });
+
+    for (size_t i = 1; i < shards.size(); ++i)
+    {
+        shards[0].Merge(shards[i]);
+    }
+    if (nullptr != stats)
+    {
+        *stats = shards[0].Stats();
+    }
+    return shards[0].Ranked();
+}
+
+bool ListLogFiles(const std::string & root, std::vector<std::string> & files)
+{
+    files.clear();
+    struct stat info;
+    if ((0 == stat(root.c_str(), &info)) && S_ISREG(info.st_mode))
+    {
+        files.push_back(root);
+        return true;
+    }
+
+    if (!ListDirectory(root, files, [](const char *) { return true; }))
+    {
+        return false;
+    }
+    std::sort(files.begin(), files.end());
+    return true;
+}
+
+} // namespace qassert_meta
@@ -0,0 +1,163 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_AGGREGATOR_H
+#define QASSERT_META_QASSERT_META_AGGREGATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace qassert_meta {
+
+/**
+ * An assert reported by a log line, module is a slice of the line.
+ */
+struct LogAssert {
+    const char * module;
+    size_t moduleLength;
+    int id;
+};
+
+/**
+ * Parse an assert from one log line, in either form:
+ *   QSPY:     "... =ASSERT= Mod=qf_actq,Loc=190 ..."
+ *   plain:    "... ASSERT qf_actq:190 ..."
+ * @return: false if the line reports no assert.
+ */
+bool ParseLogAssert(const char * line, size_t length, LogAssert * output);
+
+/**
+ * Find the firmware version given by a "version=<value>" token of a log
+ * line, the value ending at whitespace, ',' or ';'.
+ * @return: false if the line gives no version.
+ */
+bool ParseLogVersion(const char * line, size_t length, const char ** version, size_t * versionLength);
+
+struct AggregateKey {
+    std::string module;
+    int id = 0;
+    std::string version; //empty if not aggregated by version
+
+    bool operator==(const AggregateKey & other) const
+    {
+        return (id == other.id) && (module == other.module) && (version == other.version);
+    }
+};
+
+struct AggregateKeyHash {
+    size_t operator()(const AggregateKey & key) const;
+};
+
+struct AggregateConfig {
+    unsigned threads = 1;
+    bool byVersion = true;
+
+    //count-min sketch mode: counts are estimated in fixed memory per thread,
+    //width * depth counters and up to candidates keys tracked for the report.
+    bool sketch = false;
+    size_t sketchWidth = 65536;  //rounded up to a power of two
+    size_t sketchDepth = 4;
+    size_t candidates = 1024;
+};
+
+struct AggregateCount {
+    AggregateKey key;
+    uint64_t count;   //in sketch mode an estimate, never below the true count
+};
+
+struct AggregateStats {
+    size_t files = 0;
+    size_t failedFiles = 0;
+    uint64_t bytes = 0;
+    uint64_t lines = 0;
+    uint64_t asserts = 0;
+};
+
+/**
+ * Counts of the asserts of a set of logs, by (module, id, version).
+ * Each worker thread counts into its own shard, shards are merged at the end,
+ * so counting takes no locks. In sketch mode memory is bounded regardless of
+ * the number of distinct keys, at the cost of estimated counts.
+ */
+class AggregateShard {
+public:
+    explicit AggregateShard(const AggregateConfig & config);
+
+    /**
+     * Count the asserts of one log's text. A version applies to the
+     * asserts of its line and those after it, until the next version.
+     */
+    void CountLog(const char * text, size_t size);
+
+    void Count(const char * module, size_t moduleLength, int id, const char * version, size_t versionLength,
+               uint64_t count = 1);
+
+    /**
+     * Add the counts of other, configured alike, to this shard.
+     */
+    void Merge(const AggregateShard & other);
+
+    /**
+     * @return: the counts, most frequent first (then by module, id and version).
+     *          In sketch mode, the candidates keys with their estimates.
+     */
+    std::vector<AggregateCount> Ranked() const;
+
+    const AggregateStats & Stats() const { return m_stats; }
+    AggregateStats & Stats() { return m_stats; }
+
+private:
+    uint64_t Estimate(uint64_t hash) const;
+    void TrackCandidate(const AggregateKey & key, uint64_t estimate);
+
+    AggregateConfig m_config;
+    AggregateStats m_stats;
+    AggregateKey m_scratch; //reused, so counting a known key does not allocate
+
+    std::unordered_map<AggregateKey, uint64_t, AggregateKeyHash> m_counts; //exact mode
+
+    size_t m_sketchMask = 0; //sketch mode
+    std::vector<uint64_t> m_sketch;
+    std::unordered_map<AggregateKey, uint64_t, AggregateKeyHash> m_candidates; //to their estimates
+    uint64_t m_candidateFloor = 0; //no candidate has a lower estimate
+};
+
+/**
+ * Count the asserts of log files on a pool of config.threads threads.
+ * @return: the merged counts, ranked, see AggregateShard::Ranked.
+ */
+std::vector<AggregateCount> AggregateLogs(const std::vector<std::string> & files, const AggregateConfig & config,
+                                          AggregateStats * stats = nullptr);
+
+/**
+ * List the log files below root (or root itself, if a file), sorted,
+ * skipping hidden files and directories.
+ * @return: false if root could not be read.
+ */
+bool ListLogFiles(const std::string & root, std::vector<std::string> & files);
+
+} // namespace qassert_meta
+
+#endif //QASSERT_META_QASSERT_META_AGGREGATOR_H
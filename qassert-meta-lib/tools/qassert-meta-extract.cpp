@@ -0,0 +1,235 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * Extracts the asserts of a QP/C or QP/C++ source tree, listing each
+ * module/id pair with its file:line and function.
+ *
+ * usage: qassert-meta-extract [--threads N] [--quiet] [--check] [--cache <path>]
+ *                             [--table <output.c> [--name array_name]]
+ *                             [--locations <output.c>] <source root>
+ *
+ *  --cache:  keep scans in a persistent cache, so only new or changed files
+ *            are scanned, and an existing --table is only rewritten if the
+ *            asserts changed. Reports how each file was obtained, with timings.
+ *  --check:  compare with the built-in table, reporting table ids no longer
+ *            in the source (stale, exit code 1) and undocumented asserts.
+ *  --table:  write the extracted pairs as a C table, keeping built-in
+ *            descriptions. The default name, m_qassert_meta_items, makes a
+ *            data table for qassert_meta_add_library.
+ *  --locations: write the first file:line and function of each pair, relative
+ *            to the source root, as the LOCATIONS of qassert_meta_add_library.
+ */
+
+#include "qassert-meta-extractor.h"
+extern "C" {
+#include "qassert-meta-private.h"
+}
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <unistd.h>
+
+using namespace qassert_meta;
+
+namespace {
+
+int Usage(const char * program)
+{
+    fprintf(stderr, "usage: %s [--threads N] [--quiet] [--check] [--cache <path>] "
+                    "[--table <output.c> [--name array_name]] [--locations <output.c>] <source root>\n", program);
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    bool quiet = false;
+    bool check = false;
+    const char * tablePath = nullptr;
+    const char * locationsPath = nullptr;
+    const char * cachePath = nullptr;
+    const char * name = "m_qassert_meta_items";
+    const char * root = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char * value = ((i + 1) < argc) ? argv[i + 1] : nullptr;
+        if ((0 == strcmp(argv[i], "--threads")) && value)
+        {
+            threads = static_cast<unsigned>(strtoul(value, nullptr, 10));
+            ++i;
+        }
+        else if ((0 == strcmp(argv[i], "--table")) && value)
+        {
+            tablePath = value;
+            ++i;
+        }
+        else if ((0 == strcmp(argv[i], "--locations")) && value)
+        {
+            locationsPath = value;
+            ++i;
+        }
+        else if ((0 == strcmp(argv[i], "--cache")) && value)
+        {
+            cachePath = value;
+            ++i;
+        }
+        else if ((0 == strcmp(argv[i], "--name")) && value)
+        {
+            name = value;
+            ++i;
+        }
+        else if (0 == strcmp(argv[i], "--quiet"))
+        {
+            quiet = true;
+        }
+        else if (0 == strcmp(argv[i], "--check"))
+        {
+            check = true;
+        }
+        else if ((argv[i][0] != '-') && (nullptr == root))
+        {
+            root = argv[i];
+        }
+        else
+        {
+            return Usage(argv[0]);
+        }
+    }
+    if (nullptr == root)
+    {
+        return Usage(argv[0]);
+    }
+
+    int result = 0;
+    auto start = std::chrono::steady_clock::now();
+    ExtractCache cache;
+    bool warm = (nullptr != cachePath) && cache.Load(cachePath);
+    std::chrono::duration<double, std::milli> loadTime = std::chrono::steady_clock::now() - start;
+
+    std::vector<std::string> files;
+    if (!ListSourceFiles(root, files))
+    {
+        fprintf(stderr, "unable to read %s\n", root);
+        return 1;
+    }
+
+    ExtractCacheStats cacheStats;
+    bool changed = true;
+    std::vector<FileScan> scans;
+    if (nullptr != cachePath)
+    {
+        changed = cache.Update(files, threads, &cacheStats) || !warm;
+    }
+    else
+    {
+        scans = ExtractAsserts(files, threads);
+    }
+
+    auto scanned = std::chrono::steady_clock::now();
+    if ((nullptr != cachePath) && cache.Modified() && !cache.Save(cachePath))
+    {
+        fprintf(stderr, "failed to write %s\n", cachePath);
+        result = 1;
+    }
+    std::chrono::duration<double, std::milli> saveTime = std::chrono::steady_clock::now() - scanned;
+
+    //a no change rebuild leaves existing outputs untouched, and never expands the cache
+    bool tableCurrent = (nullptr != tablePath) && !changed && (0 == access(tablePath, F_OK));
+    bool locationsCurrent = (nullptr != locationsPath) && !changed && (0 == access(locationsPath, F_OK));
+    bool needScans = !quiet || check || ((nullptr != tablePath) && !tableCurrent) ||
+                     ((nullptr != locationsPath) && !locationsCurrent);
+    if ((nullptr != cachePath) && needScans)
+    {
+        scans = cache.Scans();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    for (const FileScan & scan : scans)
+    {
+        if (!scan.ok)
+        {
+            fprintf(stderr, "%s: %s\n", scan.path.c_str(), scan.error.c_str());
+            result = 1;
+        }
+        for (const AssertSite & site : scan.sites)
+        {
+            if (!quiet)
+            {
+                printf("%s\t%d\t%s\t%s:%u\t%s\n", site.module.c_str(), site.id, site.macro.c_str(),
+                       site.file.c_str(), site.line, site.function.c_str());
+            }
+        }
+    }
+    fprintf(stderr, "scanned %zu files in %.1f ms (%u threads)\n", files.size(), elapsed.count(), threads);
+    if (nullptr != cachePath)
+    {
+        fprintf(stderr, "%s cache: %zu reused, %zu rehashed, %zu rescanned, %zu removed, %zu failed "
+                        "(load %.1f ms, save %.1f ms)%s\n",
+                warm ? "warm" : "cold", cacheStats.reused, cacheStats.rehashed, cacheStats.rescanned,
+                cacheStats.removed, cacheStats.failed, loadTime.count(), saveTime.count(),
+                changed ? "" : ", no changes");
+        result = (cacheStats.failed > 0) ? 1 : result;
+    }
+
+    if (check)
+    {
+        for (const StaleItem & stale : FindStaleItems(m_qassert_meta_items, scans))
+        {
+            printf("stale: %s:%d %s\n", stale.item->module, stale.item->id,
+                   stale.moduleFound ? "no longer in the source" : "(module not in the source)");
+            result = stale.moduleFound ? 1 : result;
+        }
+        for (const AssertSite * site : FindUndocumentedSites(m_qassert_meta_items, scans))
+        {
+            printf("undocumented: %s:%d at %s:%u\n", site->module.c_str(), site->id, site->file.c_str(), site->line);
+        }
+    }
+
+    if ((nullptr != tablePath) && !tableCurrent)
+    {
+        FILE * file = fopen(tablePath, "w");
+        bool written = (nullptr != file) && WriteExtractedTableSource(file, scans, m_qassert_meta_items, name);
+        if ((nullptr == file) || (0 != fclose(file)) || !written)
+        {
+            fprintf(stderr, "failed to write %s\n", tablePath);
+            result = 1;
+        }
+    }
+
+    if ((nullptr != locationsPath) && !locationsCurrent)
+    {
+        FILE * file = fopen(locationsPath, "w");
+        bool written = (nullptr != file) && WriteExtractedLocationsSource(file, scans, root);
+        if ((nullptr == file) || (0 != fclose(file)) || !written)
+        {
+            fprintf(stderr, "failed to write %s\n", locationsPath);
+            result = 1;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,1192 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "qassert-meta-extractor.h"
+#include "qassert-meta-host-files.h"
+#include "qassert-meta-string-literal.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <map>
+#include <set>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+
+namespace qassert_meta {
+
+namespace {
+
+const char * const ASSERT_MACROS[] = {
+    "Q_ASSERT_ID", "Q_REQUIRE_ID", "Q_ENSURE_ID", "Q_INVARIANT_ID", "Q_ERROR_ID",
+    //QP 7.3 and later, for asserts inside critical sections
+    "Q_ASSERT_INCRIT", "Q_REQUIRE_INCRIT", "Q_ENSURE_INCRIT", "Q_INVARIANT_INCRIT", "Q_ERROR_INCRIT",
+};
+
+const char * const SOURCE_EXTENSIONS[] = {".c", ".h", ".cpp", ".hpp", ".cc", ".hh", ".cxx"};
+
+constexpr uint32_t CACHE_MAGIC = 0x584D4151u; //"QAMX"
+constexpr uint32_t CACHE_VERSION = 1;
+
+//files modified this close to a scan are rehashed by the next one (FAT: 2 s granularity)
+constexpr int64_t RACY_WINDOW_NS = 2000000000;
+
+bool IsIdentifierStart(char c)
+{
+    return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) || (c == '_');
+}
+
+bool IsIdentifierChar(char c)
+{
+    return IsIdentifierStart(c) || ((c >= '0') && (c <= '9'));
+}
+
+bool IsAssertMacro(const std::string & identifier)
+{
+    for (const char * macro : ASSERT_MACROS)
+    {
+        if (identifier == macro)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string BaseName(const std::string & path)
+{
+    size_t slash = path.find_last_of('/');
+    return (slash == std::string::npos) ? path : path.substr(slash + 1);
+}
+
+/**
+ * A single pass lexer over one source file. Braces are classified to find
+ * the enclosing function of each assert: namespace, extern "C" and class
+ * bodies are transparent, a brace after a parameter list at declaration
+ * scope opens a function, anything else opens an ordinary block.
+ */
+class Scanner {
+public:
+    Scanner(const char * text, size_t size, const std::string & file, std::vector<AssertSite> & sites) :
+        m_text(text), m_size(size), m_file(file), m_sites(sites)
+    {
+    }
+
+    void Run()
+    {
+        bool lineStart = true;
+        while (m_pos < m_size)
+        {
+            char c = m_text[m_pos];
+            if ((c == '\n') || (c == ' ') || (c == '\t') || (c == '\r') || (c == '\f') || (c == '\v'))
+            {
+                lineStart = lineStart || (c == '\n');
+                Advance();
+                continue;
+            }
+
+            if ((c == '#') && lineStart)
+            {
+                SkipDirective();
+                continue;
+            }
+            lineStart = false;
+
+            if ((c == '/') && (Peek(1) == '/'))
+            {
+                SkipLineComment();
+            }
+            else if ((c == '/') && (Peek(1) == '*'))
+            {
+                SkipBlockComment();
+            }
+            else if ((c == '"') || (c == '\''))
+            {
+                std::string literal;
+                ReadQuoted(literal);
+                if ((c == '"') && m_sawExtern && (literal == "C"))
+                {
+                    m_sawExternC = true;
+                }
+            }
+            else if ((c >= '0') && (c <= '9'))
+            {
+                SkipNumber();
+            }
+            else if (IsIdentifierStart(c))
+            {
+                unsigned line = m_line;
+                OnIdentifier(ReadIdentifier(), line);
+            }
+            else
+            {
+                OnPunctuation(c);
+            }
+        }
+    }
+
+private:
+    enum class Brace {
+        Transparent,
+        Function,
+        Block
+    };
+
+    char Peek(size_t ahead) const
+    {
+        return ((m_pos + ahead) < m_size) ? m_text[m_pos + ahead] : '\0';
+    }
+
+    void Advance()
+    {
+        if (m_text[m_pos] == '\n')
+        {
+            ++m_line;
+        }
+        ++m_pos;
+    }
+
+    void SkipLineComment()
+    {
+        while ((m_pos < m_size) && (m_text[m_pos] != '\n'))
+        {
+            Advance();
+        }
+    }
+
+    void SkipBlockComment()
+    {
+        Advance();
+        Advance();
+        while ((m_pos < m_size) && !((m_text[m_pos] == '*') && (Peek(1) == '/')))
+        {
+            Advance();
+        }
+        if (m_pos < m_size)
+        {
+            Advance();
+            Advance();
+        }
+    }
+
+    //up to the end of the line, following continuations and block comments
+    void SkipDirective()
+    {
+        while ((m_pos < m_size) && (m_text[m_pos] != '\n'))
+        {
+            if ((m_text[m_pos] == '\\') && (Peek(1) == '\n'))
+            {
+                Advance();
+            }
+            else if ((m_text[m_pos] == '/') && (Peek(1) == '*'))
+            {
+                SkipBlockComment();
+                continue;
+            }
+            else if ((m_text[m_pos] == '/') && (Peek(1) == '/'))
+            {
+                SkipLineComment();
+                continue;
+            }
+            Advance();
+        }
+    }
+
+    //a string or character literal, contents (escapes kept) to value
+    void ReadQuoted(std::string & value)
+    {
+        const char quote = m_text[m_pos];
+        Advance();
+        while ((m_pos < m_size) && (m_text[m_pos] != quote) && (m_text[m_pos] != '\n'))
+        {
+            if ((m_text[m_pos] == '\\') && ((m_pos + 1) < m_size))
+            {
+                value += m_text[m_pos];
+                Advance();
+            }
+            value += m_text[m_pos];
+            Advance();
+        }
+        if (m_pos < m_size)
+        {
+            Advance();
+        }
+    }
+
+    //a preprocessing number, including suffixes and C++14 digit separators
+    std::string ReadNumber()
+    {
+        size_t start = m_pos;
+        while ((m_pos < m_size) &&
+               (IsIdentifierChar(m_text[m_pos]) || (m_text[m_pos] == '.') || (m_text[m_pos] == '\'') ||
+                (((m_text[m_pos] == '+') || (m_text[m_pos] == '-')) &&
+                 ((m_text[m_pos - 1] == 'e') || (m_text[m_pos - 1] == 'E') ||
+                  (m_text[m_pos - 1] == 'p') || (m_text[m_pos - 1] == 'P')))))
+        {
+            Advance();
+        }
+        return std::string(m_text + start, m_pos - start);
+    }
+
+    void SkipNumber()
+    {
+        (void)ReadNumber();
+    }
+
+    std::string ReadIdentifier()
+    {
+        size_t start = m_pos;
+        while ((m_pos < m_size) && IsIdentifierChar(m_text[m_pos]))
+        {
+            Advance();
+        }
+        return std::string(m_text + start, m_pos - start);
+    }
+
+    void SkipSpaceAndComments()
+    {
+        while (m_pos < m_size)
+        {
+            char c = m_text[m_pos];
+            if ((c == ' ') || (c == '\t') || (c == '\n') || (c == '\r') || ((c == '\\') && (Peek(1) == '\n')))
+            {
+                Advance();
+            }
+            else if ((c == '/') && (Peek(1) == '/'))
+            {
+                SkipLineComment();
+            }
+            else if ((c == '/') && (Peek(1) == '*'))
+            {
+                SkipBlockComment();
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+    /**
+     * Look ahead (without consuming) for '(' followed by an integer literal,
+     * optionally parenthesized, as the first macro argument.
+     */
+    bool PeekIntegerArgument(int & id)
+    {
+        const size_t pos = m_pos;
+        const unsigned line = m_line;
+        bool found = false;
+
+        SkipSpaceAndComments();
+        if (Peek(0) == '(')
+        {
+            Advance();
+            size_t parens = 0;
+            SkipSpaceAndComments();
+            while (Peek(0) == '(')
+            {
+                ++parens;
+                Advance();
+                SkipSpaceAndComments();
+            }
+
+            bool negative = false;
+            if (Peek(0) == '-')
+            {
+                negative = true;
+                Advance();
+                SkipSpaceAndComments();
+            }
+
+            if ((Peek(0) >= '0') && (Peek(0) <= '9'))
+            {
+                std::string number = ReadNumber();
+                number.erase(std::remove(number.begin(), number.end(), '\''), number.end());
+                char * end = nullptr;
+                errno = 0;
+                long long value = strtoll(number.c_str(), &end, 0);
+                while ((*end == 'u') || (*end == 'U') || (*end == 'l') || (*end == 'L'))
+                {
+                    ++end;
+                }
+                value = negative ? -value : value;
+                SkipSpaceAndComments();
+                while ((parens > 0) && (Peek(0) == ')'))
+                {
+                    --parens;
+                    Advance();
+                    SkipSpaceAndComments();
+                }
+                found = (*end == '\0') && (errno == 0) && (parens == 0) &&
+                        ((Peek(0) == ',') || (Peek(0) == ')')) &&
+                        (value >= INT32_MIN) && (value <= INT32_MAX);
+                id = static_cast<int>(value);
+            }
+        }
+
+        m_pos = pos;
+        m_line = line;
+        return found;
+    }
+
+    //look ahead (without consuming) for '(' followed by a string literal
+    bool PeekStringArgument(std::string & value)
+    {
+        const size_t pos = m_pos;
+        const unsigned line = m_line;
+        bool found = false;
+
+        SkipSpaceAndComments();
+        if (Peek(0) == '(')
+        {
+            Advance();
+            SkipSpaceAndComments();
+            if (Peek(0) == '"')
+            {
+                ReadQuoted(value);
+                found = true;
+            }
+        }
+
+        m_pos = pos;
+        m_line = line;
+        return found;
+    }
+
+    bool AtDeclarationScope() const
+    {
+        return 0 == m_openBlocks;
+    }
+
+    void ResetDeclaration()
+    {
+        m_name.clear();
+        m_candidate.clear();
+        m_afterScope = false;
+        m_paramsClosed = false;
+        m_inInitializers = false;
+        m_sawNamespace = false;
+        m_sawExtern = false;
+        m_sawExternC = false;
+        m_sawClass = false;
+    }
+
+    void OnIdentifier(const std::string & identifier, unsigned line)
+    {
+        if (IsAssertMacro(identifier))
+        {
+            int id = 0;
+            if (PeekIntegerArgument(id))
+            {
+                AssertSite site;
+                site.module = m_module;
+                site.id = id;
+                site.macro = identifier;
+                site.file = m_file;
+                site.line = line;
+                site.function = m_function;
+                m_sites.push_back(std::move(site));
+            }
+        }
+        else if (identifier == "Q_DEFINE_THIS_MODULE")
+        {
+            std::string module;
+            if (PeekStringArgument(module))
+            {
+                m_module = module;
+            }
+        }
+        else if (identifier == "Q_DEFINE_THIS_FILE")
+        {
+            m_module = BaseName(m_file); //QP uses __FILE__, as compiled
+        }
+
+        if (!AtDeclarationScope())
+        {
+            return;
+        }
+
+        if (identifier == "namespace")
+        {
+            m_sawNamespace = true;
+        }
+        else if (identifier == "extern")
+        {
+            m_sawExtern = true;
+        }
+        else if ((identifier == "class") || (identifier == "struct") || (identifier == "union") ||
+                 (identifier == "enum"))
+        {
+            m_sawClass = true;
+        }
+        m_name = m_afterScope ? (m_name + identifier) : identifier;
+        m_afterScope = false;
+    }
+
+    void OnPunctuation(char c)
+    {
+        const bool declarationScope = AtDeclarationScope();
+        if ((c == ':') && (Peek(1) == ':'))
+        {
+            Advance();
+            Advance();
+            if (declarationScope && (m_parens == 0))
+            {
+                m_name += "::";
+                m_afterScope = true;
+            }
+            return;
+        }
+        Advance();
+
+        if (c == '{')
+        {
+            Brace brace = Brace::Block;
+            if (declarationScope && m_paramsClosed && !m_candidate.empty())
+            {
+                brace = Brace::Function;
+                m_function = m_candidate;
+            }
+            else if (declarationScope && (m_sawNamespace || m_sawExternC || m_sawClass))
+            {
+                brace = Brace::Transparent;
+            }
+
+            m_braces.push_back(brace);
+            m_openBlocks += (brace == Brace::Transparent) ? 0 : 1;
+            m_parens = 0;
+            ResetDeclaration();
+        }
+        else if (c == '}')
+        {
+            if (!m_braces.empty())
+            {
+                Brace brace = m_braces.back();
+                m_braces.pop_back();
+                m_openBlocks -= (brace == Brace::Transparent) ? 0 : 1;
+                if (brace == Brace::Function)
+                {
+                    m_function.clear();
+                }
+            }
+            ResetDeclaration();
+        }
+        else if (!declarationScope)
+        {
+            return;
+        }
+        else if (c == '(')
+        {
+            //a constructor's initializers follow its parameter list
+            if ((m_parens == 0) && !m_inInitializers)
+            {
+                m_candidate = (m_name == "~") ? std::string() : m_name;
+                m_paramsClosed = false;
+            }
+            ++m_parens;
+        }
+        else if (c == ')')
+        {
+            if ((m_parens > 0) && (--m_parens == 0))
+            {
+                m_paramsClosed = true;
+            }
+        }
+        else if ((c == ';') || (c == '='))
+        {
+            m_parens = 0;
+            ResetDeclaration();
+        }
+        else if ((c == ':') && m_paramsClosed && (m_parens == 0))
+        {
+            m_inInitializers = true;
+        }
+        else if (c == '~')
+        {
+            m_name = m_afterScope ? (m_name + "~") : "~";
+            m_afterScope = true;
+        }
+    }
+
+    const char * m_text;
+    size_t m_size;
+    size_t m_pos = 0;
+    unsigned m_line = 1;
+    const std::string & m_file;
+    std::vector<AssertSite> & m_sites;
+
+    std::string m_module;
+    std::string m_function;
+    std::vector<Brace> m_braces;
+    size_t m_openBlocks = 0; //non transparent braces open
+    size_t m_parens = 0;     //at declaration scope
+
+    //the declaration being read at declaration scope
+    std::string m_name;      //last (possibly qualified) name
+    std::string m_candidate; //name before the parameter list
+    bool m_afterScope = false;
+    bool m_paramsClosed = false;
+    bool m_inInitializers = false;
+    bool m_sawNamespace = false;
+    bool m_sawExtern = false;
+    bool m_sawExternC = false;
+    bool m_sawClass = false;
+};
+
+bool HasSourceExtension(const std::string & name)
+{
+    for (const char * extension : SOURCE_EXTENSIONS)
+    {
+        size_t length = strlen(extension);
+        if ((name.size() > length) && (0 == name.compare(name.size() - length, length, extension)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+typedef std::pair<std::string, int> Key;
+
+std::map<Key, const QAssertMetaItem *> KnownItems(const QAssertMetaItem * table)
+{
+    std::map<Key, const QAssertMetaItem *> known;
+    for (const QAssertMetaItem * item = table; (nullptr != item) && (nullptr != item->module); ++item)
+    {
+        known.insert(std::make_pair(Key(item->module, item->id), item)); //first occurrence wins
+    }
+    return known;
+}
+
+//FNV-1a, 64 bit
+uint64_t ContentHash(const char * data, size_t size)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+int64_t ModifiedNs(const struct stat & info)
+{
+#ifdef __APPLE__
+    return (static_cast<int64_t>(info.st_mtimespec.tv_sec) * 1000000000) + info.st_mtimespec.tv_nsec;
+#else
+    return (static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000) + info.st_mtim.tv_nsec;
+#endif
+}
+
+void AppendU32(std::string & out, uint32_t value)
+{
+    out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void AppendU64(std::string & out, uint64_t value)
+{
+    out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void AppendString(std::string & out, const std::string & value)
+{
+    AppendU32(out, static_cast<uint32_t>(value.size()));
+    out += value;
+}
+
+/**
+ * Bounds checked reads of a saved cache, in host byte order.
+ * Any read past the end marks the reader failed.
+ */
+class CacheReader {
+public:
+    explicit CacheReader(const std::string & data) : m_data(data) {}
+
+    bool Ok() const { return m_ok; }
+    bool AtEnd() const { return m_pos == m_data.size(); }
+
+    uint32_t U32()
+    {
+        uint32_t value = 0;
+        Read(&value, sizeof(value));
+        return value;
+    }
+
+    uint64_t U64()
+    {
+        uint64_t value = 0;
+        Read(&value, sizeof(value));
+        return value;
+    }
+
+    bool Fits(uint64_t size) const
+    {
+        return m_ok && (size <= (m_data.size() - m_pos));
+    }
+
+    void Read(void * value, size_t size)
+    {
+        if (!Fits(size))
+        {
+            m_ok = false;
+            return;
+        }
+        memcpy(value, m_data.data() + m_pos, size);
+        m_pos += size;
+    }
+
+    std::string String()
+    {
+        uint32_t length = U32();
+        if (!m_ok || (length > (m_data.size() - m_pos)))
+        {
+            m_ok = false;
+            return std::string();
+        }
+        std::string value = m_data.substr(m_pos, length);
+        m_pos += length;
+        return value;
+    }
+
+private:
+    const std::string & m_data;
+    size_t m_pos = 0;
+    bool m_ok = true;
+};
+
+} // namespace
+
+void ScanSource(const char * text, size_t size, const std::string & file, std::vector<AssertSite> & sites)
+{
+    Scanner(text, size, file, sites).Run();
+}
+
+FileScan ScanFile(const std::string & path)
+{
+    FileScan scan;
+    scan.path = path;
+
+    MappedFile file;
+    if (!file.Open(path))
+    {
+        scan.error = file.Error();
+        return scan;
+    }
+    ScanSource(file.Data(), file.Size(), path, scan.sites);
+    scan.ok = true;
+    return scan;
+}
+
+bool ListSourceFiles(const std::string & root, std::vector<std::string> & files)
+{
+    files.clear();
+    struct stat info;
+    if ((0 == stat(root.c_str(), &info)) && S_ISREG(info.st_mode))
+    {
+        files.push_back(root);
+        return true;
+    }
+
+    if (!ListDirectory(root, files, HasSourceExtension))
+    {
+        return false;
+    }
+    std::sort(files.begin(), files.end());
+    return true;
+}
+
+std::vector<FileScan> ExtractAsserts(const std::vector<std::string> & files, unsigned threads)
+{
+    std::vector<FileScan> scans(files.size());
+    ParallelFor(files.size(), threads, [&files, &scans](size_t i) {
+        scans[i] = ScanFile(files[i]);
+    });
+    return scans;
+}
+
+bool ExtractCache::Load(const std::string & path)
+{
+    m_strings.clear();
+    m_stringIndexes.clear();
+    m_entries.clear();
+    m_listed.clear();
+    m_failures.clear();
+    m_modified = false;
+
+    FILE * file = fopen(path.c_str(), "rb");
+    if (nullptr == file)
+    {
+        return false;
+    }
+
+    std::string data;
+    struct stat info;
+    if (0 == fstat(fileno(file), &info))
+    {
+        data.resize(static_cast<size_t>(info.st_size));
+    }
+    bool readOk = !data.empty() && (data.size() == fread(&data[0], 1, data.size(), file));
+    fclose(file);
+
+    CacheReader reader(data);
+    if (!readOk || (reader.U32() != CACHE_MAGIC) || (reader.U32() != CACHE_VERSION))
+    {
+        return false;
+    }
+
+    uint32_t stringCount = reader.U32();
+    for (uint32_t i = 0; reader.Ok() && (i < stringCount); ++i)
+    {
+        m_strings.push_back(reader.String());
+    }
+
+    uint32_t entryCount = reader.U32();
+    bool valid = reader.Ok();
+    for (uint32_t i = 0; valid && (i < entryCount); ++i)
+    {
+        std::string entryPath = reader.String();
+        Entry & entry = m_entries[entryPath];
+        entry.size = reader.U64();
+        entry.modifiedNs = static_cast<int64_t>(reader.U64());
+        entry.hash = reader.U64();
+        entry.racy = (0 != reader.U32());
+        uint32_t siteCount = reader.U32();
+        valid = reader.Ok() && reader.Fits(static_cast<uint64_t>(siteCount) * sizeof(Site));
+        if (valid)
+        {
+            entry.sites.resize(siteCount);
+            reader.Read(entry.sites.data(), siteCount * sizeof(Site));
+        }
+        for (const Site & site : entry.sites)
+        {
+            valid = valid && (site.module < stringCount) && (site.macro < stringCount) &&
+                    (site.function < stringCount);
+        }
+    }
+
+    if (!valid || !reader.Ok() || !reader.AtEnd())
+    {
+        m_strings.clear();
+        m_entries.clear();
+        return false;
+    }
+    return true;
+}
+
+bool ExtractCache::Save(const std::string & path) const
+{
+    //only referenced strings are saved, so replaced scans do not accumulate
+    std::vector<uint32_t> remap(m_strings.size(), UINT32_MAX);
+    std::vector<uint32_t> saved;
+    auto Remap = [&remap, &saved](uint32_t index) {
+        if (remap[index] == UINT32_MAX)
+        {
+            remap[index] = static_cast<uint32_t>(saved.size());
+            saved.push_back(index);
+        }
+        return remap[index];
+    };
+
+    std::string entries;
+    for (const auto & cached : m_entries)
+    {
+        const Entry & entry = cached.second;
+        AppendString(entries, cached.first);
+        AppendU64(entries, entry.size);
+        AppendU64(entries, static_cast<uint64_t>(entry.modifiedNs));
+        AppendU64(entries, entry.hash);
+        AppendU32(entries, entry.racy ? 1u : 0u);
+        AppendU32(entries, static_cast<uint32_t>(entry.sites.size()));
+        for (Site site : entry.sites)
+        {
+            site.module = Remap(site.module);
+            site.macro = Remap(site.macro);
+            site.function = Remap(site.function);
+            entries.append(reinterpret_cast<const char *>(&site), sizeof(site));
+        }
+    }
+
+    std::string data;
+    AppendU32(data, CACHE_MAGIC);
+    AppendU32(data, CACHE_VERSION);
+    AppendU32(data, static_cast<uint32_t>(saved.size()));
+    for (uint32_t index : saved)
+    {
+        AppendString(data, m_strings[index]);
+    }
+    AppendU32(data, static_cast<uint32_t>(m_entries.size()));
+    data += entries;
+
+    //readers never see a partially written cache
+    std::string temporary = path + ".tmp";
+    FILE * file = fopen(temporary.c_str(), "wb");
+    if (nullptr == file)
+    {
+        return false;
+    }
+    bool written = (data.size() == fwrite(data.data(), 1, data.size(), file));
+    written = (0 == fclose(file)) && written;
+    if (!written || (0 != rename(temporary.c_str(), path.c_str())))
+    {
+        (void)remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+uint32_t ExtractCache::Intern(const std::string & value)
+{
+    if (m_stringIndexes.size() != m_strings.size())
+    {
+        m_stringIndexes.clear();
+        for (uint32_t i = 0; i < m_strings.size(); ++i)
+        {
+            m_stringIndexes.insert(std::make_pair(m_strings[i], i));
+        }
+    }
+
+    auto found = m_stringIndexes.find(value);
+    if (found != m_stringIndexes.end())
+    {
+        return found->second;
+    }
+    m_strings.push_back(value);
+    m_stringIndexes.insert(std::make_pair(value, static_cast<uint32_t>(m_strings.size() - 1)));
+    return static_cast<uint32_t>(m_strings.size() - 1);
+}
+
+bool ExtractCache::Update(const std::vector<std::string> & files, unsigned threads, ExtractCacheStats * stats)
+{
+    enum class Source : uint8_t {
+        Failed,
+        Reused,
+        Rehashed,
+        Rescanned
+    };
+
+    struct Result {
+        Source source = Source::Failed;
+        Entry * cached = nullptr;
+        uint64_t size = 0;
+        int64_t modifiedNs = 0;
+        uint64_t hash = 0;
+        std::vector<AssertSite> sites; //if rescanned
+        std::string error;
+    };
+
+    const int64_t startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    std::vector<Result> results(files.size());
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        auto cached = m_entries.find(files[i]);
+        results[i].cached = (cached != m_entries.end()) ? &cached->second : nullptr;
+    }
+
+    //workers only read the cache, each writing its own result
+    ParallelFor(files.size(), threads, [&files, &results](size_t i) {
+        Result & result = results[i];
+        struct stat info;
+        if (0 != stat(files[i].c_str(), &info))
+        {
+            result.error = strerror(errno);
+            return;
+        }
+        result.size = static_cast<uint64_t>(info.st_size);
+        result.modifiedNs = ModifiedNs(info);
+
+        const Entry * cached = result.cached;
+        if ((nullptr != cached) && !cached->racy && (cached->size == result.size) &&
+            (cached->modifiedNs == result.modifiedNs))
+        {
+            result.source = Source::Reused;
+            return;
+        }
+
+        MappedFile file;
+        if (!file.Open(files[i]))
+        {
+            result.error = file.Error();
+            return;
+        }
+        result.size = file.Size();
+        result.hash = ContentHash(file.Data(), file.Size());
+        if ((nullptr != cached) && (cached->size == result.size) && (cached->hash == result.hash))
+        {
+            result.source = Source::Rehashed;
+            return;
+        }
+        ScanSource(file.Data(), file.Size(), files[i], result.sites);
+        result.source = Source::Rescanned;
+    });
+
+    ExtractCacheStats counts;
+    bool changed = false;
+    ++m_generation;
+    m_failures.clear();
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        Result & result = results[i];
+        if (result.source == Source::Failed)
+        {
+            m_failures[files[i]] = result.error;
+            ++counts.failed;
+            continue;
+        }
+
+        Entry & entry = (nullptr != result.cached) ? *result.cached : m_entries[files[i]];
+        entry.generation = m_generation;
+        if (result.source == Source::Reused)
+        {
+            ++counts.reused;
+            continue;
+        }
+
+        counts.rehashed += (result.source == Source::Rehashed) ? 1 : 0;
+        counts.rescanned += (result.source == Source::Rescanned) ? 1 : 0;
+        entry.size = result.size;
+        entry.modifiedNs = result.modifiedNs;
+        entry.hash = result.hash;
+        entry.racy = result.modifiedNs >= (startNs - RACY_WINDOW_NS);
+        if (result.source == Source::Rescanned)
+        {
+            entry.sites.clear();
+            for (const AssertSite & site : result.sites)
+            {
+                entry.sites.push_back(Site{Intern(site.module), site.id, Intern(site.macro), site.line,
+                                           Intern(site.function)});
+            }
+            changed = true;
+        }
+        m_modified = true;
+    }
+
+    for (auto entry = m_entries.begin(); entry != m_entries.end(); )
+    {
+        if (entry->second.generation != m_generation)
+        {
+            entry = m_entries.erase(entry);
+            ++counts.removed;
+            changed = true;
+            m_modified = true;
+        }
+        else
+        {
+            ++entry;
+        }
+    }
+
+    m_listed = files;
+    if (nullptr != stats)
+    {
+        *stats = counts;
+    }
+    return changed;
+}
+
+std::vector<FileScan> ExtractCache::Scans() const
+{
+    std::vector<FileScan> scans(m_listed.size());
+    for (size_t i = 0; i < m_listed.size(); ++i)
+    {
+        FileScan & scan = scans[i];
+        scan.path = m_listed[i];
+        auto entry = m_entries.find(scan.path);
+        if (entry == m_entries.end())
+        {
+            auto failure = m_failures.find(scan.path);
+            scan.error = (failure != m_failures.end()) ? failure->second : "not scanned";
+            continue;
+        }
+
+        scan.ok = true;
+        scan.sites.reserve(entry->second.sites.size());
+        for (const Site & site : entry->second.sites)
+        {
+            AssertSite expanded;
+            expanded.module = m_strings[site.module];
+            expanded.id = site.id;
+            expanded.macro = m_strings[site.macro];
+            expanded.file = scan.path;
+            expanded.line = site.line;
+            expanded.function = m_strings[site.function];
+            scan.sites.push_back(std::move(expanded));
+        }
+    }
+    return scans;
+}
+
+std::vector<FileScan> ExtractCache::Extract(const std::vector<std::string> & files, unsigned threads,
+                                            ExtractCacheStats * stats)
+{
+    (void)Update(files, threads, stats);
+    return Scans();
+}
+
+std::vector<StaleItem> FindStaleItems(const QAssertMetaItem * table, const std::vector<FileScan> & scans)
+{
+    std::set<Key> keys;
+    std::set<std::string> modules;
+    for (const FileScan & scan : scans)
+    {
+        for (const AssertSite & site : scan.sites)
+        {
+            keys.insert(Key(site.module, site.id));
+            modules.insert(site.module);
+        }
+    }
+
+    std::vector<StaleItem> stale;
+    for (const QAssertMetaItem * item = table; (nullptr != item) && (nullptr != item->module); ++item)
+    {
+        if (0 == keys.count(Key(item->module, item->id)))
+        {
+            stale.push_back(StaleItem{item, 0 != modules.count(item->module)});
+        }
+    }
+    return stale;
+}
+
+std::vector<const AssertSite *> FindUndocumentedSites(const QAssertMetaItem * table,
+                                                      const std::vector<FileScan> & scans)
+{
+    std::map<Key, const QAssertMetaItem *> known = KnownItems(table);
+    std::set<Key> reported;
+    std::vector<const AssertSite *> undocumented;
+    for (const FileScan & scan : scans)
+    {
+        for (const AssertSite & site : scan.sites)
+        {
+            Key key(site.module, site.id);
+            if ((0 == known.count(key)) && reported.insert(key).second)
+            {
+                undocumented.push_back(&site);
+            }
+        }
+    }
+    return undocumented;
+}
+
+bool WriteExtractedTableSource(FILE * file, const std::vector<FileScan> & scans,
+                               const QAssertMetaItem * known, const char * arrayName)
+{
+    std::map<Key, std::vector<const AssertSite *>> keys;
+    for (const FileScan & scan : scans)
+    {
+        for (const AssertSite & site : scan.sites)
+        {
+            keys[Key(site.module, site.id)].push_back(&site);
+        }
+    }
+
+    const bool dataTable = (0 == strcmp(arrayName, "m_qassert_meta_items"));
+    fprintf(file, "// Generated by qassert-meta-extract. Review before use.\n\n"
+                  "#include \"%s\"\n"
+                  "#include <stddef.h>\n\n"
+                  "%s %s[] = {\n",
+            dataTable ? "qassert-meta-private.h" : "qassert-meta.h",
+            dataTable ? "QAssertMetaInternalItem" : "const QAssertMetaItem", arrayName);
+
+    std::map<Key, const QAssertMetaItem *> knownItems = KnownItems(known);
+    for (const auto & entry : keys)
+    {
+        for (const AssertSite * site : entry.second)
+        {
+            fprintf(file, "    // %s:%u %s%s%s\n", site->file.c_str(), site->line, site->macro.c_str(),
+                    site->function.empty() ? "" : " in ", site->function.c_str());
+        }
+
+        QAssertMetaDescription description = {nullptr, nullptr, nullptr};
+        std::string brief;
+        auto knownItem = knownItems.find(entry.first);
+        if (knownItem != knownItems.end())
+        {
+            description = knownItem->second->description;
+        }
+        else
+        {
+            const AssertSite * site = entry.second.front();
+            brief = "Undocumented " + site->macro + (site->function.empty() ? "" : (" in " + site->function + "()"));
+            description.brief = brief.c_str();
+        }
+
+        fputs("    {", file);
+        QAssertMetaWriteStringLiteral(file, entry.first.first.c_str(), "NULL");
+        fprintf(file, ", %d, {", entry.first.second);
+        QAssertMetaWriteStringLiteral(file, description.brief, "NULL");
+        fputs(", ", file);
+        QAssertMetaWriteStringLiteral(file, description.tips, "NULL");
+        fputs(", ", file);
+        QAssertMetaWriteStringLiteral(file, description.url, "NULL");
+        fputs("}},\n", file);
+    }
+    fputs("    {NULL, -1, {NULL, NULL, NULL}}\n};\n", file);
+    return 0 == ferror(file);
+}
+
+bool WriteExtractedLocationsSource(FILE * file, const std::vector<FileScan> & scans, const std::string & root)
+{
+    std::map<Key, const AssertSite *> keys;
+    for (const FileScan & scan : scans)
+    {
+        for (const AssertSite & site : scan.sites)
+        {
+            keys.insert({Key(site.module, site.id), &site});
+        }
+    }
+
+    std::string prefix = root;
+    while ((prefix.size() > 1) && (prefix.back() == '/'))
+    {
+        prefix.pop_back();
+    }
+    prefix += '/';
+
+    fputs("// Generated by qassert-meta-extract. Review before use.\n\n"
+          "#include \"qassert-meta-private.h\"\n"
+          "#include <stddef.h>\n\n"
+          "const QAssertMetaLocationItem m_qassert_meta_location_items[] = {\n", file);
+    for (const auto & entry : keys)
+    {
+        const AssertSite * site = entry.second;
+        const bool below = (0 == site->file.compare(0, prefix.size(), prefix));
+        fputs("    {", file);
+        QAssertMetaWriteStringLiteral(file, entry.first.first.c_str(), "NULL");
+        fprintf(file, ", %d, {", entry.first.second);
+        QAssertMetaWriteStringLiteral(file, below ? (site->file.c_str() + prefix.size()) : site->file.c_str(), "NULL");
+        fprintf(file, ", %u, ", site->line);
+        QAssertMetaWriteStringLiteral(file, site->function.empty() ? nullptr : site->function.c_str(), "NULL");
+        fputs("}},\n", file);
+    }
+    fputs("    {NULL, -1, {NULL, 0, NULL}}\n};\n", file);
+    return 0 == ferror(file);
+}
+
+} // namespace qassert_meta
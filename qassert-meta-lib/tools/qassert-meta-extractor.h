@@ -0,0 +1,212 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_EXTRACTOR_H
+#define QASSERT_META_QASSERT_META_EXTRACTOR_H
+
+#include "qassert-meta.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace qassert_meta {
+
+/**
+ * An assert found in QP source: Q_ASSERT_ID, Q_REQUIRE_ID, Q_ENSURE_ID,
+ * Q_INVARIANT_ID, Q_ERROR_ID or their QP 7.3+ _INCRIT variants, with an
+ * integer literal id.
+ */
+struct AssertSite {
+    std::string module;   //from Q_DEFINE_THIS_MODULE, the file name for Q_DEFINE_THIS_FILE
+    int id = 0;
+    std::string macro;
+    std::string file;
+    unsigned line = 0;
+    std::string function; //enclosing function, as written (e.g. "QActive::post_"), empty at file scope
+};
+
+/**
+ * The asserts of one source file.
+ */
+struct FileScan {
+    std::string path;
+    bool ok = false;
+    std::string error;
+    std::vector<AssertSite> sites;
+};
+
+/**
+ * Scan C or C++ source text, appending the asserts found to sites.
+ * Comments, string literals and preprocessor directives are skipped.
+ */
+void ScanSource(const char * text, size_t size, const std::string & file, std::vector<AssertSite> & sites);
+
+/**
+ * Memory map and scan one file.
+ */
+FileScan ScanFile(const std::string & path);
+
+/**
+ * List the C and C++ sources (.c .h .cpp .hpp .cc .hh .cxx) below root,
+ * sorted, skipping hidden directories and not following symbolic links.
+ * @return: false if root could not be read.
+ */
+bool ListSourceFiles(const std::string & root, std::vector<std::string> & files);
+
+/**
+ * Scan files on a pool of threads.
+ * @return: one scan per file, in the order of files.
+ */
+std::vector<FileScan> ExtractAsserts(const std::vector<std::string> & files, unsigned threads);
+
+/**
+ * How ExtractCache::Extract obtained the asserts of each file.
+ */
+struct ExtractCacheStats {
+    size_t reused = 0;    //size and modification time unchanged, not read
+    size_t rehashed = 0;  //read, content hash unchanged, not scanned
+    size_t rescanned = 0; //new or changed, scanned
+    size_t removed = 0;   //cached, but no longer listed or readable
+    size_t failed = 0;    //listed, but could not be read
+};
+
+/**
+ * A persistent cache of file scans, so unchanged files are never rescanned.
+ *
+ * Entries are keyed by path and trusted while size and modification time
+ * are unchanged. Otherwise the content hash decides whether to rescan.
+ * Files modified shortly before a scan started may change again within the
+ * file system's time granularity, so are rehashed by the next scan.
+ * Sites are held compactly, as indexes into a pool of distinct strings,
+ * and only expanded to FileScans on request.
+ */
+class ExtractCache {
+public:
+    /**
+     * Replace the cache with a saved one.
+     * @return: false if missing or invalid, the cache is then empty.
+     */
+    bool Load(const std::string & path);
+
+    /**
+     * Save the cache, replacing path atomically.
+     */
+    bool Save(const std::string & path) const;
+
+    /**
+     * Bring the cache up to date with files, on a pool of threads. Entries
+     * of files not listed, or which could not be read, are removed.
+     * @return: true if the asserts of any file changed (including files
+     *          added or removed) since the previous update or load.
+     */
+    bool Update(const std::vector<std::string> & files, unsigned threads, ExtractCacheStats * stats = nullptr);
+
+    /**
+     * @return: one scan per file of the last update, in its order.
+     */
+    std::vector<FileScan> Scans() const;
+
+    /**
+     * Update, then return Scans(), as ExtractAsserts.
+     */
+    std::vector<FileScan> Extract(const std::vector<std::string> & files, unsigned threads,
+                                  ExtractCacheStats * stats = nullptr);
+
+    //true if changed since loaded or saved, so worth saving
+    bool Modified() const { return m_modified; }
+
+    size_t Size() const { return m_entries.size(); }
+
+private:
+    struct Site {
+        uint32_t module;   //m_strings indexes
+        int32_t id;
+        uint32_t macro;
+        uint32_t line;
+        uint32_t function;
+    };
+    static_assert(sizeof(Site) == 20, "sites are saved as is");
+
+    struct Entry {
+        uint64_t size = 0;
+        int64_t modifiedNs = 0;
+        uint64_t hash = 0;
+        bool racy = false;  //modified close to its scan, rehash next time
+        uint32_t generation = 0;
+        std::vector<Site> sites;
+    };
+
+    uint32_t Intern(const std::string & value);
+
+    std::vector<std::string> m_strings;
+    std::unordered_map<std::string, uint32_t> m_stringIndexes; //built on first use
+    std::unordered_map<std::string, Entry> m_entries;
+    std::vector<std::string> m_listed;                       //files of the last update
+    std::unordered_map<std::string, std::string> m_failures; //path to error, of the last update
+    uint32_t m_generation = 0;
+    bool m_modified = false;
+};
+
+/**
+ * A table item whose id was not found in the scanned source.
+ */
+struct StaleItem {
+    const QAssertMetaItem * item;
+    bool moduleFound; //false: the module itself was not in the scanned source
+};
+
+/**
+ * @param table: terminated by an item with a NULL module.
+ * @return: the table items not found in the scans, in table order.
+ */
+std::vector<StaleItem> FindStaleItems(const QAssertMetaItem * table, const std::vector<FileScan> & scans);
+
+/**
+ * @return: the first site of each module/id pair not described by table, in scan order.
+ */
+std::vector<const AssertSite *> FindUndocumentedSites(const QAssertMetaItem * table,
+                                                      const std::vector<FileScan> & scans);
+
+/**
+ * Write the extracted module/id pairs as a C table, sorted by module and id,
+ * each preceded by comments giving its source locations. Descriptions are
+ * copied from known (may be NULL) where present, otherwise the brief names
+ * the macro and function. Named m_qassert_meta_items, the output is a data
+ * table for qassert_meta_add_library, otherwise a table for registration.
+ * @return: true if completely written.
+ */
+bool WriteExtractedTableSource(FILE * file, const std::vector<FileScan> & scans,
+                               const QAssertMetaItem * known, const char * arrayName);
+
+/**
+ * Write the first source location of each extracted module/id pair as the
+ * m_qassert_meta_location_items table, the LOCATIONS of qassert_meta_add_library.
+ * Paths are made relative to root where they are below it.
+ * @return: true if completely written.
+ */
+bool WriteExtractedLocationsSource(FILE * file, const std::vector<FileScan> & scans, const std::string & root);
+
+} // namespace qassert_meta
+
+#endif //QASSERT_META_QASSERT_META_EXTRACTOR_H
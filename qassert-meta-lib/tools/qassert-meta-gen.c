@@ -0,0 +1,881 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * Build time generator of the qassert-meta-lib derived data.
+ *
+ * Linked with the same QP/C or QP/C++ data table as the library (and its
+ * source locations, if any), and run
+ * on the build host to write C sources describing that table, so the
+ * library never builds these structures at runtime. Also writes the table
+ * as constexpr C++ data for qassert-meta.hpp.
+ *
+ * usage: qassert-meta-gen <output directory>
+ */
+
+#include "qassert-meta-private.h"
+#include "qassert-meta-search-private.h"
+#include "qassert-meta-fuzzy-private.h"
+#include "qassert-meta-serialize-private.h"
+#include "qassert-meta-string-literal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char * const GENERATED_BANNER =
+    "// Generated by qassert-meta-gen from the QASSERT meta data table. Do not edit.\n\n";
+
+static size_t CountItems(void)
+{
+    size_t count = 0;
+    while (m_qassert_meta_items[count].module != NULL)
+    {
+        ++count;
+    }
+    return count;
+}
+
+static int CompareModuleNames(const void * a, const void * b)
+{
+    return strcmp(*(const char * const *)a, *(const char * const *)b);
+}
+
+/**
+ * @return: the distinct module names of the table sorted by strcmp, or NULL.
+ */
+static const char ** CollectModules(size_t * count)
+{
+    size_t itemCount = CountItems();
+    const char ** modules = malloc((itemCount + 1) * sizeof(const char *));
+    if (NULL == modules)
+    {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < itemCount; ++i)
+    {
+        modules[i] = m_qassert_meta_items[i].module;
+    }
+    qsort(modules, itemCount, sizeof(const char *), CompareModuleNames);
+
+    size_t unique = 0;
+    for (size_t i = 0; i < itemCount; ++i)
+    {
+        if ((unique == 0) || (0 != strcmp(modules[unique - 1], modules[i])))
+        {
+            modules[unique++] = modules[i];
+        }
+    }
+    *count = unique;
+    return modules;
+}
+
+static FILE * OpenOutput(const char * directory, const char * name)
+{
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/%s", directory, name);
+    FILE * file = fopen(path, "w");
+    if (NULL == file)
+    {
+        fprintf(stderr, "qassert-meta-gen: unable to write %s\n", path);
+        return NULL;
+    }
+    fputs(GENERATED_BANNER, file);
+    return file;
+}
+
+static bool CloseOutput(FILE * file)
+{
+    bool ok = (0 == ferror(file));
+    return (0 == fclose(file)) && ok;
+}
+
+// ---------------------------------------------------------------------
+// qassert-meta-generated.h
+
+static bool GenerateHeader(const char * directory)
+{
+    FILE * file = OpenOutput(directory, "qassert-meta-generated.h");
+    if (NULL == file)
+    {
+        return false;
+    }
+
+    size_t moduleCount = 0;
+    const char ** modules = CollectModules(&moduleCount);
+    free(modules);
+
+    fprintf(file,
+            "#ifndef QASSERT_META_QASSERT_META_GENERATED_H\n"
+            "#define QASSERT_META_QASSERT_META_GENERATED_H\n\n"
+            "//number of items in m_qassert_meta_items, excluding the terminator\n"
+            "#define QASSERT_META_BUILTIN_ITEM_COUNT %zu\n\n"
+            "//number of distinct modules in m_qassert_meta_items\n"
+            "#define QASSERT_META_BUILTIN_MODULE_COUNT %zu\n\n"
+            "#endif //QASSERT_META_QASSERT_META_GENERATED_H\n",
+            CountItems(), moduleCount);
+    return (NULL != modules) && CloseOutput(file);
+}
+
+// ---------------------------------------------------------------------
+// qassert-meta-search-index.c
+
+typedef struct {
+    char token[QASSERT_META_SEARCH_MAX_TOKEN + 1];
+    size_t item;
+    unsigned weight;
+} Occurrence;
+
+typedef struct {
+    Occurrence * items;
+    size_t count;
+    size_t capacity;
+} OccurrenceList;
+
+static bool AddOccurrences(OccurrenceList * list, const char * text, size_t item, unsigned weight)
+{
+    if (NULL == text)
+    {
+        return true;
+    }
+
+    Occurrence occurrence;
+    const char * cursor = text;
+    while (QAssertMetaPrivateNextToken(&cursor, occurrence.token) != 0)
+    {
+        if (list->count == list->capacity)
+        {
+            size_t capacity = (list->capacity == 0) ? 1024 : (list->capacity * 2);
+            Occurrence * items = realloc(list->items, capacity * sizeof(Occurrence));
+            if (NULL == items)
+            {
+                return false;
+            }
+            list->items = items;
+            list->capacity = capacity;
+        }
+
+        occurrence.item = item;
+        occurrence.weight = weight;
+        list->items[list->count++] = occurrence;
+    }
+    return true;
+}
+
+static int CompareOccurrences(const void * a, const void * b)
+{
+    const Occurrence * lhs = a;
+    const Occurrence * rhs = b;
+    int result = strcmp(lhs->token, rhs->token);
+    if (result == 0)
+    {
+        result = (lhs->item > rhs->item) - (lhs->item < rhs->item);
+    }
+    return result;
+}
+
+static bool GenerateSearchIndex(const char * directory)
+{
+    OccurrenceList list = {NULL, 0, 0};
+    bool ok = true;
+    for (size_t i = 0; ok && (m_qassert_meta_items[i].module != NULL); ++i)
+    {
+        const QAssertMetaDescription * description = &m_qassert_meta_items[i].description;
+        ok = AddOccurrences(&list, description->brief, i, QASSERT_META_SEARCH_BRIEF_WEIGHT) &&
+             AddOccurrences(&list, description->tips, i, QASSERT_META_SEARCH_TIPS_WEIGHT);
+    }
+
+    FILE * file = ok ? OpenOutput(directory, "qassert-meta-search-index.c") : NULL;
+    if (NULL == file)
+    {
+        free(list.items);
+        return false;
+    }
+
+    if (list.count > 0)
+    {
+        qsort(list.items, list.count, sizeof(Occurrence), CompareOccurrences);
+    }
+
+    fputs("#include \"qassert-meta-search-private.h\"\n\n"
+          "const QAssertMetaSearchPosting m_qassert_meta_search_postings[] = {\n", file);
+
+    //merge occurrences of a token in the same item into one posting
+    size_t postingCount = 0;
+    for (size_t i = 0; i < list.count; )
+    {
+        size_t next = i;
+        unsigned weight = 0;
+        while ((next < list.count) && (list.items[next].item == list.items[i].item) &&
+               (0 == strcmp(list.items[next].token, list.items[i].token)))
+        {
+            weight += list.items[next].weight;
+            ++next;
+        }
+        fprintf(file, "    {%zu, %u}, //%s\n", list.items[i].item, (weight > 255) ? 255 : weight, list.items[i].token);
+        ++postingCount;
+        i = next;
+    }
+    if (postingCount == 0)
+    {
+        fputs("    {0, 0}\n", file);
+    }
+
+    fputs("};\n\n"
+          "const QAssertMetaSearchToken m_qassert_meta_search_tokens[] = {\n", file);
+
+    size_t tokenCount = 0;
+    size_t firstPosting = 0;
+    for (size_t i = 0; i < list.count; )
+    {
+        size_t next = i;
+        size_t postings = 0;
+        while ((next < list.count) && (0 == strcmp(list.items[next].token, list.items[i].token)))
+        {
+            if ((next == i) || (list.items[next].item != list.items[next - 1].item))
+            {
+                ++postings;
+            }
+            ++next;
+        }
+        fputs("    {", file);
+        QAssertMetaWriteStringLiteral(file, list.items[i].token, "NULL");
+        fprintf(file, ", %zu, %zu},\n", firstPosting, postings);
+        firstPosting += postings;
+        ++tokenCount;
+        i = next;
+    }
+    if (tokenCount == 0)
+    {
+        fputs("    {\"\", 0, 0}\n", file);
+    }
+
+    fprintf(file, "};\n\nconst size_t m_qassert_meta_search_token_count = %zu;\n", tokenCount);
+    free(list.items);
+
+    if (postingCount > UINT16_MAX)
+    {
+        fprintf(stderr, "qassert-meta-gen: too many search postings (%zu)\n", postingCount);
+        ok = false;
+    }
+    return CloseOutput(file) && ok;
+}
+
+// ---------------------------------------------------------------------
+// qassert-meta-fuzzy-index.c
+
+typedef struct {
+    char gram[2];
+    size_t module;
+} GramOccurrence;
+
+static int CompareItemIds(const void * a, const void * b)
+{
+    int lhs = m_qassert_meta_items[*(const uint16_t *)a].id;
+    int rhs = m_qassert_meta_items[*(const uint16_t *)b].id;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static int CompareGramOccurrences(const void * a, const void * b)
+{
+    const GramOccurrence * lhs = a;
+    const GramOccurrence * rhs = b;
+    int result = memcmp(lhs->gram, rhs->gram, 2);
+    if (result == 0)
+    {
+        result = (lhs->module > rhs->module) - (lhs->module < rhs->module);
+    }
+    return result;
+}
+
+static void WriteGramChar(FILE * file, char c)
+{
+    if ((c == '\'') || (c == '\\'))
+    {
+        fprintf(file, "'\\%c'", c);
+    }
+    else if ((c >= ' ') && (c <= '~'))
+    {
+        fprintf(file, "'%c'", c);
+    }
+    else
+    {
+        fprintf(file, "'\\x%02x'", (unsigned)(unsigned char)c);
+    }
+}
+
+static bool GenerateFuzzyIndex(const char * directory)
+{
+    size_t itemCount = CountItems();
+    size_t moduleCount = 0;
+    const char ** modules = CollectModules(&moduleCount);
+    uint16_t * moduleItems = malloc((itemCount + 1) * sizeof(uint16_t));
+    size_t gramCapacity = 1;
+    for (size_t m = 0; (NULL != modules) && (m < moduleCount); ++m)
+    {
+        gramCapacity += strlen(modules[m]) + 1;
+    }
+    GramOccurrence * grams = malloc(gramCapacity * sizeof(GramOccurrence));
+    FILE * file = ((NULL != modules) && (NULL != moduleItems) && (NULL != grams)) ?
+                  OpenOutput(directory, "qassert-meta-fuzzy-index.c") : NULL;
+    if (NULL == file)
+    {
+        free(modules);
+        free(moduleItems);
+        free(grams);
+        return false;
+    }
+
+    fputs("#include \"qassert-meta-fuzzy-private.h\"\n\n"
+          "const QAssertMetaFuzzyModule m_qassert_meta_fuzzy_modules[] = {\n", file);
+
+    size_t firstItem = 0;
+    size_t gramCount = 0;
+    for (size_t m = 0; m < moduleCount; ++m)
+    {
+        size_t moduleItemCount = 0;
+        for (size_t i = 0; i < itemCount; ++i)
+        {
+            if (0 == strcmp(m_qassert_meta_items[i].module, modules[m]))
+            {
+                moduleItems[firstItem + moduleItemCount++] = (uint16_t)i;
+            }
+        }
+        qsort(&moduleItems[firstItem], moduleItemCount, sizeof(uint16_t), CompareItemIds);
+        fputs("    {", file);
+        QAssertMetaWriteStringLiteral(file, modules[m], "NULL");
+        fprintf(file, ", %zu, %zu, %zu},\n", strlen(modules[m]), firstItem, moduleItemCount);
+        firstItem += moduleItemCount;
+
+        char previous = QASSERT_META_FUZZY_START;
+        for (const char * c = modules[m]; ; ++c)
+        {
+            char current = (*c != '\0') ? *c : QASSERT_META_FUZZY_END;
+            grams[gramCount].gram[0] = previous;
+            grams[gramCount].gram[1] = current;
+            grams[gramCount].module = m;
+            ++gramCount;
+            if (*c == '\0')
+            {
+                break;
+            }
+            previous = current;
+        }
+    }
+    if (moduleCount == 0)
+    {
+        fputs("    {\"\", 0, 0, 0}\n", file);
+    }
+
+    fprintf(file, "};\n\nconst size_t m_qassert_meta_fuzzy_module_count = %zu;\n\n"
+                  "const uint16_t m_qassert_meta_fuzzy_module_items[] = {\n   ", moduleCount);
+    for (size_t i = 0; i < itemCount; ++i)
+    {
+        fprintf(file, " %u,", (unsigned)moduleItems[i]);
+    }
+    fputs((itemCount == 0) ? " 0\n};\n\n" : "\n};\n\n", file);
+
+    qsort(grams, gramCount, sizeof(GramOccurrence), CompareGramOccurrences);
+
+    //distinct (gram, module) pairs, a module may contain a gram twice
+    size_t unique = 0;
+    for (size_t i = 0; i < gramCount; ++i)
+    {
+        if ((unique == 0) || (0 != CompareGramOccurrences(&grams[unique - 1], &grams[i])))
+        {
+            grams[unique++] = grams[i];
+        }
+    }
+
+    fputs("const uint16_t m_qassert_meta_fuzzy_gram_modules[] = {\n   ", file);
+    for (size_t i = 0; i < unique; ++i)
+    {
+        fprintf(file, " %zu,", grams[i].module);
+    }
+    fputs((unique == 0) ? " 0\n};\n\n" : "\n};\n\n", file);
+
+    fputs("const QAssertMetaFuzzyGram m_qassert_meta_fuzzy_grams[] = {\n", file);
+    size_t distinctGrams = 0;
+    for (size_t i = 0; i < unique; )
+    {
+        size_t next = i;
+        while ((next < unique) && (0 == memcmp(grams[next].gram, grams[i].gram, 2)))
+        {
+            ++next;
+        }
+        fputs("    {{", file);
+        WriteGramChar(file, grams[i].gram[0]);
+        fputs(", ", file);
+        WriteGramChar(file, grams[i].gram[1]);
+        fprintf(file, "}, %zu, %zu},\n", i, next - i);
+        ++distinctGrams;
+        i = next;
+    }
+    if (distinctGrams == 0)
+    {
+        fputs("    {{0, 0}, 0, 0}\n", file);
+    }
+    fprintf(file, "};\n\nconst size_t m_qassert_meta_fuzzy_gram_count = %zu;\n", distinctGrams);
+
+    free(modules);
+    free(moduleItems);
+    free(grams);
+    return CloseOutput(file);
+}
+
+// ---------------------------------------------------------------------
+// qassert-meta-builtin-index.c
+
+static bool GenerateBuiltinIndex(const char * directory)
+{
+    size_t itemCount = CountItems();
+    uint32_t slotCount = 2;
+    while (slotCount < (itemCount * 2u))
+    {
+        slotCount *= 2u;
+    }
+
+    QAssertMetaIndexSlot * slots = calloc(slotCount, sizeof(QAssertMetaIndexSlot));
+    FILE * file = (NULL != slots) ? OpenOutput(directory, "qassert-meta-builtin-index.c") : NULL;
+    if (NULL == file)
+    {
+        free(slots);
+        return false;
+    }
+
+    //same layout as the indexes of registered tables, first duplicate wins
+    uint32_t mask = slotCount - 1u;
+    for (size_t i = 0; i < itemCount; ++i)
+    {
+        const QAssertMetaItem * item = &m_qassert_meta_items[i];
+        uint32_t hash = QAssertMetaPrivateHash(item->module, strlen(item->module), item->id);
+        uint32_t slot = hash & mask;
+        bool duplicate = false;
+        while ((!duplicate) && (slots[slot].item != 0))
+        {
+            const QAssertMetaItem * existing = &m_qassert_meta_items[slots[slot].item - 1u];
+            duplicate = (slots[slot].hash == hash) && (existing->id == item->id) &&
+                        (0 == strcmp(existing->module, item->module));
+            slot = (slot + 1u) & mask;
+        }
+
+        if (!duplicate)
+        {
+            slots[slot].hash = hash;
+            slots[slot].item = (uint32_t)(i + 1u);
+        }
+    }
+
+    fputs("#include \"qassert-meta-private.h\"\n\n"
+          "const QAssertMetaIndexSlot m_qassert_meta_builtin_index[] = {\n", file);
+    for (uint32_t slot = 0; slot < slotCount; ++slot)
+    {
+        if (slots[slot].item != 0)
+        {
+            const QAssertMetaItem * item = &m_qassert_meta_items[slots[slot].item - 1u];
+            fprintf(file, "    {0x%08xu, %u}, //%s:%d\n", (unsigned)slots[slot].hash, (unsigned)slots[slot].item,
+                    item->module, item->id);
+        }
+        else
+        {
+            fputs("    {0, 0},\n", file);
+        }
+    }
+    fprintf(file, "};\n\nconst uint32_t m_qassert_meta_builtin_index_mask = 0x%xu;\n", (unsigned)mask);
+
+    free(slots);
+    return CloseOutput(file);
+}
+
+// ---------------------------------------------------------------------
+// qassert-meta-constexpr-items.hpp
+
+static bool GenerateConstexprItems(const char * directory)
+{
+    FILE * file = OpenOutput(directory, "qassert-meta-constexpr-items.hpp");
+    if (NULL == file)
+    {
+        return false;
+    }
+
+    //same order as m_qassert_meta_items, qassert-meta.hpp sorts at compile time
+    fputs("#ifndef QASSERT_META_QASSERT_META_CONSTEXPR_ITEMS_HPP\n"
+          "#define QASSERT_META_QASSERT_META_CONSTEXPR_ITEMS_HPP\n\n"
+          "#include \"qassert-meta.h\"\n\n"
+          "namespace qassert_meta {\n"
+          "namespace detail {\n\n"
+          "//a class template's static member, so all translation units share one definition\n"
+          "template <typename Unused = void>\n"
+          "struct BuiltinTable {\n"
+          "    static constexpr QAssertMetaItem items[] = {\n", file);
+    for (size_t i = 0; i < CountItems(); ++i)
+    {
+        const QAssertMetaItem * item = &m_qassert_meta_items[i];
+        fputs("        {", file);
+        QAssertMetaWriteStringLiteral(file, item->module, "nullptr");
+        fprintf(file, ", %d, {\n            ", item->id);
+        QAssertMetaWriteStringLiteral(file, item->description.brief, "nullptr");
+        fputs(",\n            ", file);
+        QAssertMetaWriteStringLiteral(file, item->description.tips, "nullptr");
+        fputs(",\n            ", file);
+        QAssertMetaWriteStringLiteral(file, item->description.url, "nullptr");
+        fputs("}},\n", file);
+    }
+    fputs("    };\n"
+          "};\n\n"
+          "template <typename Unused>\n"
+          "constexpr QAssertMetaItem BuiltinTable<Unused>::items[];\n\n"
+          "} // namespace detail\n"
+          "} // namespace qassert_meta\n\n"
+          "#endif //QASSERT_META_QASSERT_META_CONSTEXPR_ITEMS_HPP\n", file);
+    return CloseOutput(file);
+}
+
+// ---------------------------------------------------------------------
+// qassert-meta-json-items.c
+
+typedef struct {
+    char * text;
+    size_t length;
+    size_t capacity;
+} Text;
+
+static bool Append(Text * text, const char * data, size_t length)
+{
+    if ((text->length + length + 1) > text->capacity)
+    {
+        size_t capacity = (text->capacity == 0) ? 1024 : text->capacity;
+        while ((text->length + length + 1) > capacity)
+        {
+            capacity *= 2;
+        }
+        char * grown = realloc(text->text, capacity);
+        if (NULL == grown)
+        {
+            return false;
+        }
+        text->text = grown;
+        text->capacity = capacity;
+    }
+    memcpy(&text->text[text->length], data, length);
+    text->length += length;
+    text->text[text->length] = '\0';
+    return true;
+}
+
+static bool AppendJsonField(Text * text, const char * key, const char * value)
+{
+    if (NULL == value)
+    {
+        return true;
+    }
+
+    bool ok = Append(text, key, strlen(key)) && Append(text, "\"", 1);
+    for (const char * c = value; ok && (*c != '\0'); ++c)
+    {
+        char escape[6];
+        size_t length = QAssertMetaPrivateJsonEscape((uint8_t)*c, escape);
+        ok = (length != 0) ? Append(text, escape, length) : Append(text, c, 1);
+    }
+    return ok && Append(text, "\"", 1);
+}
+
+static bool GenerateJsonItems(const char * directory)
+{
+    FILE * file = OpenOutput(directory, "qassert-meta-json-items.c");
+    if (NULL == file)
+    {
+        return false;
+    }
+
+    //the same text as QAssertMetaSerializeEntry writes, as checked by the tests
+    fputs("#include \"qassert-meta-serialize-private.h\"\n#include <stddef.h>\n\n"
+          "const QAssertMetaJsonText m_qassert_meta_json_items[] = {\n", file);
+    Text text = {NULL, 0, 0};
+    bool ok = true;
+    for (size_t i = 0; ok && (i < CountItems()); ++i)
+    {
+        const QAssertMetaItem * item = &m_qassert_meta_items[i];
+        char id[32];
+        snprintf(id, sizeof(id), ",\"id\":%d", item->id);
+        text.length = 0;
+        ok = Append(&text, "{", 1) &&
+             AppendJsonField(&text, "\"module\":", item->module) &&
+             Append(&text, id, strlen(id)) &&
+             AppendJsonField(&text, ",\"brief\":", item->description.brief) &&
+             AppendJsonField(&text, ",\"tips\":", item->description.tips) &&
+             AppendJsonField(&text, ",\"url\":", item->description.url) &&
+             Append(&text, "}", 1);
+        if (ok)
+        {
+            fprintf(file, "    {%zu, ", text.length);
+            QAssertMetaWriteStringLiteral(file, text.text, "NULL");
+            fputs("},\n", file);
+        }
+    }
+    fputs("    {0, NULL}\n};\n", file);
+    free(text.text);
+    return CloseOutput(file) && ok;
+}
+
+// ---------------------------------------------------------------------
+// qassert-meta-locations.c
+
+/**
+ * @return: the index of text in pool (appending it if new), or -1 if full.
+ */
+static long PoolIndex(const char ** pool, size_t * count, const char * text)
+{
+    for (size_t i = 0; i < *count; ++i)
+    {
+        if (0 == strcmp(pool[i], text))
+        {
+            return (long)i;
+        }
+    }
+    if (*count >= UINT16_MAX)
+    {
+        return -1;
+    }
+    pool[*count] = text;
+    return (long)(*count)++;
+}
+
+static void WritePool(FILE * file, const char * name, const char ** pool, size_t count)
+{
+    fprintf(file, "const char * const %s[] = {\n", name);
+    for (size_t i = 0; i < count; ++i)
+    {
+        fputs("    ", file);
+        QAssertMetaWriteStringLiteral(file, pool[i], "NULL");
+        fputs(",\n", file);
+    }
+    fputs((count == 0) ? "    NULL\n};\n\n" : "};\n\n", file);
+}
+
+static bool GenerateLocations(const char * directory)
+{
+    size_t itemCount = CountItems();
+    size_t locationCount = 0;
+    while (m_qassert_meta_location_items[locationCount].module != NULL)
+    {
+        ++locationCount;
+    }
+
+    QAssertMetaLocationRecord * records = calloc(itemCount + 1, sizeof(QAssertMetaLocationRecord));
+    const char ** files = calloc(locationCount + 1, sizeof(const char *));
+    const char ** functions = calloc(locationCount + 1, sizeof(const char *));
+    FILE * file = ((NULL != records) && (NULL != files) && (NULL != functions)) ?
+                  OpenOutput(directory, "qassert-meta-locations.c") : NULL;
+    if (NULL == file)
+    {
+        free(records);
+        free(files);
+        free(functions);
+        return false;
+    }
+
+    //first location of a pair wins, as with the items themselves
+    bool ok = true;
+    size_t fileCount = 0;
+    size_t functionCount = 0;
+    size_t located = 0;
+    for (size_t l = 0; ok && (l < locationCount); ++l)
+    {
+        const QAssertMetaLocationItem * location = &m_qassert_meta_location_items[l];
+        size_t i = 0;
+        while ((i < itemCount) && ((m_qassert_meta_items[i].id != location->id) ||
+                                   (0 != strcmp(m_qassert_meta_items[i].module, location->module))))
+        {
+            ++i;
+        }
+        if ((i == itemCount) || (records[i].file != 0) || (NULL == location->location.file))
+        {
+            continue; //not described by the table, or already located
+        }
+
+        long fileIndex = PoolIndex(files, &fileCount, location->location.file);
+        long functionIndex = (NULL != location->location.function) ?
+                             PoolIndex(functions, &functionCount, location->location.function) : -1;
+        ok = (fileIndex >= 0) && ((NULL == location->location.function) || (functionIndex >= 0));
+        records[i].file = (uint16_t)(fileIndex + 1);
+        records[i].function = (uint16_t)(functionIndex + 1);
+        records[i].line = location->location.line;
+        ++located;
+    }
+
+    if (located < locationCount)
+    {
+        fprintf(stderr, "qassert-meta-gen: %zu of %zu locations ignored (duplicate or not in the table)\n",
+                locationCount - located, locationCount);
+    }
+
+    fputs("#include \"qassert-meta-private.h\"\n\n", file);
+    WritePool(file, "m_qassert_meta_location_files", files, fileCount);
+    WritePool(file, "m_qassert_meta_location_functions", functions, functionCount);
+    if (located == 0)
+    {
+        fputs("const QAssertMetaLocationRecord * const m_qassert_meta_locations = NULL;\n", file);
+    }
+    else
+    {
+        fputs("static const QAssertMetaLocationRecord LOCATIONS[] = {\n", file);
+        for (size_t i = 0; i < itemCount; ++i)
+        {
+            fprintf(file, "    {%u, %u, %u}, //%s:%d\n", (unsigned)records[i].file, (unsigned)records[i].function,
+                    (unsigned)records[i].line, m_qassert_meta_items[i].module, m_qassert_meta_items[i].id);
+        }
+        fputs("};\n\nconst QAssertMetaLocationRecord * const m_qassert_meta_locations = LOCATIONS;\n", file);
+    }
+
+    free(records);
+    free(files);
+    free(functions);
+    return CloseOutput(file) && ok;
+}
+
+// ---------------------------------------------------------------------
+// qassert-meta-overrides.c
+
+/**
+ * A character of the module name as a C identifier, see QASSERT_META_MODULE_OVERRIDE.
+ */
+static char IdentifierChar(const char * module, const char * c)
+{
+    bool valid = ((*c >= 'a') && (*c <= 'z')) || ((*c >= 'A') && (*c <= 'Z')) ||
+                 ((*c >= '0') && (*c <= '9') && (c != module));
+    return valid ? *c : '_';
+}
+
+static void WriteIdentifier(FILE * file, const char * module)
+{
+    for (const char * c = module; *c != '\0'; ++c)
+    {
+        fputc(IdentifierChar(module, c), file);
+    }
+}
+
+static bool SameIdentifier(const char * lhs, const char * rhs)
+{
+    size_t i = 0;
+    for (; (lhs[i] != '\0') && (rhs[i] != '\0'); ++i)
+    {
+        if (IdentifierChar(lhs, &lhs[i]) != IdentifierChar(rhs, &rhs[i]))
+        {
+            return false;
+        }
+    }
+    return (lhs[i] == '\0') && (rhs[i] == '\0');
+}
+
+/**
+ * Modules such as "qf-act" and "qf_act" would define the same override
+ * table, failing the build in the generated source.
+ */
+static bool CheckIdentifiers(const char ** modules, size_t moduleCount)
+{
+    bool ok = true;
+    for (size_t m = 0; m < moduleCount; ++m)
+    {
+        for (size_t other = m + 1; other < moduleCount; ++other)
+        {
+            if (SameIdentifier(modules[m], modules[other]))
+            {
+                fprintf(stderr, "qassert-meta-gen: modules \"%s\" and \"%s\" have the same override identifier "
+                                "qassert_meta_override_", modules[m], modules[other]);
+                WriteIdentifier(stderr, modules[m]);
+                fputs(", rename one of them\n", stderr);
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
+
+static bool GenerateOverrides(const char * directory)
+{
+    size_t moduleCount = 0;
+    const char ** modules = CollectModules(&moduleCount);
+    bool unique = (NULL != modules) && CheckIdentifiers(modules, moduleCount);
+    FILE * file = unique ? OpenOutput(directory, "qassert-meta-overrides.c") : NULL;
+    if (NULL == file)
+    {
+        free(modules);
+        return false;
+    }
+
+    fputs("#include \"qassert-meta-private.h\"\n"
+          "#include \"qassert-meta-overrides.h\"\n"
+          "#include <stddef.h>\n\n"
+          "//empty defaults, replaced at link time by QASSERT_META_MODULE_OVERRIDE definitions\n", file);
+    for (size_t m = 0; m < moduleCount; ++m)
+    {
+        fputs("QASSERT_META_WEAK const QAssertMetaItem qassert_meta_override_", file);
+        WriteIdentifier(file, modules[m]);
+        fputs("[] = {{NULL, -1, {NULL, NULL, NULL}}};\n", file);
+    }
+
+    fputs("\nconst QAssertMetaItem * const m_qassert_meta_module_overrides[] = {\n", file);
+    for (size_t m = 0; m < moduleCount; ++m)
+    {
+        fputs("    qassert_meta_override_", file);
+        WriteIdentifier(file, modules[m]);
+        fputs(",\n", file);
+    }
+    fputs("    NULL\n};\n\nconst uint16_t m_qassert_meta_item_modules[] = {\n", file);
+    for (size_t i = 0; m_qassert_meta_items[i].module != NULL; ++i)
+    {
+        const char ** module = bsearch(&m_qassert_meta_items[i].module, modules, moduleCount,
+                                       sizeof(const char *), CompareModuleNames);
+        fprintf(file, "    %u, //%s:%d\n", (unsigned)(module - modules), m_qassert_meta_items[i].module,
+                m_qassert_meta_items[i].id);
+    }
+    fputs("    0\n};\n", file);
+
+    free(modules);
+    return CloseOutput(file);
+}
+
+int main(int argc, char ** argv)
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s <output directory>\n", argv[0]);
+        return 2;
+    }
+
+    if (CountItems() > UINT16_MAX)
+    {
+        fprintf(stderr, "qassert-meta-gen: too many items (%zu)\n", CountItems());
+        return 1;
+    }
+
+    bool ok = GenerateHeader(argv[1]) &&
+              GenerateSearchIndex(argv[1]) &&
+              GenerateFuzzyIndex(argv[1]) &&
+              GenerateBuiltinIndex(argv[1]) &&
+              GenerateConstexprItems(argv[1]) &&
+              GenerateJsonItems(argv[1]) &&
+              GenerateLocations(argv[1]) &&
+              GenerateOverrides(argv[1]);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,197 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_HOST_FILES_H
+#define QASSERT_META_QASSERT_META_HOST_FILES_H
+
+/**
+ * File and thread pool helpers shared by the host tools.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace qassert_meta {
+
+/**
+ * A read only memory mapping of a whole file, empty files are not mapped.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    ~MappedFile()
+    {
+        if (nullptr != m_data)
+        {
+            munmap(m_data, m_size);
+        }
+    }
+
+    bool Open(const std::string & path)
+    {
+        int fd = open(path.c_str(), O_RDONLY);
+        struct stat info;
+        if ((fd < 0) || (0 != fstat(fd, &info)))
+        {
+            m_error = strerror(errno);
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+            return false;
+        }
+
+        m_size = static_cast<size_t>(info.st_size);
+        if (m_size > 0)
+        {
+            void * mapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (MAP_FAILED == mapping)
+            {
+                m_error = strerror(errno);
+                close(fd);
+                return false;
+            }
+            m_data = mapping;
+            (void)madvise(m_data, m_size, MADV_SEQUENTIAL);
+        }
+        close(fd);
+        return true;
+    }
+
+    const char * Data() const { return static_cast<const char *>(m_data); }
+    size_t Size() const { return m_size; }
+    const std::string & Error() const { return m_error; }
+
+private:
+    void * m_data = nullptr;
+    size_t m_size = 0;
+    std::string m_error;
+};
+
+/**
+ * The number of workers ParallelWorkers uses for count items.
+ */
+inline size_t ParallelWorkerCount(size_t count, unsigned threads)
+{
+    return std::max<size_t>(1, std::min<size_t>(threads, count));
+}
+
+/**
+ * Run body(worker, 0) .. body(worker, count - 1) on a pool of
+ * ParallelWorkerCount(count, threads) threads, the calling thread being
+ * worker 0. Each worker takes the next index from a shared counter.
+ */
+template <typename Body>
+void ParallelWorkers(size_t count, unsigned threads, const Body & body)
+{
+    std::atomic<size_t> next(0);
+    auto worker = [count, &body, &next](size_t workerIndex) {
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1))
+        {
+            body(workerIndex, i);
+        }
+    };
+
+    size_t workers = ParallelWorkerCount(count, threads);
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < workers; ++i)
+    {
+        pool.emplace_back(worker, i);
+    }
+    worker(0);
+    for (std::thread & thread : pool)
+    {
+        thread.join();
+    }
+}
+
+/**
+ * Run body(0) .. body(count - 1) on a pool of threads, see ParallelWorkers.
+ */
+template <typename Body>
+void ParallelFor(size_t count, unsigned threads, const Body & body)
+{
+    ParallelWorkers(count, threads, [&body](size_t, size_t i) { body(i); });
+}
+
+/**
+ * Append the regular files below directory for which accept(name) is true,
+ * unsorted, skipping hidden files and directories and not following
+ * symbolic links.
+ * @return: false if directory could not be read.
+ */
+template <typename Filter>
+bool ListDirectory(const std::string & directory, std::vector<std::string> & files, const Filter & accept)
+{
+    DIR * dir = opendir(directory.c_str());
+    if (nullptr == dir)
+    {
+        return false;
+    }
+
+    struct dirent * entry;
+    while (nullptr != (entry = readdir(dir)))
+    {
+        if (entry->d_name[0] == '.') //also skips hidden directories
+        {
+            continue;
+        }
+
+        std::string path = directory + "/" + entry->d_name;
+        bool isDirectory = (entry->d_type == DT_DIR);
+        bool isFile = (entry->d_type == DT_REG);
+        struct stat info;
+        if ((entry->d_type == DT_UNKNOWN) && (0 == lstat(path.c_str(), &info)))
+        {
+            isDirectory = S_ISDIR(info.st_mode);
+            isFile = S_ISREG(info.st_mode);
+        }
+
+        if (isDirectory)
+        {
+            (void)ListDirectory(path, files, accept);
+        }
+        else if (isFile && accept(entry->d_name))
+        {
+            files.push_back(path);
+        }
+    }
+    closedir(dir);
+    return true;
+}
+
+} // namespace qassert_meta
+
+#endif //QASSERT_META_QASSERT_META_HOST_FILES_H
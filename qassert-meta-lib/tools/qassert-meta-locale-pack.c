@@ -0,0 +1,209 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * Writes a localization pack of the internal QASSERT meta table from a
+ * tab separated translation file, or a template of that file.
+ *
+ * usage: qassert-meta-locale-pack <locale> <translations.tsv> <output pack>
+ *        qassert-meta-locale-pack --template <output.tsv>
+ *
+ * Each line of the translation file is: module, id, brief and tips, separated
+ * by tabs, with \t, \n and \\ escapes. An empty field is not translated, and
+ * falls back to English. Lines starting with '#' are comments. The template
+ * lists every entry of the internal table with its English text.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "qassert-meta-locale.h"
+#include "qassert-meta-private.h"
+#include <stdlib.h>
+#include <string.h>
+
+static void WriteField(FILE * file, const char * text)
+{
+    for (const char * c = (NULL != text) ? text : ""; *c != '\0'; ++c)
+    {
+        if (*c == '\t')
+        {
+            fputs("\\t", file);
+        }
+        else if (*c == '\n')
+        {
+            fputs("\\n", file);
+        }
+        else if (*c == '\\')
+        {
+            fputs("\\\\", file);
+        }
+        else
+        {
+            fputc(*c, file);
+        }
+    }
+}
+
+static int WriteTemplate(const char * path)
+{
+    FILE * file = fopen(path, "w");
+    if (NULL == file)
+    {
+        fprintf(stderr, "unable to write %s\n", path);
+        return 1;
+    }
+
+    fputs("# module\tid\tbrief\ttips\n", file);
+    for (size_t i = 0; m_qassert_meta_items[i].module != NULL; ++i)
+    {
+        const QAssertMetaItem * item = &m_qassert_meta_items[i];
+        fprintf(file, "%s\t%d\t", item->module, item->id);
+        WriteField(file, item->description.brief);
+        fputc('\t', file);
+        WriteField(file, item->description.tips);
+        fputc('\n', file);
+    }
+    bool ok = (0 == ferror(file));
+    return ((0 == fclose(file)) && ok) ? 0 : 1;
+}
+
+/**
+ * Split a line in place into tab separated, unescaped fields.
+ * @return: the number of fields.
+ */
+static size_t SplitFields(char * line, char ** fields, size_t maxFields)
+{
+    size_t count = 0;
+    char * out = line;
+    fields[count++] = out;
+    for (char * c = line; (*c != '\0') && (*c != '\n') && (*c != '\r'); ++c)
+    {
+        if ((*c == '\t') && (count < maxFields))
+        {
+            *out++ = '\0';
+            fields[count++] = out;
+        }
+        else if ((*c == '\\') && (c[1] != '\0'))
+        {
+            ++c;
+            *out++ = (*c == 't') ? '\t' : ((*c == 'n') ? '\n' : *c);
+        }
+        else
+        {
+            *out++ = *c;
+        }
+    }
+    *out = '\0';
+    return count;
+}
+
+static char * CopyField(const char * field)
+{
+    return (field[0] != '\0') ? strdup(field) : NULL;
+}
+
+int main(int argc, char ** argv)
+{
+    if ((argc == 3) && (0 == strcmp(argv[1], "--template")))
+    {
+        return WriteTemplate(argv[2]);
+    }
+    if (argc != 4)
+    {
+        fprintf(stderr, "usage: %s <locale> <translations.tsv> <output pack>\n"
+                        "       %s --template <output.tsv>\n", argv[0], argv[0]);
+        return 2;
+    }
+
+    FILE * input = fopen(argv[2], "r");
+    if (NULL == input)
+    {
+        fprintf(stderr, "unable to read %s\n", argv[2]);
+        return 1;
+    }
+
+    QAssertMetaTranslation * translations = NULL;
+    size_t count = 0;
+    size_t capacity = 0;
+    size_t lineNumber = 0;
+    char * line = NULL;
+    size_t lineCapacity = 0;
+    int result = 0;
+    while ((0 == result) && (getline(&line, &lineCapacity, input) >= 0))
+    {
+        ++lineNumber;
+        char * fields[4];
+        if ((line[0] == '#') || (line[0] == '\n') || (line[0] == '\0'))
+        {
+            continue;
+        }
+        if (SplitFields(line, fields, 4) != 4)
+        {
+            fprintf(stderr, "%s:%zu: expected module, id, brief and tips\n", argv[2], lineNumber);
+            result = 1;
+            break;
+        }
+
+        if (count == capacity)
+        {
+            capacity = (capacity == 0) ? 256 : (capacity * 2);
+            QAssertMetaTranslation * grown = realloc(translations, capacity * sizeof(QAssertMetaTranslation));
+            if (NULL == grown)
+            {
+                result = 1;
+                break;
+            }
+            translations = grown;
+        }
+        translations[count].module = strdup(fields[0]);
+        translations[count].id = (int)strtol(fields[1], NULL, 0);
+        translations[count].brief = CopyField(fields[2]);
+        translations[count].tips = CopyField(fields[3]);
+        ++count;
+    }
+    free(line);
+    fclose(input);
+
+    size_t unmatched = 0;
+    FILE * output = (0 == result) ? fopen(argv[3], "wb") : NULL;
+    if (0 == result)
+    {
+        bool written = (NULL != output) && QAssertMetaLocaleWritePack(output, argv[1], translations, count, &unmatched);
+        if ((NULL == output) || (0 != fclose(output)) || !written)
+        {
+            fprintf(stderr, "failed to write %s\n", argv[3]);
+            result = 1;
+        }
+        else if (unmatched > 0)
+        {
+            fprintf(stderr, "%zu translations of entries not in the table ignored\n", unmatched);
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        free((char *)translations[i].module);
+        free((char *)translations[i].brief);
+        free((char *)translations[i].tips);
+    }
+    free(translations);
+    return result;
+}
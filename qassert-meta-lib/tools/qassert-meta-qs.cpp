@@ -0,0 +1,422 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "qassert-meta-qs.h"
+#include <cstring>
+
+namespace qassert_meta {
+
+namespace {
+
+uint64_t ReadLittleEndian(const uint8_t * data, unsigned size)
+{
+    uint64_t value = 0;
+    for (unsigned i = 0; i < size; ++i)
+    {
+        value |= static_cast<uint64_t>(data[i]) << (8u * i);
+    }
+    return value;
+}
+
+void WriteLittleEndian(std::vector<uint8_t> & out, uint64_t value, unsigned size)
+{
+    for (unsigned i = 0; i < size; ++i)
+    {
+        out.push_back(static_cast<uint8_t>(value >> (8u * i)));
+    }
+}
+
+bool ValidSize(unsigned size)
+{
+    return (size == 1) || (size == 2) || (size == 4) || (size == 8);
+}
+
+/**
+ * @return: the length of the terminated string at data, or size if unterminated.
+ */
+size_t StringLength(const uint8_t * data, size_t size)
+{
+    const void * end = memchr(data, '\0', size);
+    return (nullptr == end) ? size : static_cast<size_t>(static_cast<const uint8_t *>(end) - data);
+}
+
+} // namespace
+
+QsDecoder::QsDecoder(QsListener & listener, const QsLimits & limits) :
+    m_listener(listener),
+    m_limits(limits),
+    m_frame(limits.maxFrameSize)
+{
+    m_names.reserve(limits.maxDictionaryBytes);
+}
+
+void QsDecoder::SetFormat(const QsFormat & format)
+{
+    m_format = format;
+    m_formatFixed = true;
+}
+
+void QsDecoder::Feed(const uint8_t * data, size_t size)
+{
+    m_stats.bytes += size;
+    uint8_t * frame = m_frame.data();
+    const size_t maxFrameSize = m_frame.size();
+    for (size_t i = 0; i < size; ++i)
+    {
+        uint8_t byte = data[i];
+        if (byte == QS_FRAME_FLAG)
+        {
+            EndFrame();
+            continue;
+        }
+        if (byte == QS_FRAME_ESCAPE)
+        {
+            m_escape = true;
+            continue;
+        }
+        if (m_escape)
+        {
+            byte ^= QS_FRAME_ESCAPE_XOR;
+            m_escape = false;
+        }
+
+        if (m_frameSize < maxFrameSize)
+        {
+            frame[m_frameSize++] = byte;
+            m_checksum = static_cast<uint8_t>(m_checksum + byte);
+        }
+        else
+        {
+            m_overflow = true;
+        }
+    }
+}
+
+void QsDecoder::EndFrame()
+{
+    //the checksum byte complements the sum of the other bytes
+    if (m_overflow)
+    {
+        ++m_stats.oversizedFrames;
+    }
+    else if ((m_frameSize > 0) && (m_frameSize < 3))
+    {
+        ++m_stats.malformedRecords;
+    }
+    else if ((m_frameSize > 0) && (m_checksum != 0xFF))
+    {
+        ++m_stats.checksumErrors;
+    }
+    else if (m_frameSize > 0)
+    {
+        Dispatch(m_frame.data(), m_frameSize);
+    }
+
+    m_frameSize = 0;
+    m_checksum = 0;
+    m_escape = false;
+    m_overflow = false;
+}
+
+void QsDecoder::Dispatch(const uint8_t * frame, size_t size)
+{
+    QsFrame decoded = {frame[0], frame[1], frame + 2, size - 3};
+    ++m_stats.frames;
+    if (m_lastSequence >= 0)
+    {
+        m_stats.lostRecords += static_cast<uint8_t>(decoded.sequence - m_lastSequence - 1);
+    }
+    m_lastSequence = decoded.sequence;
+
+    m_listener.OnFrame(decoded);
+    switch (static_cast<QsRecordType>(decoded.record))
+    {
+        case QsRecordType::TargetInfo:
+            DecodeTargetInfo(decoded.payload, decoded.size);
+            break;
+        case QsRecordType::AssertFail:
+            DecodeAssert(decoded.sequence, decoded.payload, decoded.size);
+            break;
+        case QsRecordType::SigDict:
+        case QsRecordType::ObjDict:
+        case QsRecordType::FunDict:
+        case QsRecordType::UsrDict:
+            if (!DecodeDictionary(static_cast<QsRecordType>(decoded.record), decoded.payload, decoded.size))
+            {
+                ++m_stats.malformedRecords;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void QsDecoder::DecodeTargetInfo(const uint8_t * payload, size_t size)
+{
+    //isReset, QP version (2), signal|event size, queue|time event counters,
+    //pool size|counter, object|function pointer sizes, time size, ...
+    if (size < 8)
+    {
+        ++m_stats.malformedRecords;
+        return;
+    }
+
+    if (payload[0] != 0)
+    {
+        ClearDictionaries();
+        m_lastSequence = -1;
+    }
+    if (!m_formatFixed)
+    {
+        QsFormat format;
+        format.signalSize = payload[3] & 0x0Fu;
+        format.objectPointerSize = payload[6] & 0x0Fu;
+        format.functionPointerSize = payload[6] >> 4u;
+        format.timeSize = payload[7];
+        if (ValidSize(format.signalSize) && ValidSize(format.objectPointerSize) &&
+            ValidSize(format.functionPointerSize) && ValidSize(format.timeSize))
+        {
+            m_format = format;
+        }
+        else
+        {
+            ++m_stats.malformedRecords;
+        }
+    }
+}
+
+void QsDecoder::DecodeAssert(uint8_t sequence, const uint8_t * payload, size_t size)
+{
+    //time, location (u16), module string
+    const size_t fixed = m_format.timeSize + 2u;
+    size_t moduleLength = (size > fixed) ? StringLength(payload + fixed, size - fixed) : 0;
+    if ((size <= fixed) || (moduleLength == (size - fixed)))
+    {
+        ++m_stats.malformedRecords;
+        return;
+    }
+
+    QsAssertRecord record;
+    record.sequence = sequence;
+    record.time = ReadLittleEndian(payload, m_format.timeSize);
+    record.id = static_cast<unsigned>(ReadLittleEndian(payload + m_format.timeSize, 2));
+    record.module = reinterpret_cast<const char *>(payload + fixed);
+    record.moduleLength = moduleLength;
+    record.described = QAssertMetaGetDescriptionN(record.module, moduleLength, static_cast<int>(record.id),
+                                                  &record.description);
+    if (!record.described)
+    {
+        record.description = {nullptr, nullptr, nullptr};
+    }
+
+    ++m_stats.asserts;
+    m_stats.describedAsserts += record.described ? 1u : 0u;
+    m_listener.OnAssert(record);
+}
+
+bool QsDecoder::DecodeDictionary(QsRecordType type, const uint8_t * payload, size_t size)
+{
+    unsigned keySize = 1;
+    unsigned objectSize = 0;
+    switch (type)
+    {
+        case QsRecordType::ObjDict:
+            keySize = m_format.objectPointerSize;
+            break;
+        case QsRecordType::FunDict:
+            keySize = m_format.functionPointerSize;
+            break;
+        case QsRecordType::SigDict:
+            keySize = m_format.signalSize;
+            objectSize = m_format.objectPointerSize;
+            break;
+        default:
+            break;
+    }
+
+    const size_t fixed = keySize + objectSize;
+    size_t length = (size > fixed) ? StringLength(payload + fixed, size - fixed) : 0;
+    if ((size <= fixed) || (length == (size - fixed)))
+    {
+        return false;
+    }
+
+    uint64_t key = ReadLittleEndian(payload, keySize);
+    const char * name = reinterpret_cast<const char *>(payload + fixed);
+    bool stored;
+    switch (type)
+    {
+        case QsRecordType::ObjDict:
+            stored = AddName(m_objects, key, name, length);
+            break;
+        case QsRecordType::FunDict:
+            stored = AddName(m_functions, key, name, length);
+            break;
+        case QsRecordType::SigDict:
+            stored = AddSignalName(key, ReadLittleEndian(payload + keySize, objectSize), name, length);
+            break;
+        default:
+            stored = AddName(m_userRecords, key, name, length);
+            break;
+    }
+
+    if (stored)
+    {
+        ++m_stats.dictionaryEntries;
+    }
+    else
+    {
+        ++m_stats.dictionaryDrops;
+    }
+    return true;
+}
+
+bool QsDecoder::StoreName(const char * name, size_t length, uint32_t * offset)
+{
+    if ((m_names.size() + length + 1u) > m_limits.maxDictionaryBytes)
+    {
+        return false;
+    }
+    *offset = static_cast<uint32_t>(m_names.size());
+    m_names.insert(m_names.end(), name, name + length);
+    m_names.push_back('\0');
+    return true;
+}
+
+bool QsDecoder::AddName(std::unordered_map<uint64_t, uint32_t> & dictionary, uint64_t key, const char * name,
+                        size_t length)
+{
+    auto existing = dictionary.find(key);
+    if ((existing == dictionary.end()) && (dictionary.size() >= m_limits.maxDictionaryEntries))
+    {
+        return false;
+    }
+
+    uint32_t offset;
+    if ((existing != dictionary.end()) && (0 == strcmp(&m_names[existing->second], name)))
+    {
+        return true; //repeated, as targets do on each QS_TARGET_INFO request
+    }
+    if (!StoreName(name, length, &offset))
+    {
+        return false;
+    }
+    dictionary[key] = offset;
+    return true;
+}
+
+bool QsDecoder::AddSignalName(uint64_t signal, uint64_t object, const char * name, size_t length)
+{
+    auto key = std::make_pair(signal, object);
+    auto existing = m_signals.find(key);
+    if ((existing == m_signals.end()) && (m_signals.size() >= m_limits.maxDictionaryEntries))
+    {
+        return false;
+    }
+
+    uint32_t offset;
+    if ((existing != m_signals.end()) && (0 == strcmp(&m_names[existing->second], name)))
+    {
+        return true;
+    }
+    if (!StoreName(name, length, &offset))
+    {
+        return false;
+    }
+    m_signals[key] = offset;
+    return true;
+}
+
+void QsDecoder::ClearDictionaries()
+{
+    m_names.clear();
+    m_objects.clear();
+    m_functions.clear();
+    m_signals.clear();
+    m_userRecords.clear();
+}
+
+const char * QsDecoder::ObjectName(uint64_t object) const
+{
+    auto found = m_objects.find(object);
+    return (found != m_objects.end()) ? &m_names[found->second] : nullptr;
+}
+
+const char * QsDecoder::FunctionName(uint64_t function) const
+{
+    auto found = m_functions.find(function);
+    return (found != m_functions.end()) ? &m_names[found->second] : nullptr;
+}
+
+const char * QsDecoder::SignalName(uint64_t signal, uint64_t object) const
+{
+    //QP registers global signals with a NULL object
+    auto found = m_signals.find(std::make_pair(signal, object));
+    if (found == m_signals.end())
+    {
+        found = m_signals.find(std::make_pair(signal, uint64_t(0)));
+    }
+    return (found != m_signals.end()) ? &m_names[found->second] : nullptr;
+}
+
+const char * QsDecoder::UserRecordName(uint8_t record) const
+{
+    auto found = m_userRecords.find(record);
+    return (found != m_userRecords.end()) ? &m_names[found->second] : nullptr;
+}
+
+void QsEncodeFrame(std::vector<uint8_t> & out, uint8_t sequence, uint8_t record, const uint8_t * payload,
+                   size_t size)
+{
+    uint8_t checksum = 0;
+    auto put = [&out, &checksum](uint8_t byte) {
+        checksum = static_cast<uint8_t>(checksum + byte);
+        if ((byte == QS_FRAME_FLAG) || (byte == QS_FRAME_ESCAPE))
+        {
+            out.push_back(QS_FRAME_ESCAPE);
+            out.push_back(static_cast<uint8_t>(byte ^ QS_FRAME_ESCAPE_XOR));
+        }
+        else
+        {
+            out.push_back(byte);
+        }
+    };
+
+    put(sequence);
+    put(record);
+    for (size_t i = 0; i < size; ++i)
+    {
+        put(payload[i]);
+    }
+    put(static_cast<uint8_t>(~checksum));
+    out.push_back(QS_FRAME_FLAG);
+}
+
+void QsEncodeAssertPayload(std::vector<uint8_t> & payload, const QsFormat & format, uint64_t time, unsigned id,
+                           const char * module)
+{
+    WriteLittleEndian(payload, time, format.timeSize);
+    WriteLittleEndian(payload, id, 2);
+    payload.insert(payload.end(), module, module + strlen(module) + 1u);
+}
+
+} // namespace qassert_meta
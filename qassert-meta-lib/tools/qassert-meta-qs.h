@@ -0,0 +1,197 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_QS_H
+#define QASSERT_META_QASSERT_META_QS_H
+
+#include "qassert-meta.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace qassert_meta {
+
+/**
+ * QS software tracing records known to the decoder, as numbered by QP/C and
+ * QP/C++ 6.6 and later. Other records are passed on undecoded.
+ */
+enum class QsRecordType : uint8_t {
+    SigDict = 60,
+    ObjDict = 61,
+    FunDict = 62,
+    UsrDict = 63,
+    TargetInfo = 64,
+    AssertFail = 69
+};
+
+//QS framing: frames end with a flag, flag and escape bytes within are escaped
+constexpr uint8_t QS_FRAME_FLAG = 0x7E;
+constexpr uint8_t QS_FRAME_ESCAPE = 0x7D;
+constexpr uint8_t QS_FRAME_ESCAPE_XOR = 0x20;
+
+/**
+ * Sizes of the target's QS data, sent by the target in its QS_TARGET_INFO
+ * record. Until that is seen, the QP defaults below are assumed.
+ */
+struct QsFormat {
+    unsigned timeSize = 4;
+    unsigned objectPointerSize = 4;
+    unsigned functionPointerSize = 4;
+    unsigned signalSize = 2;
+};
+
+/**
+ * Memory bounds of a decoder, which allocates nothing beyond them.
+ */
+struct QsLimits {
+    size_t maxFrameSize = 1024;                 //larger frames are dropped
+    size_t maxDictionaryEntries = 16384;        //per dictionary
+    size_t maxDictionaryBytes = 256u * 1024u;   //of names, all dictionaries
+};
+
+/**
+ * A frame with a valid checksum. payload is valid during the callback only.
+ */
+struct QsFrame {
+    uint8_t sequence;
+    uint8_t record;
+    const uint8_t * payload;
+    size_t size;
+};
+
+/**
+ * A QS_ASSERT_FAIL record, annotated with the description of the assert.
+ * module is a slice of the frame, valid during the callback only.
+ */
+struct QsAssertRecord {
+    uint8_t sequence;
+    uint64_t time;
+    unsigned id;
+    const char * module;
+    size_t moduleLength;
+    bool described;                     //false: description is all NULL
+    QAssertMetaDescription description;
+};
+
+struct QsDecoderStats {
+    uint64_t bytes = 0;
+    uint64_t frames = 0;            //with a valid checksum
+    uint64_t checksumErrors = 0;
+    uint64_t oversizedFrames = 0;   //longer than QsLimits::maxFrameSize
+    uint64_t malformedRecords = 0;  //too short, or a missing string terminator
+    uint64_t lostRecords = 0;       //by gaps in the sequence numbers
+    uint64_t asserts = 0;
+    uint64_t describedAsserts = 0;
+    uint64_t dictionaryEntries = 0;
+    uint64_t dictionaryDrops = 0;   //not stored, over the QsLimits
+};
+
+/**
+ * Receives the decoded records.
+ */
+class QsListener {
+public:
+    virtual ~QsListener() = default;
+
+    //every frame with a valid checksum, including those decoded below
+    virtual void OnFrame(const QsFrame & frame) { (void)frame; }
+
+    virtual void OnAssert(const QsAssertRecord & record) { (void)record; }
+};
+
+/**
+ * Streaming decoder of QS trace data, from a file, pipe or serial port.
+ * Bytes may be fed in chunks of any size, frames spanning chunks are
+ * reassembled. Dictionaries (QS_OBJ_DICT, QS_FUN_DICT, QS_SIG_DICT and
+ * QS_USR_DICT) are kept for name lookups, and are cleared, along with the
+ * format, by a QS_TARGET_INFO record of a target reset.
+ * Memory use is bounded by the QsLimits.
+ */
+class QsDecoder {
+public:
+    explicit QsDecoder(QsListener & listener, const QsLimits & limits = QsLimits());
+
+    void Feed(const uint8_t * data, size_t size);
+
+    /**
+     * Set the format, instead of learning it from QS_TARGET_INFO records.
+     */
+    void SetFormat(const QsFormat & format);
+    const QsFormat & Format() const { return m_format; }
+
+    const QsDecoderStats & Stats() const { return m_stats; }
+
+    //dictionary names, nullptr if not defined
+    const char * ObjectName(uint64_t object) const;
+    const char * FunctionName(uint64_t function) const;
+    const char * SignalName(uint64_t signal, uint64_t object) const;
+    const char * UserRecordName(uint8_t record) const;
+
+private:
+    void EndFrame();
+    void Dispatch(const uint8_t * frame, size_t size);
+    void DecodeTargetInfo(const uint8_t * payload, size_t size);
+    void DecodeAssert(uint8_t sequence, const uint8_t * payload, size_t size);
+    bool DecodeDictionary(QsRecordType type, const uint8_t * payload, size_t size);
+    bool AddName(std::unordered_map<uint64_t, uint32_t> & dictionary, uint64_t key, const char * name, size_t length);
+    bool AddSignalName(uint64_t signal, uint64_t object, const char * name, size_t length);
+    bool StoreName(const char * name, size_t length, uint32_t * offset);
+    void ClearDictionaries();
+
+    QsListener & m_listener;
+    QsLimits m_limits;
+    QsFormat m_format;
+    bool m_formatFixed = false;
+    QsDecoderStats m_stats;
+
+    std::vector<uint8_t> m_frame;     //of maxFrameSize, allocated once
+    size_t m_frameSize = 0;
+    uint8_t m_checksum = 0;
+    bool m_escape = false;
+    bool m_overflow = false;
+    int m_lastSequence = -1;
+
+    std::vector<char> m_names;        //up to maxDictionaryBytes, allocated once
+    std::unordered_map<uint64_t, uint32_t> m_objects;  //to m_names offsets
+    std::unordered_map<uint64_t, uint32_t> m_functions;
+    std::map<std::pair<uint64_t, uint64_t>, uint32_t> m_signals;
+    std::unordered_map<uint64_t, uint32_t> m_userRecords;
+};
+
+/**
+ * Append a QS frame, as a target would send it, to out.
+ */
+void QsEncodeFrame(std::vector<uint8_t> & out, uint8_t sequence, uint8_t record, const uint8_t * payload,
+                   size_t size);
+
+/**
+ * Append the payload of a QS_ASSERT_FAIL record in the given format.
+ */
+void QsEncodeAssertPayload(std::vector<uint8_t> & payload, const QsFormat & format, uint64_t time, unsigned id,
+                           const char * module);
+
+} // namespace qassert_meta
+
+#endif //QASSERT_META_QASSERT_META_QS_H
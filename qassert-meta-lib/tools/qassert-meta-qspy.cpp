@@ -0,0 +1,274 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * Decodes a QS trace stream, from a file or stdin, printing each
+ * QS_ASSERT_FAIL record annotated with the description of the assert.
+ *
+ * usage: qassert-meta-qspy [--all] [--tips] [--stats] [--storm N [--storm-window S]]
+ *                          [--time-size N] [--obj-size N] [--fun-size N] [--sig-size N]
+ *                          [<trace file>]
+ *
+ *  --all:    also list the other records, by sequence, record number and size.
+ *  --tips:   include the tips of each described assert.
+ *  --stats:  report the decoder statistics to stderr at the end.
+ *  --storm:  collapse storms, a module/id asserting N or more times within
+ *            the window (default 10 s of arrival time), into summary lines.
+ *  --*-size: the target's QS sizes, instead of learning them from QS_TARGET_INFO.
+ *
+ * For example, from a target's serial port: qassert-meta-qspy < /dev/ttyACM0
+ */
+
+#include "qassert-meta-qs.h"
+#include "qassert-meta-storm.h"
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <poll.h>
+#include <unistd.h>
+
+using namespace qassert_meta;
+
+namespace {
+
+uint64_t NowNs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+class StormPrinter : public StormListener {
+public:
+    void OnStormStart(const StormSummary & storm) override
+    {
+        printf("=STORM= Mod=%.*s,Loc=%d %u asserts in the window, collapsing repeats\n",
+               static_cast<int>(storm.moduleLength), storm.module, storm.id, storm.windowCount);
+    }
+
+    void OnStormEnd(const StormSummary & storm) override
+    {
+        printf("=STORM= Mod=%.*s,Loc=%d ended, %" PRIu64 " repeats collapsed over %.1f s\n",
+               static_cast<int>(storm.moduleLength), storm.module, storm.id, storm.collapsed,
+               static_cast<double>(storm.last - storm.start) / 1e9);
+    }
+};
+
+class AnnotatingListener : public QsListener {
+public:
+    AnnotatingListener(bool all, bool tips, StormDetector * storms) : m_all(all), m_tips(tips), m_storms(storms) {}
+
+    void OnFrame(const QsFrame & frame) override
+    {
+        if (m_all && (frame.record != static_cast<uint8_t>(QsRecordType::AssertFail)))
+        {
+            printf("%03u Rec=%u,Len=%zu\n", frame.sequence, frame.record, frame.size);
+        }
+    }
+
+    void OnAssert(const QsAssertRecord & record) override
+    {
+        if ((nullptr != m_storms) &&
+            !m_storms->Observe(record.module, record.moduleLength, static_cast<int>(record.id), NowNs()))
+        {
+            return;
+        }
+        printf("%010" PRIu64 " =ASSERT= Mod=%.*s,Loc=%u\n", record.time, static_cast<int>(record.moduleLength),
+               record.module, record.id);
+        if (!record.described)
+        {
+            printf("           (not described)\n");
+            return;
+        }
+        printf("           %s\n", record.description.brief);
+        if (m_tips && (nullptr != record.description.tips))
+        {
+            printf("           tips: %s\n", record.description.tips);
+        }
+        if (nullptr != record.description.url)
+        {
+            printf("           %s\n", record.description.url);
+        }
+    }
+
+private:
+    bool m_all;
+    bool m_tips;
+    StormDetector * m_storms;
+};
+
+int Usage(const char * program)
+{
+    fprintf(stderr, "usage: %s [--all] [--tips] [--stats] [--storm N [--storm-window S]] [--time-size N] "
+                    "[--obj-size N] [--fun-size N] [--sig-size N] [<trace file>]\n", program);
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    bool all = false;
+    bool tips = false;
+    bool stats = false;
+    bool fixedFormat = false;
+    bool storm = false;
+    StormConfig stormConfig;
+    QsFormat format;
+    const char * path = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char * value = ((i + 1) < argc) ? argv[i + 1] : nullptr;
+        unsigned * size = nullptr;
+        if (0 == strcmp(argv[i], "--time-size"))
+        {
+            size = &format.timeSize;
+        }
+        else if (0 == strcmp(argv[i], "--obj-size"))
+        {
+            size = &format.objectPointerSize;
+        }
+        else if (0 == strcmp(argv[i], "--fun-size"))
+        {
+            size = &format.functionPointerSize;
+        }
+        else if (0 == strcmp(argv[i], "--sig-size"))
+        {
+            size = &format.signalSize;
+        }
+
+        if ((nullptr != size) && value)
+        {
+            *size = static_cast<unsigned>(strtoul(value, nullptr, 10));
+            fixedFormat = true;
+            ++i;
+        }
+        else if ((0 == strcmp(argv[i], "--storm")) && value)
+        {
+            storm = true;
+            stormConfig.threshold = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+            ++i;
+        }
+        else if ((0 == strcmp(argv[i], "--storm-window")) && value)
+        {
+            stormConfig.window = static_cast<uint64_t>(strtod(value, nullptr) * 1e9);
+            ++i;
+        }
+        else if (0 == strcmp(argv[i], "--all"))
+        {
+            all = true;
+        }
+        else if (0 == strcmp(argv[i], "--tips"))
+        {
+            tips = true;
+        }
+        else if (0 == strcmp(argv[i], "--stats"))
+        {
+            stats = true;
+        }
+        else if ((argv[i][0] != '-') && (nullptr == path))
+        {
+            path = argv[i];
+        }
+        else
+        {
+            return Usage(argv[0]);
+        }
+    }
+
+    FILE * input = (nullptr == path) ? stdin : fopen(path, "rb");
+    if (nullptr == input)
+    {
+        fprintf(stderr, "unable to open %s\n", path);
+        return 1;
+    }
+
+    StormPrinter stormPrinter;
+    StormDetector storms(stormPrinter, stormConfig);
+    AnnotatingListener listener(all, tips, storm ? &storms : nullptr);
+    QsDecoder decoder(listener);
+    if (fixedFormat)
+    {
+        decoder.SetFormat(format);
+    }
+
+    //read returns whatever a live target has sent, rather than waiting for a full buffer
+    static uint8_t buffer[64u * 1024u];
+    int fd = fileno(input);
+    for (;;)
+    {
+        struct pollfd ready = {fd, POLLIN, 0};
+        if (storm && (0 == poll(&ready, 1, 1000)))
+        {
+            storms.Poll(NowNs()); //storms end during quiet periods too
+            fflush(stdout);
+            continue;
+        }
+
+        ssize_t size = read(fd, buffer, sizeof(buffer));
+        if ((size < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+        if (size <= 0)
+        {
+            break;
+        }
+        decoder.Feed(buffer, static_cast<size_t>(size));
+        if (storm)
+        {
+            storms.Poll(NowNs());
+        }
+        if (nullptr == path)
+        {
+            fflush(stdout); //keep up with a live target
+        }
+    }
+    if (input != stdin)
+    {
+        fclose(input);
+    }
+    if (storm)
+    {
+        storms.Finish(NowNs());
+    }
+
+    if (stats)
+    {
+        const QsDecoderStats & s = decoder.Stats();
+        fprintf(stderr, "bytes %" PRIu64 ", frames %" PRIu64 ", checksum errors %" PRIu64 ", oversized %" PRIu64
+                        ", malformed %" PRIu64 ", lost %" PRIu64 "\n", s.bytes, s.frames, s.checksumErrors,
+                s.oversizedFrames, s.malformedRecords, s.lostRecords);
+        fprintf(stderr, "asserts %" PRIu64 " (%" PRIu64 " described), dictionary entries %" PRIu64
+                        " (%" PRIu64 " dropped)\n", s.asserts, s.describedAsserts, s.dictionaryEntries,
+                s.dictionaryDrops);
+        if (storm)
+        {
+            fprintf(stderr, "storms %" PRIu64 ", %" PRIu64 " asserts collapsed, %" PRIu64 " untracked\n",
+                    storms.Stats().storms, storms.Stats().collapsed, storms.Stats().untracked);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,238 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "qassert-meta-storm.h"
+#include <algorithm>
+#include <cstring>
+
+namespace qassert_meta {
+
+namespace {
+
+//FNV-1a, 64 bit, of the module then the id
+uint64_t StormHash(const char * module, size_t moduleLength, int id)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < moduleLength; ++i)
+    {
+        hash ^= static_cast<uint8_t>(module[i]);
+        hash *= 1099511628211ull;
+    }
+    uint32_t uid = static_cast<uint32_t>(id);
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        hash ^= (uid >> (8u * i)) & 0xFFu;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+} // namespace
+
+constexpr size_t StormDetector::BUCKETS;
+constexpr size_t StormDetector::MODULE_SIZE;
+
+StormDetector::StormDetector(StormListener & listener, const StormConfig & config) :
+    m_listener(listener),
+    m_config(config)
+{
+    m_config.threshold = std::max<uint32_t>(1, m_config.threshold);
+    m_bucketWidth = std::max<uint64_t>(1, m_config.window / BUCKETS);
+
+    size_t slots = 2;
+    while (slots < (m_config.capacity * 2u)) //at most half full, for short probes
+    {
+        slots <<= 1u;
+    }
+    m_config.capacity = slots / 2u;
+    m_mask = slots - 1u;
+    m_slots.assign(slots, Slot());
+    m_spare.assign(slots, Slot());
+}
+
+StormDetector::Slot * StormDetector::Find(uint64_t hash, const char * module, size_t moduleLength, int id)
+{
+    size_t stored = std::min(moduleLength, MODULE_SIZE - 1u);
+    for (size_t i = static_cast<size_t>(hash) & m_mask; m_slots[i].used; i = (i + 1u) & m_mask)
+    {
+        Slot & slot = m_slots[i];
+        if ((slot.hash == hash) && (slot.id == id) && (slot.moduleLength == stored) &&
+            (0 == memcmp(slot.module, module, stored)))
+        {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+StormDetector::Slot * StormDetector::Insert(uint64_t hash, const char * module, size_t moduleLength, int id)
+{
+    size_t i = static_cast<size_t>(hash) & m_mask;
+    while (m_slots[i].used)
+    {
+        i = (i + 1u) & m_mask;
+    }
+
+    Slot & slot = m_slots[i];
+    slot = Slot();
+    slot.used = true;
+    slot.hash = hash;
+    slot.id = id;
+    slot.moduleLength = static_cast<uint8_t>(std::min(moduleLength, MODULE_SIZE - 1u));
+    memcpy(slot.module, module, slot.moduleLength);
+    ++m_used;
+    return &slot;
+}
+
+uint32_t StormDetector::Advance(Slot & slot, uint64_t now) const
+{
+    uint64_t epoch = now / m_bucketWidth;
+    if (epoch > slot.epoch)
+    {
+        uint64_t expired = std::min<uint64_t>(epoch - slot.epoch, BUCKETS);
+        for (uint64_t i = 1; i <= expired; ++i)
+        {
+            slot.buckets[(slot.epoch + i) % BUCKETS] = 0;
+        }
+        slot.epoch = epoch;
+    }
+
+    uint32_t count = 0;
+    for (uint32_t bucket : slot.buckets)
+    {
+        count += bucket;
+    }
+    return count;
+}
+
+void StormDetector::EndStorm(Slot & slot)
+{
+    StormSummary summary = {slot.module, slot.moduleLength, slot.id, slot.start, slot.last, slot.collapsed,
+                            Advance(slot, slot.last)};
+    slot.storm = false;
+    slot.collapsed = 0;
+    --m_activeStorms;
+    m_listener.OnStormEnd(summary);
+}
+
+bool StormDetector::Observe(const char * module, size_t moduleLength, int id, uint64_t now)
+{
+    ++m_stats.asserts;
+    uint64_t hash = StormHash(module, moduleLength, id);
+    Slot * slot = Find(hash, module, moduleLength, id);
+    if (nullptr == slot)
+    {
+        //nothing expires within a bucket, so compact at most once per bucket
+        if ((m_used >= m_config.capacity) && ((now / m_bucketWidth) != m_compactedEpoch))
+        {
+            Compact(now);
+        }
+        if (m_used >= m_config.capacity)
+        {
+            ++m_stats.untracked;
+            ++m_stats.shown;
+            return true;
+        }
+        slot = Insert(hash, module, moduleLength, id);
+        slot->epoch = now / m_bucketWidth;
+    }
+
+    uint32_t count = Advance(*slot, now);
+    if (slot->storm && ((count * 2u) < m_config.threshold))
+    {
+        EndStorm(*slot);
+    }
+    ++slot->buckets[slot->epoch % BUCKETS];
+    ++count;
+    slot->last = now;
+
+    if (slot->storm)
+    {
+        ++slot->collapsed;
+        ++m_stats.collapsed;
+        return false;
+    }
+
+    ++m_stats.shown;
+    if (count >= m_config.threshold)
+    {
+        slot->storm = true;
+        slot->start = now;
+        ++m_activeStorms;
+        ++m_stats.storms;
+        StormSummary summary = {slot->module, slot->moduleLength, id, now, now, 0, count};
+        m_listener.OnStormStart(summary);
+    }
+    return true;
+}
+
+void StormDetector::Poll(uint64_t now)
+{
+    for (size_t i = 0; (m_activeStorms > 0) && (i < m_slots.size()); ++i)
+    {
+        Slot & slot = m_slots[i];
+        if (slot.used && slot.storm && ((Advance(slot, now) * 2u) < m_config.threshold))
+        {
+            EndStorm(slot);
+        }
+    }
+}
+
+void StormDetector::Finish(uint64_t now)
+{
+    for (size_t i = 0; (m_activeStorms > 0) && (i < m_slots.size()); ++i)
+    {
+        Slot & slot = m_slots[i];
+        if (slot.used && slot.storm)
+        {
+            (void)Advance(slot, now);
+            EndStorm(slot);
+        }
+    }
+}
+
+void StormDetector::Compact(uint64_t now)
+{
+    //rehash the pairs still in a storm or with asserts in their window
+    for (Slot & spare : m_spare)
+    {
+        spare.used = false;
+    }
+    m_used = 0;
+    for (Slot & slot : m_slots)
+    {
+        if (slot.used && (slot.storm || (Advance(slot, now) > 0)))
+        {
+            size_t i = static_cast<size_t>(slot.hash) & m_mask;
+            while (m_spare[i].used)
+            {
+                i = (i + 1u) & m_mask;
+            }
+            m_spare[i] = slot;
+            ++m_used;
+        }
+    }
+    m_slots.swap(m_spare);
+    m_compactedEpoch = now / m_bucketWidth;
+}
+
+} // namespace qassert_meta
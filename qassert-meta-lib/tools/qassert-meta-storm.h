@@ -0,0 +1,140 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_STORM_H
+#define QASSERT_META_QASSERT_META_STORM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace qassert_meta {
+
+struct StormConfig {
+    uint64_t window = 10000000000ull; //in the unit of the times given, by default 10 s of ns
+    uint32_t threshold = 20;          //asserts of one module/id within the window starting a storm
+    size_t capacity = 256;            //module/id pairs tracked, rounded up to a power of two
+};
+
+/**
+ * A storm of one module/id: the assert repeating at threshold or more per window.
+ * module is held by the detector, truncated to StormDetector::MODULE_SIZE - 1
+ * bytes, and valid during the callback only.
+ */
+struct StormSummary {
+    const char * module;
+    size_t moduleLength;
+    int id;
+    uint64_t start;        //time of the assert starting the storm
+    uint64_t last;         //time of the latest assert
+    uint64_t collapsed;    //repeats not shown since the start
+    uint32_t windowCount;  //asserts within the window
+};
+
+struct StormStats {
+    uint64_t asserts = 0;
+    uint64_t shown = 0;
+    uint64_t collapsed = 0;
+    uint64_t storms = 0;
+    uint64_t untracked = 0; //shown, all capacity in use by active or recent pairs
+};
+
+class StormListener {
+public:
+    virtual ~StormListener() = default;
+
+    //the assert reaching the threshold, itself shown, its repeats are collapsed
+    virtual void OnStormStart(const StormSummary & storm) { (void)storm; }
+
+    //the rate fell below half the threshold, or the stream ended
+    virtual void OnStormEnd(const StormSummary & storm) { (void)storm; }
+};
+
+/**
+ * Sliding window assert storm detection, for streams of annotated asserts.
+ * Each module/id pair has a rate counter of BUCKETS buckets spanning the
+ * window. An assert reaching the threshold starts a storm, the repeats
+ * are then counted instead of shown, until the rate falls below half the
+ * threshold. Memory is allocated once, on construction: pairs without
+ * asserts in their window are dropped to make room for new ones.
+ */
+class StormDetector {
+public:
+    static constexpr size_t BUCKETS = 8;
+    static constexpr size_t MODULE_SIZE = 32;
+
+    explicit StormDetector(StormListener & listener, const StormConfig & config = StormConfig());
+
+    /**
+     * Count an assert at time now (non decreasing).
+     * @return: true if the assert should be shown, false if collapsed into a storm.
+     */
+    bool Observe(const char * module, size_t moduleLength, int id, uint64_t now);
+
+    /**
+     * End the storms that calmed down by time now, for quiet periods of the stream.
+     */
+    void Poll(uint64_t now);
+
+    /**
+     * End all storms, at the end of the stream.
+     */
+    void Finish(uint64_t now);
+
+    const StormStats & Stats() const { return m_stats; }
+
+private:
+    struct Slot {
+        uint64_t hash;
+        int id;
+        bool used;
+        bool storm;
+        uint8_t moduleLength; //stored, at most MODULE_SIZE - 1
+        char module[MODULE_SIZE];
+        uint32_t buckets[BUCKETS];
+        uint64_t epoch;       //bucket index of the latest assert
+        uint64_t start;
+        uint64_t last;
+        uint64_t collapsed;
+    };
+
+    Slot * Find(uint64_t hash, const char * module, size_t moduleLength, int id);
+    Slot * Insert(uint64_t hash, const char * module, size_t moduleLength, int id);
+    uint32_t Advance(Slot & slot, uint64_t now) const;
+    void EndStorm(Slot & slot);
+    void Compact(uint64_t now);
+
+    StormListener & m_listener;
+    StormConfig m_config;
+    uint64_t m_bucketWidth;
+    size_t m_mask;
+    size_t m_used = 0;
+    size_t m_activeStorms = 0;
+    uint64_t m_compactedEpoch = UINT64_MAX;
+    StormStats m_stats;
+    std::vector<Slot> m_slots;
+    std::vector<Slot> m_spare; //for compaction
+};
+
+} // namespace qassert_meta
+
+#endif //QASSERT_META_QASSERT_META_STORM_H
@@ -0,0 +1,70 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_STRING_LITERAL_H
+#define QASSERT_META_QASSERT_META_STRING_LITERAL_H
+
+/**
+ * String literal escaping shared by the generator (C) and the host tools
+ * writing tables as source (C++).
+ */
+
+#include <stdio.h>
+
+/**
+ * Write text as a string literal, escaped so any text (quotes, backslashes,
+ * control and non ASCII bytes) stays valid C and C++.
+ * @param nullText: written instead if text is NULL, such as "NULL" or "nullptr".
+ */
+static inline void QAssertMetaWriteStringLiteral(FILE * file, const char * text, const char * nullText)
+{
+    if (NULL == text)
+    {
+        fputs(nullText, file);
+        return;
+    }
+
+    fputc('"', file);
+    for (const char * p = text; *p != '\0'; ++p)
+    {
+        if ((*p == '"') || (*p == '\\') || (*p == '?')) //'?': no trigraphs
+        {
+            fprintf(file, "\\%c", *p);
+        }
+        else if (*p == '\n')
+        {
+            fputs("\\n", file);
+        }
+        else if ((*p >= ' ') && (*p <= '~'))
+        {
+            fputc(*p, file);
+        }
+        else
+        {
+            //three digit octal escapes can not absorb the following character
+            fprintf(file, "\\%03o", (unsigned)(unsigned char)*p);
+        }
+    }
+    fputc('"', file);
+}
+
+#endif //QASSERT_META_QASSERT_META_STRING_LITERAL_H
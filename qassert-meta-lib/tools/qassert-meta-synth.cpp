@@ -0,0 +1,104 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * Writes a synthetic QASSERT meta table as C source, for building
+ * applications or benchmarks with large registered tables.
+ *
+ * usage: qassert-meta-synth [--items N] [--modules N] [--shared-prefix-modules N]
+ *                           [--ids sequential|qp|random] [--brief-length N]
+ *                           [--tips-length N] [--no-urls] [--seed N] [--name array_name]
+ */
+
+#include "qassert-meta-synthetic.h"
+#include <cstdlib>
+#include <cstring>
+
+using namespace qassert_meta;
+
+int main(int argc, char ** argv)
+{
+    SyntheticTableConfig config;
+    const char * name = "m_synthetic_qassert_meta_items";
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char * value = ((i + 1) < argc) ? argv[i + 1] : nullptr;
+        bool usedValue = true;
+        if ((0 == strcmp(argv[i], "--items")) && value)
+        {
+            config.itemCount = strtoull(value, nullptr, 10);
+        }
+        else if ((0 == strcmp(argv[i], "--modules")) && value)
+        {
+            config.moduleCount = strtoull(value, nullptr, 10);
+        }
+        else if ((0 == strcmp(argv[i], "--shared-prefix-modules")) && value)
+        {
+            config.sharedPrefixModules = strtoull(value, nullptr, 10);
+        }
+        else if ((0 == strcmp(argv[i], "--ids")) && value && (0 == strcmp(value, "sequential")))
+        {
+            config.ids = SyntheticIdDistribution::Sequential;
+        }
+        else if ((0 == strcmp(argv[i], "--ids")) && value && (0 == strcmp(value, "qp")))
+        {
+            config.ids = SyntheticIdDistribution::QpFamilies;
+        }
+        else if ((0 == strcmp(argv[i], "--ids")) && value && (0 == strcmp(value, "random")))
+        {
+            config.ids = SyntheticIdDistribution::Random;
+        }
+        else if ((0 == strcmp(argv[i], "--brief-length")) && value)
+        {
+            config.briefLength = strtoull(value, nullptr, 10);
+        }
+        else if ((0 == strcmp(argv[i], "--tips-length")) && value)
+        {
+            config.tipsLength = strtoull(value, nullptr, 10);
+        }
+        else if ((0 == strcmp(argv[i], "--seed")) && value)
+        {
+            config.seed = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        }
+        else if ((0 == strcmp(argv[i], "--name")) && value)
+        {
+            name = value;
+        }
+        else if (0 == strcmp(argv[i], "--no-urls"))
+        {
+            config.urls = false;
+            usedValue = false;
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--items N] [--modules N] [--shared-prefix-modules N] "
+                            "[--ids sequential|qp|random] [--brief-length N] [--tips-length N] "
+                            "[--no-urls] [--seed N] [--name array_name]\n", argv[0]);
+            return 2;
+        }
+        i += usedValue ? 1 : 0;
+    }
+
+    SyntheticTable table(config);
+    return WriteSyntheticTableSource(stdout, table, name) ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "qassert-meta-synthetic.h"
+#include "qassert-meta-string-literal.h"
+#include <climits>
+#include <random>
+#include <set>
+
+namespace qassert_meta {
+
+namespace {
+
+const char * const SYLLABLES[] = {
+    "qf", "app", "drv", "hal", "net", "ui", "pwr", "mot", "sens", "cfg", "log", "dsp"
+};
+
+const char * const WORDS[] = {
+    "the", "event", "queue", "pool", "active", "object", "timer", "state", "machine",
+    "posted", "overflow", "invalid", "parameter", "failed", "sanity", "check", "memory",
+    "corruption", "driver", "handler", "buffer", "full", "empty", "null", "pointer"
+};
+
+//QP style id offsets within a family of hundreds
+const int FAMILY_OFFSETS[] = {0, 2, 10, 20, 90, 1, 12, 30, 50, 92};
+
+std::string Text(std::mt19937 & random, size_t length)
+{
+    std::string text;
+    while (text.size() < length)
+    {
+        if (!text.empty())
+        {
+            text += ' ';
+        }
+        text += WORDS[random() % (sizeof(WORDS) / sizeof(WORDS[0]))];
+    }
+    text.resize(length);
+    return text;
+}
+
+std::string ModuleName(const SyntheticTableConfig & config, std::mt19937 & random, size_t module)
+{
+    if (module < config.sharedPrefixModules)
+    {
+        return config.sharedPrefix + std::to_string(module);
+    }
+
+    const size_t syllableCount = sizeof(SYLLABLES) / sizeof(SYLLABLES[0]);
+    std::string name = SYLLABLES[random() % syllableCount];
+    name += '_';
+    name += SYLLABLES[random() % syllableCount];
+    name += '_';
+    name += std::to_string(module);
+    return name;
+}
+
+std::vector<int> ModuleIds(const SyntheticTableConfig & config, std::mt19937 & random, size_t count)
+{
+    std::vector<int> ids;
+    const size_t offsets = sizeof(FAMILY_OFFSETS) / sizeof(FAMILY_OFFSETS[0]);
+    std::set<int> used;
+    std::uniform_int_distribution<int> anyId(0, INT_MAX);
+    for (size_t i = 0; i < count; ++i)
+    {
+        switch (config.ids)
+        {
+            case SyntheticIdDistribution::Sequential:
+                ids.push_back(static_cast<int>(i + 1));
+                break;
+            case SyntheticIdDistribution::QpFamilies:
+                ids.push_back(static_cast<int>((1 + (i / offsets)) * 100) + FAMILY_OFFSETS[i % offsets]);
+                break;
+            case SyntheticIdDistribution::Random:
+            default:
+            {
+                int id;
+                do
+                {
+                    id = anyId(random);
+                } while (!used.insert(id).second);
+                ids.push_back(id);
+                break;
+            }
+        }
+    }
+    return ids;
+}
+
+} // namespace
+
+SyntheticTable::SyntheticTable(const SyntheticTableConfig & config)
+{
+    std::mt19937 random(config.seed);
+    const size_t moduleCount = (config.moduleCount == 0) ? 1 : config.moduleCount;
+    m_items.reserve(config.itemCount + 1);
+
+    for (size_t module = 0; module < moduleCount; ++module)
+    {
+        //spread the items evenly, the first modules take any remainder
+        size_t count = (config.itemCount / moduleCount) + ((module < (config.itemCount % moduleCount)) ? 1 : 0);
+        if (count == 0)
+        {
+            break;
+        }
+
+        const char * name = Store(ModuleName(config, random, module));
+        for (int id : ModuleIds(config, random, count))
+        {
+            QAssertMetaItem item;
+            item.module = name;
+            item.id = id;
+            item.description.brief = Store(Text(random, config.briefLength));
+            item.description.tips = Store(Text(random, config.tipsLength));
+            item.description.url = config.urls ?
+                    Store("https://example.com/asserts/" + std::string(name) + "/" + std::to_string(id)) : nullptr;
+            m_items.push_back(item);
+        }
+    }
+    m_items.push_back({nullptr, 0, {nullptr, nullptr, nullptr}});
+}
+
+const char * SyntheticTable::Store(std::string value)
+{
+    m_stringBytes += value.size() + 1;
+    m_strings.push_back(std::move(value));
+    return m_strings.back().c_str();
+}
+
+bool WriteSyntheticTableSource(FILE * file, const SyntheticTable & table, const char * arrayName)
+{
+    fprintf(file, "// Generated by qassert-meta-synth. Do not edit.\n\n"
+                  "#include \"qassert-meta.h\"\n"
+                  "#include <stddef.h>\n\n"
+                  "const QAssertMetaItem %s[] = {\n", arrayName);
+    for (size_t i = 0; i < table.Size(); ++i)
+    {
+        const QAssertMetaItem & item = table[i];
+        fputs("    {", file);
+        QAssertMetaWriteStringLiteral(file, item.module, "NULL");
+        fprintf(file, ", %d, {", item.id);
+        QAssertMetaWriteStringLiteral(file, item.description.brief, "NULL");
+        fputs(", ", file);
+        QAssertMetaWriteStringLiteral(file, item.description.tips, "NULL");
+        fputs(", ", file);
+        QAssertMetaWriteStringLiteral(file, item.description.url, "NULL");
+        fputs("}},\n", file);
+    }
+    fputs("    {NULL, -1, {NULL, NULL, NULL}}\n};\n", file);
+    return 0 == ferror(file);
+}
+
+} // namespace qassert_meta
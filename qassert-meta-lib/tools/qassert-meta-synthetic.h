@@ -0,0 +1,91 @@
+// MIT License
+//
+// Copyright (c) 2024 Matthew Eshleman Consulting (covemountainsoftware.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef QASSERT_META_QASSERT_META_SYNTHETIC_H
+#define QASSERT_META_QASSERT_META_SYNTHETIC_H
+
+#include "qassert-meta.h"
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace qassert_meta {
+
+enum class SyntheticIdDistribution {
+    Sequential, //1, 2, 3, ...
+    QpFamilies, //QP style families of hundreds: 100, 102, 110, 120, 190, ..., 200, 202, ...
+    Random      //uniform over 0..INT_MAX
+};
+
+/**
+ * Shape of a synthetic table, standing in for large generated
+ * application assert tables in scaling tests and benchmarks.
+ */
+struct SyntheticTableConfig {
+    size_t itemCount = 1000;
+    size_t moduleCount = 100;
+    size_t sharedPrefixModules = 0;  //modules whose names share sharedPrefix
+    std::string sharedPrefix = "app_subsystem_component_";
+    SyntheticIdDistribution ids = SyntheticIdDistribution::QpFamilies;
+    size_t briefLength = 64;
+    size_t tipsLength = 256;
+    bool urls = true;
+    uint32_t seed = 1;
+};
+
+/**
+ * A deterministic (per seed) synthetic table of unique module/id pairs,
+ * spread evenly over the modules, terminated by an item with a NULL module.
+ */
+class SyntheticTable {
+public:
+    explicit SyntheticTable(const SyntheticTableConfig & config);
+
+    SyntheticTable(const SyntheticTable &) = delete;
+    SyntheticTable & operator=(const SyntheticTable &) = delete;
+
+    const QAssertMetaItem * Items() const { return m_items.data(); }
+    size_t Size() const { return m_items.size() - 1; }
+    const QAssertMetaItem & operator[](size_t index) const { return m_items[index]; }
+
+    //bytes of string data (including terminators) referenced by the table
+    size_t StringBytes() const { return m_stringBytes; }
+
+private:
+    const char * Store(std::string value);
+
+    std::deque<std::string> m_strings; //deque, so stored strings never move
+    std::vector<QAssertMetaItem> m_items;
+    size_t m_stringBytes = 0;
+};
+
+/**
+ * Write a table as C source, an array of QAssertMetaItem named arrayName.
+ * @return: true if completely written.
+ */
+bool WriteSyntheticTableSource(FILE * file, const SyntheticTable & table, const char * arrayName);
+
+} // namespace qassert_meta
+
+#endif //QASSERT_META_QASSERT_META_SYNTHETIC_H